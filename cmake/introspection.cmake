@@ -148,6 +148,21 @@ check_cxx_source_compiles("
 if(NOT MSVC)
   include(CheckSourceCompilesWithFlags)
 
+  # Check for SSE2 intrinsics.
+  set(SSE2_CXXFLAGS -msse2)
+  check_cxx_source_compiles_with_flags("
+    #include <immintrin.h>
+
+    int main()
+    {
+      __m128i a = _mm_set1_epi32(1);
+      __m128i r = _mm_shufflehi_epi16(_mm_add_epi32(a, a), 0xb1);
+      return _mm_cvtsi128_si32(r);
+    }
+    " HAVE_SSE2
+    CXXFLAGS ${SSE2_CXXFLAGS}
+  )
+
   # Check for SSE4.1 intrinsics.
   set(SSE41_CXXFLAGS -msse4.1)
   check_cxx_source_compiles_with_flags("
@@ -4,6 +4,9 @@
 
 #include <bench/bench.h>
 #include <common/args.h>
+#include <crypto/chacha20.h>
+#include <crypto/hex_base.h>
+#include <crypto/poly1305.h>
 #include <crypto/sha256.h>
 #include <tinyformat.h>
 #include <util/fs.h>
@@ -84,6 +87,9 @@ int main(int argc, char** argv)
     ArgsManager argsman;
     SetupBenchArgs(argsman);
     SHA256AutoDetect();
+    HexAutoDetect();
+    ChaCha20AutoDetect();
+    Poly1305AutoDetect();
     std::string error;
     if (!argsman.ParseParameters(argc, argv, error)) {
         tfm::format(std::cerr, "Error parsing command line arguments: %s\n", error);
@@ -7,6 +7,7 @@
 #include <crypto/chacha20.h>
 #include <crypto/chacha20poly1305.h>
 #include <span.h>
+#include <tinyformat.h>
 
 #include <cstddef>
 #include <cstdint>
@@ -41,6 +42,13 @@ static void FSCHACHA20POLY1305(benchmark::Bench& bench, size_t buffersize)
     });
 }
 
+static void CHACHA20_IMPL(benchmark::Bench& bench, chacha20_implementation::UseImplementation impl, const char* name)
+{
+    bench.name(strprintf("%s using the '%s' ChaCha20 implementation", name, ChaCha20AutoDetect(impl)));
+    CHACHA20(bench, BUFFER_SIZE_LARGE);
+    ChaCha20AutoDetect();
+}
+
 static void CHACHA20_64BYTES(benchmark::Bench& bench)
 {
     CHACHA20(bench, BUFFER_SIZE_TINY);
@@ -56,6 +64,21 @@ static void CHACHA20_1MB(benchmark::Bench& bench)
     CHACHA20(bench, BUFFER_SIZE_LARGE);
 }
 
+static void CHACHA20_1MB_STANDARD(benchmark::Bench& bench)
+{
+    CHACHA20_IMPL(bench, chacha20_implementation::STANDARD, __func__);
+}
+
+static void CHACHA20_1MB_SSE2(benchmark::Bench& bench)
+{
+    CHACHA20_IMPL(bench, chacha20_implementation::USE_SSE2, __func__);
+}
+
+static void CHACHA20_1MB_AVX2(benchmark::Bench& bench)
+{
+    CHACHA20_IMPL(bench, chacha20_implementation::USE_ALL, __func__);
+}
+
 static void FSCHACHA20POLY1305_64BYTES(benchmark::Bench& bench)
 {
     FSCHACHA20POLY1305(bench, BUFFER_SIZE_TINY);
@@ -74,6 +97,9 @@ static void FSCHACHA20POLY1305_1MB(benchmark::Bench& bench)
 BENCHMARK(CHACHA20_64BYTES, benchmark::PriorityLevel::HIGH);
 BENCHMARK(CHACHA20_256BYTES, benchmark::PriorityLevel::HIGH);
 BENCHMARK(CHACHA20_1MB, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CHACHA20_1MB_STANDARD, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CHACHA20_1MB_SSE2, benchmark::PriorityLevel::HIGH);
+BENCHMARK(CHACHA20_1MB_AVX2, benchmark::PriorityLevel::HIGH);
 BENCHMARK(FSCHACHA20POLY1305_64BYTES, benchmark::PriorityLevel::HIGH);
 BENCHMARK(FSCHACHA20POLY1305_256BYTES, benchmark::PriorityLevel::HIGH);
 BENCHMARK(FSCHACHA20POLY1305_1MB, benchmark::PriorityLevel::HIGH);
@@ -3,10 +3,14 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <dbwrapper.h>
+#include <node/blockstorage.h>
 #include <test/util/setup_common.h>
 #include <validation.h>
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 static void CheckBlockIndex(benchmark::Bench& bench)
 {
@@ -18,5 +22,68 @@ static void CheckBlockIndex(benchmark::Bench& bench)
     });
 }
 
+/** Block index entries of a 1100 block chain, sorted by height */
+static std::vector<CBlockIndex*> BlockIndexEntries(TestChain100Setup& setup) EXCLUSIVE_LOCKS_REQUIRED(::cs_main)
+{
+    std::vector<CBlockIndex*> entries{setup.m_node.chainman->m_blockman.GetAllBlockIndices()};
+    std::sort(entries.begin(), entries.end(), node::CBlockIndexHeightOnlyComparator());
+    return entries;
+}
+
+/** Inserts into a standalone block map, like BlockManager::InsertBlockIndex */
+static CBlockIndex* InsertBlockIndex(node::BlockMap& block_index, const uint256& hash)
+{
+    if (hash.IsNull()) return nullptr;
+    const auto [it, inserted]{block_index.try_emplace(hash)};
+    if (inserted) it->second.phashBlock = &it->first;
+    return &it->second;
+}
+
+static void LoadBlockIndexFromDB(benchmark::Bench& bench)
+{
+    auto testing_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    testing_setup->mineBlocks(1000);
+    LOCK(cs_main);
+    kernel::BlockTreeDB db{DBParams{
+        .path = testing_setup->m_args.GetDataDirNet() / "bench_index",
+        .cache_bytes = 8 << 20,
+    }};
+    const std::vector<CBlockIndex*> entries{BlockIndexEntries(*testing_setup)};
+    db.WriteBatchSync({}, 0, {entries.begin(), entries.end()});
+    bench.run([&] {
+        node::BlockMap block_index;
+        db.LoadBlockIndexGuts(
+            testing_setup->m_node.chainman->GetConsensus(),
+            [&](const uint256& hash) { return InsertBlockIndex(block_index, hash); },
+            *Assert(testing_setup->m_node.shutdown_signal));
+        std::vector<CBlockIndex*> sorted;
+        sorted.reserve(block_index.size());
+        for (auto& [_, entry] : block_index) sorted.push_back(&entry);
+        std::sort(sorted.begin(), sorted.end(), node::CBlockIndexHeightOnlyComparator());
+        assert(sorted.size() == entries.size());
+    });
+}
+
+static void LoadBlockIndexFromSnapshot(benchmark::Bench& bench)
+{
+    auto testing_setup{MakeNoLogFileContext<TestChain100Setup>()};
+    testing_setup->mineBlocks(1000);
+    LOCK(cs_main);
+    const fs::path path{testing_setup->m_args.GetDataDirNet() / "bench_blockindex.dat"};
+    const uint256 id{GetRandHash()};
+    const uint256 block_files_hash{GetRandHash()};
+    const std::vector<CBlockIndex*> entries{BlockIndexEntries(*testing_setup)};
+    assert(node::WriteBlockIndexSnapshot(path, id, block_files_hash, entries));
+    bench.run([&] {
+        node::BlockMap block_index;
+        const auto sorted{node::ReadBlockIndexSnapshot(
+            path, id, block_files_hash,
+            [&](size_t count) { block_index.reserve(count); },
+            [&](const uint256& hash) { return InsertBlockIndex(block_index, hash); })};
+        assert(sorted && sorted->size() == entries.size());
+    });
+}
 
 BENCHMARK(CheckBlockIndex, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LoadBlockIndexFromDB, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LoadBlockIndexFromSnapshot, benchmark::PriorityLevel::HIGH);
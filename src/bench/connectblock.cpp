@@ -111,6 +111,13 @@ static void ConnectBlockAllSchnorr(benchmark::Bench& bench)
     BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
 }
 
+static void ConnectBlockAllSchnorrNoBatch(benchmark::Bench& bench)
+{
+    const auto test_setup{MakeNoLogFileContext<TestChain100Setup>(ChainType::REGTEST, {.batch_schnorr_verification = false})};
+    auto [keys, outputs]{CreateKeysAndOutputs(test_setup->coinbaseKey, /*num_schnorr=*/5, /*num_ecdsa=*/0)};
+    BenchmarkConnectBlock(bench, keys, outputs, *test_setup);
+}
+
 static void ConnectBlockMixedEcdsaSchnorr(benchmark::Bench& bench)
 {
     const auto test_setup{MakeNoLogFileContext<TestChain100Setup>()};
@@ -127,5 +134,6 @@ static void ConnectBlockAllEcdsa(benchmark::Bench& bench)
 }
 
 BENCHMARK(ConnectBlockAllSchnorr, benchmark::PriorityLevel::HIGH);
+BENCHMARK(ConnectBlockAllSchnorrNoBatch, benchmark::PriorityLevel::HIGH);
 BENCHMARK(ConnectBlockMixedEcdsaSchnorr, benchmark::PriorityLevel::HIGH);
 BENCHMARK(ConnectBlockAllEcdsa, benchmark::PriorityLevel::HIGH);
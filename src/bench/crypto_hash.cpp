@@ -181,6 +181,30 @@ static void SHA256D64_1024_SHANI(benchmark::Bench& bench)
     SHA256AutoDetect();
 }
 
+static void RunSHA256DMulti(benchmark::Bench& bench, sha256_implementation::UseImplementation use_implementation, const char* name)
+{
+    bench.name(strprintf("%s using the '%s' SHA256 implementation", name, SHA256AutoDetect(use_implementation)));
+    // Messages of typical transaction sizes.
+    FastRandomContext rng(true);
+    std::vector<std::vector<uint8_t>> msgs(1000);
+    size_t total = 0;
+    for (auto& msg : msgs) {
+        msg = rng.randbytes(150 + rng.randrange(400));
+        total += msg.size();
+    }
+    const std::vector<std::span<const unsigned char>> inputs(msgs.begin(), msgs.end());
+    std::vector<uint8_t> out(32 * inputs.size());
+    bench.batch(total).unit("byte").run([&] {
+        SHA256DMulti(out.data(), inputs);
+    });
+    SHA256AutoDetect();
+}
+
+static void SHA256DMulti_STANDARD(benchmark::Bench& bench) { RunSHA256DMulti(bench, sha256_implementation::STANDARD, __func__); }
+static void SHA256DMulti_SSE4(benchmark::Bench& bench) { RunSHA256DMulti(bench, sha256_implementation::USE_SSE4, __func__); }
+static void SHA256DMulti_AVX2(benchmark::Bench& bench) { RunSHA256DMulti(bench, sha256_implementation::USE_SSE4_AND_AVX2, __func__); }
+static void SHA256DMulti_SHANI(benchmark::Bench& bench) { RunSHA256DMulti(bench, sha256_implementation::USE_SSE4_AND_SHANI, __func__); }
+
 static void SHA512(benchmark::Bench& bench)
 {
     uint8_t hash[CSHA512::OUTPUT_SIZE];
@@ -280,6 +304,10 @@ BENCHMARK(SHA256D64_1024_STANDARD, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SSE4, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_AVX2, benchmark::PriorityLevel::HIGH);
 BENCHMARK(SHA256D64_1024_SHANI, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256DMulti_STANDARD, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256DMulti_SSE4, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256DMulti_AVX2, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SHA256DMulti_SHANI, benchmark::PriorityLevel::HIGH);
 
 BENCHMARK(MuHash, benchmark::PriorityLevel::HIGH);
 BENCHMARK(MuHashMul, benchmark::PriorityLevel::HIGH);
@@ -10,7 +10,7 @@
 #include <utility>
 #include <vector>
 
-static GCSFilter::ElementSet GenerateGCSTestElements()
+static GCSFilter::ElementSet GenerateGCSTestElements(int count = 100000)
 {
     GCSFilter::ElementSet elements;
 
@@ -18,7 +18,7 @@ static GCSFilter::ElementSet GenerateGCSTestElements()
     // with at least 100,000 elements results in benchmarks that have the same
     // ns/op. This makes it easy to reason about how long (in nanoseconds) a single
     // filter element takes to process.
-    for (int i = 0; i < 100000; ++i) {
+    for (int i = 0; i < count; ++i) {
         GCSFilter::Element element(32);
         element[0] = static_cast<unsigned char>(i);
         element[1] = static_cast<unsigned char>(i >> 8);
@@ -52,6 +52,19 @@ static void GCSFilterConstruct(benchmark::Bench& bench)
     });
 }
 
+// Filter construction for a set of the size of a typical busy block.
+static void GCSFilterConstructBlock(benchmark::Bench& bench)
+{
+    auto elements = GenerateGCSTestElements(3000);
+
+    uint64_t siphash_k0 = 0;
+    bench.run([&]{
+        GCSFilter filter({siphash_k0, 0, BASIC_FILTER_P, BASIC_FILTER_M}, elements);
+
+        siphash_k0++;
+    });
+}
+
 static void GCSFilterDecode(benchmark::Bench& bench)
 {
     auto elements = GenerateGCSTestElements();
@@ -86,8 +99,30 @@ static void GCSFilterMatch(benchmark::Bench& bench)
         filter.Match(GCSFilter::Element());
     });
 }
+// Matching a wallet's worth of scripts, as done for each block during rescans.
+static void GCSFilterMatchAny(benchmark::Bench& bench)
+{
+    auto elements = GenerateGCSTestElements();
+
+    GCSFilter filter({0, 0, BASIC_FILTER_P, BASIC_FILTER_M}, elements);
+
+    GCSFilter::ElementSet queries;
+    for (int i = 0; i < 1000; ++i) {
+        GCSFilter::Element element(32);
+        element[2] = static_cast<unsigned char>(i);
+        element[3] = static_cast<unsigned char>(i >> 8);
+        queries.insert(std::move(element));
+    }
+
+    bench.run([&] {
+        filter.MatchAny(queries);
+    });
+}
+
 BENCHMARK(GCSBlockFilterGetHash, benchmark::PriorityLevel::HIGH);
 BENCHMARK(GCSFilterConstruct, benchmark::PriorityLevel::HIGH);
+BENCHMARK(GCSFilterConstructBlock, benchmark::PriorityLevel::HIGH);
 BENCHMARK(GCSFilterDecode, benchmark::PriorityLevel::HIGH);
 BENCHMARK(GCSFilterDecodeSkipCheck, benchmark::PriorityLevel::HIGH);
 BENCHMARK(GCSFilterMatch, benchmark::PriorityLevel::HIGH);
+BENCHMARK(GCSFilterMatchAny, benchmark::PriorityLevel::HIGH);
@@ -56,4 +56,38 @@ static void BlockFilterIndexSync(benchmark::Bench& bench)
     });
 }
 
+// Block filter index sync over blocks with many outputs each, so that most
+// of the time is spent building the filters.
+static void BlockFilterIndexSyncLargeBlocks(benchmark::Bench& bench)
+{
+    const auto test_setup = MakeNoLogFileContext<TestChain100Setup>();
+
+    constexpr int NUM_BLOCKS{50};
+    constexpr int NUM_OUTPUTS{500};
+    const CScript coinbase_script{GetScriptForDestination(PKHash(test_setup->coinbaseKey.GetPubKey()))};
+    for (int i = 0; i < NUM_BLOCKS; i++) {
+        std::vector<CTxOut> outputs;
+        for (int j = 0; j < NUM_OUTPUTS; j++) {
+            outputs.emplace_back(1000, CScript() << (i * NUM_OUTPUTS + j) << OP_DROP << OP_TRUE);
+        }
+        const CTransactionRef& coinbase_to_spend{test_setup->m_coinbase_txns[i]};
+        const auto [tx, _]{test_setup->CreateValidTransaction(
+            {coinbase_to_spend}, {COutPoint(coinbase_to_spend->GetHash(), 0)},
+            WITH_LOCK(::cs_main, return test_setup->m_node.chainman->ActiveHeight()) + 1,
+            {test_setup->coinbaseKey}, outputs, {}, {})};
+        test_setup->CreateAndProcessBlock({tx}, coinbase_script);
+        SetMockTime(GetTime() + 1);
+    }
+    assert(WITH_LOCK(::cs_main, return test_setup->m_node.chainman->ActiveHeight() == 100 + NUM_BLOCKS));
+
+    bench.minEpochIterations(5).run([&] {
+        BlockFilterIndex filter_index(interfaces::MakeChain(test_setup->m_node), BlockFilterType::BASIC,
+                                      /*n_cache_size=*/0, /*f_memory=*/false, /*f_wipe=*/true);
+        assert(filter_index.Init());
+        filter_index.Sync();
+        assert(filter_index.GetSummary().synced);
+    });
+}
+
 BENCHMARK(BlockFilterIndexSync, benchmark::PriorityLevel::HIGH);
+BENCHMARK(BlockFilterIndexSyncLargeBlocks, benchmark::PriorityLevel::HIGH);
@@ -0,0 +1,93 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <addresstype.h>
+#include <bench/bench.h>
+#include <common/args.h>
+#include <index/base.h>
+#include <index/txindex.h>
+#include <interfaces/chain.h>
+#include <primitives/block.h>
+#include <primitives/transaction.h>
+#include <random.h>
+#include <script/script.h>
+#include <sync.h>
+#include <test/util/setup_common.h>
+#include <tinyformat.h>
+#include <uint256.h>
+#include <util/fs.h>
+#include <util/time.h>
+#include <validation.h>
+
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// Transaction lookups through the txindex, with blocks full of transactions
+// so that the index is of a realistic size rather than a few hundred coinbase
+// transactions. The on-disk size of the index is recorded as the "index_size"
+// context.
+static void TxIndexLookup(benchmark::Bench& bench, bool compact)
+{
+    const auto test_setup = MakeNoLogFileContext<TestChain100Setup>();
+
+    constexpr int NUM_BLOCKS{100};
+    constexpr int TXS_PER_BLOCK{1000};
+    const CScript script{GetScriptForDestination(PKHash(test_setup->coinbaseKey.GetPubKey()))};
+    const CScript op_true{CScript() << OP_TRUE};
+
+    // Split a mature coinbase into anyone-can-spend outputs, each of which
+    // starts a chain of transactions through the blocks below.
+    const CTransactionRef& coinbase{test_setup->m_coinbase_txns[0]};
+    const CAmount value{coinbase->vout[0].nValue / (TXS_PER_BLOCK + 1)};
+    const CMutableTransaction split{test_setup->CreateValidMempoolTransaction(
+        /*input_transactions=*/{coinbase}, /*inputs=*/{COutPoint{coinbase->GetHash(), 0}}, /*input_height=*/1,
+        /*input_signing_keys=*/{test_setup->coinbaseKey}, /*outputs=*/std::vector<CTxOut>(TXS_PER_BLOCK, CTxOut{value, op_true}),
+        /*submit=*/false)};
+    test_setup->CreateAndProcessBlock({split}, script);
+
+    std::vector<COutPoint> prevouts;
+    for (uint32_t n = 0; n < TXS_PER_BLOCK; ++n) prevouts.emplace_back(split.GetHash(), n);
+    std::vector<uint256> txids;
+    for (int i = 0; i < NUM_BLOCKS; ++i) {
+        std::vector<CMutableTransaction> txs;
+        for (COutPoint& prevout : prevouts) {
+            CMutableTransaction tx;
+            tx.vin.emplace_back(prevout);
+            tx.vout.emplace_back(value, op_true);
+            prevout = COutPoint{tx.GetHash(), 0};
+            txids.push_back(tx.GetHash());
+            txs.push_back(std::move(tx));
+        }
+        const CBlock block{test_setup->CreateAndProcessBlock(txs, script)};
+        assert(WITH_LOCK(::cs_main, return test_setup->m_node.chainman->ActiveChain().Tip()->GetBlockHash()) == block.GetHash());
+        SetMockTime(GetTime() + 1);
+    }
+
+    TxIndex txindex(interfaces::MakeChain(test_setup->m_node), /*n_cache_size=*/0, /*f_memory=*/false, /*f_wipe=*/true, compact);
+    assert(txindex.Init());
+    txindex.Sync();
+    assert(txindex.GetSummary().synced);
+
+    uintmax_t index_size{0};
+    for (const auto& entry : fs::directory_iterator(gArgs.GetDataDirNet() / "indexes" / "txindex")) {
+        if (entry.is_regular_file()) index_size += entry.file_size();
+    }
+    bench.context("index_size", strprintf("%d", index_size));
+
+    FastRandomContext rng{/*fDeterministic=*/true};
+    bench.run([&] {
+        uint256 block_hash;
+        CTransactionRef tx;
+        const bool found{txindex.FindTx(txids[rng.randrange(txids.size())], block_hash, tx)};
+        assert(found);
+    });
+}
+
+static void TxIndexLookupFull(benchmark::Bench& bench) { TxIndexLookup(bench, /*compact=*/false); }
+static void TxIndexLookupCompact(benchmark::Bench& bench) { TxIndexLookup(bench, /*compact=*/true); }
+
+BENCHMARK(TxIndexLookupFull, benchmark::PriorityLevel::HIGH);
+BENCHMARK(TxIndexLookupCompact, benchmark::PriorityLevel::HIGH);
@@ -7,6 +7,7 @@
 #include <test/util/setup_common.h>
 
 #include <functional>
+#include <thread>
 #include <vector>
 
 // All but 2 of the benchmarks should have roughly similar performance:
@@ -14,6 +15,9 @@
 // LogWithoutDebug should be ~3 orders of magnitude faster, as nothing is logged.
 //
 // LogWithoutWriteToFile should be ~2 orders of magnitude faster, as it avoids disk writes.
+//
+// The Async variants only measure queueing the message, as the writes happen
+// on the background writer thread.
 
 static void Logging(benchmark::Bench& bench, const std::vector<const char*>& extra_args, const std::function<void()>& log)
 {
@@ -33,6 +37,32 @@ static void LogWithDebug(benchmark::Bench& bench)
     Logging(bench, {"-logthreadnames=0", "-debug=net"}, [] { LogDebug(BCLog::NET, "%s\n", "test"); });
 }
 
+static void LogWithDebugAsync(benchmark::Bench& bench)
+{
+    Logging(bench, {"-logthreadnames=0", "-debug=net", "-logasync"}, [] { LogDebug(BCLog::NET, "%s\n", "test"); });
+}
+
+// Several threads logging at the same time, as with busy net and validation threads.
+static void LogFromThreads(benchmark::Bench& bench, bool async)
+{
+    constexpr int NUM_THREADS{4};
+    constexpr int MESSAGES_PER_THREAD{100};
+    std::vector<const char*> extra_args{"-logthreadnames=0", "-debug=net"};
+    if (async) extra_args.push_back("-logasync");
+    Logging(bench, extra_args, [] {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([] {
+                for (int i = 0; i < MESSAGES_PER_THREAD; ++i) LogDebug(BCLog::NET, "%s\n", "test");
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+}
+
+static void LogFromThreadsSync(benchmark::Bench& bench) { LogFromThreads(bench, /*async=*/false); }
+static void LogFromThreadsAsync(benchmark::Bench& bench) { LogFromThreads(bench, /*async=*/true); }
+
 static void LogWithoutDebug(benchmark::Bench& bench)
 {
     Logging(bench, {"-logthreadnames=0", "-debug=0"}, [] { LogDebug(BCLog::NET, "%s\n", "test"); });
@@ -58,6 +88,9 @@ static void LogWithoutWriteToFile(benchmark::Bench& bench)
 }
 
 BENCHMARK(LogWithDebug, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LogWithDebugAsync, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LogFromThreadsSync, benchmark::PriorityLevel::HIGH);
+BENCHMARK(LogFromThreadsAsync, benchmark::PriorityLevel::HIGH);
 BENCHMARK(LogWithoutDebug, benchmark::PriorityLevel::HIGH);
 BENCHMARK(LogWithThreadNames, benchmark::PriorityLevel::HIGH);
 BENCHMARK(LogWithoutThreadNames, benchmark::PriorityLevel::HIGH);
@@ -4,6 +4,7 @@
 
 #include <bench/bench.h>
 #include <consensus/merkle.h>
+#include <primitives/transaction.h>
 #include <random.h>
 #include <uint256.h>
 
@@ -24,4 +25,50 @@ static void MerkleRoot(benchmark::Bench& bench)
     });
 }
 
+/** Transactions of roughly the shape of a full block, half of them with witness. */
+static std::vector<CMutableTransaction> RandomBlockTransactions()
+{
+    FastRandomContext rng(true);
+    std::vector<CMutableTransaction> txs(2000);
+    for (size_t i = 0; i < txs.size(); ++i) {
+        auto& tx = txs[i];
+        tx.vin.resize(1 + rng.randrange(3));
+        for (auto& in : tx.vin) {
+            in.prevout = COutPoint(Txid::FromUint256(rng.rand256()), rng.randrange(4));
+            const auto script_sig{rng.randbytes(rng.randrange(110))};
+            in.scriptSig = CScript(script_sig.begin(), script_sig.end());
+            if (i % 2) in.scriptWitness.stack = {rng.randbytes(72), rng.randbytes(33)};
+        }
+        tx.vout.resize(1 + rng.randrange(3));
+        for (auto& out : tx.vout) {
+            out.nValue = rng.randrange(100'000'000);
+            const auto script_pub_key{rng.randbytes(22)};
+            out.scriptPubKey = CScript(script_pub_key.begin(), script_pub_key.end());
+        }
+    }
+    return txs;
+}
+
+static void RunMerkleRootFromTransactions(benchmark::Bench& bench, bool batch)
+{
+    const auto txs = RandomBlockTransactions();
+    bench.batch(txs.size()).unit("tx").run([&] {
+        std::vector<CTransactionRef> refs;
+        if (batch) {
+            refs = MakeTransactionRefs(std::vector<CMutableTransaction>(txs));
+        } else {
+            for (const auto& tx : txs) refs.push_back(MakeTransactionRef(tx));
+        }
+        std::vector<uint256> leaves;
+        leaves.reserve(refs.size());
+        for (const auto& tx : refs) leaves.push_back(tx->GetHash().ToUint256());
+        ankerl::nanobench::doNotOptimizeAway(ComputeMerkleRoot(std::move(leaves)));
+    });
+}
+
+static void MerkleRootFromTransactions(benchmark::Bench& bench) { RunMerkleRootFromTransactions(bench, /*batch=*/true); }
+static void MerkleRootFromTransactionsSingle(benchmark::Bench& bench) { RunMerkleRootFromTransactions(bench, /*batch=*/false); }
+
 BENCHMARK(MerkleRoot, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MerkleRootFromTransactions, benchmark::PriorityLevel::HIGH);
+BENCHMARK(MerkleRootFromTransactionsSingle, benchmark::PriorityLevel::HIGH);
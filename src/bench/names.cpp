@@ -0,0 +1,145 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <consensus/validation.h>
+#include <names/applications.h>
+#include <names/main.h>
+#include <primitives/transaction.h>
+#include <script/names.h>
+#include <script/script.h>
+
+#include <univalue.h>
+
+#include <cassert>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+/**
+ * Builds a minimal JSON object close to MAX_VALUE_LENGTH, with nested
+ * objects, arrays, numbers and escaped strings like typical game moves.
+ */
+std::string
+BuildMoveJson ()
+{
+  std::string res = R"({"g":{"tn":{"c":[)";
+  for (unsigned i = 0; res.size () + 100 < MAX_VALUE_LENGTH; ++i)
+    {
+      if (i > 0)
+        res += ",";
+      res += R"({"id":)" + std::to_string (i)
+               + R"(,"to":{"x":-)" + std::to_string (i * 7)
+               + R"(,"y":)" + std::to_string (i * 13)
+               + R"(},"msg":"café \"quoted\"\n","ok":true})";
+    }
+  res += R"(]}}})";
+  return res;
+}
+
+/**
+ * Builds the outputs of a block, where every twentieth output is a name
+ * update with a large value and all others are P2WPKH.
+ */
+std::vector<CTxOut>
+BuildBlockOutputs ()
+{
+  const CScript addr = CScript () << OP_0 << valtype (20, 0x42);
+  const valtype name(10, 'p');
+  const valtype value(MAX_VALUE_LENGTH, 'x');
+
+  std::vector<CTxOut> outputs;
+  for (unsigned i = 0; i < 4'000; ++i)
+    {
+      CScript script = addr;
+      if (i % 20 == 0)
+        script = CNameScript::buildNameUpdate (addr, name, value);
+      outputs.emplace_back (1, script);
+    }
+  return outputs;
+}
+
+} // anonymous namespace
+
+/* Parsing the value into a UniValue, which is what the consensus check
+   used to do.  */
+static void NameValueRead (benchmark::Bench& bench)
+{
+  const std::string json = BuildMoveJson ();
+  bench.batch (json.size ()).unit ("byte").run ([&] {
+    UniValue val;
+    const bool ok = val.read (json) && val.isObject ();
+    assert (ok);
+  });
+}
+
+static void NameValueValidate (benchmark::Bench& bench)
+{
+  const std::string json = BuildMoveJson ();
+  const valtype value(json.begin (), json.end ());
+  bench.batch (json.size ()).unit ("byte").run ([&] {
+    TxValidationState state;
+    const bool ok = IsValueValid (value, state);
+    assert (ok);
+  });
+}
+
+static void NameValueMinimalWrite (benchmark::Bench& bench)
+{
+  const std::string json = BuildMoveJson ();
+  bench.batch (json.size ()).unit ("byte").run ([&] {
+    const bool ok = (json == GetMinimalJSON (json));
+    assert (ok);
+  });
+}
+
+static void NameValueMinimalValidate (benchmark::Bench& bench)
+{
+  const std::string json = BuildMoveJson ();
+  bench.batch (json.size ()).unit ("byte").run ([&] {
+    const bool ok = IsMinimalJSONOrEmptyString (json);
+    assert (ok);
+  });
+}
+
+/* Finding the name operations in a block by parsing each output with
+   CNameScript, which copies the scripts.  */
+static void NameScriptScanOwned (benchmark::Bench& bench)
+{
+  const auto outputs = BuildBlockOutputs ();
+  bench.batch (outputs.size ()).unit ("output").run ([&] {
+    size_t valueBytes = 0;
+    for (const auto& out : outputs)
+      {
+        const CNameScript op(out.scriptPubKey);
+        if (op.isNameOp ())
+          valueBytes += op.getOpValue ().size ();
+      }
+    assert (valueBytes == outputs.size () / 20 * MAX_VALUE_LENGTH);
+  });
+}
+
+static void NameScriptScanView (benchmark::Bench& bench)
+{
+  const auto outputs = BuildBlockOutputs ();
+  bench.batch (outputs.size ()).unit ("output").run ([&] {
+    size_t valueBytes = 0;
+    for (const auto& out : outputs)
+      {
+        const NameScriptView op(out.scriptPubKey);
+        if (op.isNameOp ())
+          valueBytes += op.getOpValue ().size ();
+      }
+    assert (valueBytes == outputs.size () / 20 * MAX_VALUE_LENGTH);
+  });
+}
+
+BENCHMARK (NameValueRead, benchmark::PriorityLevel::HIGH);
+BENCHMARK (NameValueValidate, benchmark::PriorityLevel::HIGH);
+BENCHMARK (NameValueMinimalWrite, benchmark::PriorityLevel::HIGH);
+BENCHMARK (NameValueMinimalValidate, benchmark::PriorityLevel::HIGH);
+BENCHMARK (NameScriptScanOwned, benchmark::PriorityLevel::HIGH);
+BENCHMARK (NameScriptScanView, benchmark::PriorityLevel::HIGH);
@@ -3,7 +3,9 @@
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
 #include <bench/bench.h>
+#include <crypto/hex_base.h>
 #include <random.h>
+#include <tinyformat.h>
 #include <util/strencodings.h>
 
 #include <cassert>
@@ -23,15 +25,42 @@ std::string generateHexString(size_t length) {
     return data;
 }
 
-static void HexParse(benchmark::Bench& bench)
+static void RunHexParse(benchmark::Bench& bench, const char* name, size_t length, hex_implementation::UseImplementation impl)
 {
-    auto data = generateHexString(130); // Generates 678B0EDA0A1FD30904D5A65E3568DB82DB2D918B0AD8DEA18A63FECCB877D07CAD1495C7157584D877420EF38B8DA473A6348B4F51811AC13C786B962BEE5668F9 by default
+    bench.name(strprintf("%s using the '%s' hex implementation", name, HexAutoDetect(impl)));
+    auto data = generateHexString(length);
 
     bench.batch(data.size()).unit("base16").run([&] {
         auto result = TryParseHex(data);
         assert(result != std::nullopt); // make sure we're measuring the successful case
         ankerl::nanobench::doNotOptimizeAway(result);
     });
+    HexAutoDetect();
+}
+
+static void HexParse(benchmark::Bench& bench)
+{
+    // Generates 678B0EDA0A1FD30904D5A65E3568DB82DB2D918B0AD8DEA18A63FECCB877D07CAD1495C7157584D877420EF38B8DA473A6348B4F51811AC13C786B962BEE5668F9 by default
+    RunHexParse(bench, __func__, 130, hex_implementation::USE_ALL);
+}
+
+static void HexParseStandard(benchmark::Bench& bench)
+{
+    RunHexParse(bench, __func__, 130, hex_implementation::STANDARD);
+}
+
+/** A serialized transaction or block as passed to raw transaction RPCs. */
+static void HexParseLarge(benchmark::Bench& bench)
+{
+    RunHexParse(bench, __func__, 1 << 20, hex_implementation::USE_ALL);
+}
+
+static void HexParseLargeStandard(benchmark::Bench& bench)
+{
+    RunHexParse(bench, __func__, 1 << 20, hex_implementation::STANDARD);
 }
 
 BENCHMARK(HexParse, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HexParseStandard, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HexParseLarge, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HexParseLargeStandard, benchmark::PriorityLevel::HIGH);
@@ -16,6 +16,7 @@
 #include <util/check.h>
 
 #include <memory>
+#include <optional>
 #include <vector>
 
 
@@ -25,7 +26,7 @@ static void AddTx(const CTransactionRef& tx, const CAmount& fee, CTxMemPool& poo
     AddToMempool(pool, CTxMemPoolEntry(tx, fee, /*time=*/0, /*entry_height=*/1, /*entry_sequence=*/0, /*spends_coinbase=*/false, /*sigops_cost=*/4, lp));
 }
 
-static void RpcMempool(benchmark::Bench& bench)
+static void RunRpcMempool(benchmark::Bench& bench, bool arena)
 {
     const auto testing_setup = MakeNoLogFileContext<const ChainTestingSetup>(ChainType::MAIN);
     CTxMemPool& pool = *Assert(testing_setup->m_node.mempool);
@@ -44,8 +45,14 @@ static void RpcMempool(benchmark::Bench& bench)
     }
 
     bench.run([&] {
+        std::optional<UniValue::Arena> scope;
+        if (arena) scope.emplace();
         (void)MempoolToJSON(pool, /*verbose=*/true);
     });
 }
 
+static void RpcMempool(benchmark::Bench& bench) { RunRpcMempool(bench, /*arena=*/false); }
+static void RpcMempoolArena(benchmark::Bench& bench) { RunRpcMempool(bench, /*arena=*/true); }
+
 BENCHMARK(RpcMempool, benchmark::PriorityLevel::HIGH);
+BENCHMARK(RpcMempoolArena, benchmark::PriorityLevel::HIGH);
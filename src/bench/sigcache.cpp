@@ -0,0 +1,56 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <random.h>
+#include <script/sigcache.h>
+#include <uint256.h>
+
+#include <cstddef>
+#include <thread>
+#include <vector>
+
+static constexpr size_t OPS_PER_THREAD{10000};
+
+/**
+ * Looks up entries in a signature cache from several threads at once, and
+ * inserts those that are missing.  Half of the entries are in the cache
+ * already, similar to block validation after the transactions were accepted
+ * to the mempool.
+ */
+static void RunSignatureCacheParallel(benchmark::Bench& bench, const size_t num_threads)
+{
+    SignatureCache cache{DEFAULT_SIGNATURE_CACHE_BYTES};
+    FastRandomContext rng{/*fDeterministic=*/true};
+
+    std::vector<std::vector<uint256>> entries(num_threads);
+    for (auto& thread_entries : entries) {
+        thread_entries.reserve(OPS_PER_THREAD);
+        for (size_t i = 0; i < OPS_PER_THREAD; ++i) {
+            thread_entries.push_back(rng.rand256());
+            if (i % 2 == 0) cache.Set(thread_entries.back());
+        }
+    }
+
+    bench.batch(num_threads * OPS_PER_THREAD).unit("lookup").run([&] {
+        std::vector<std::thread> threads;
+        threads.reserve(num_threads);
+        for (const auto& thread_entries : entries) {
+            threads.emplace_back([&cache, &thread_entries] {
+                for (const uint256& entry : thread_entries) {
+                    if (!cache.Get(entry, /*erase=*/false)) cache.Set(entry);
+                }
+            });
+        }
+        for (auto& thread : threads) thread.join();
+    });
+}
+
+static void SignatureCacheParallel1(benchmark::Bench& bench) { RunSignatureCacheParallel(bench, 1); }
+static void SignatureCacheParallel4(benchmark::Bench& bench) { RunSignatureCacheParallel(bench, 4); }
+static void SignatureCacheParallel8(benchmark::Bench& bench) { RunSignatureCacheParallel(bench, 8); }
+
+BENCHMARK(SignatureCacheParallel1, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SignatureCacheParallel4, benchmark::PriorityLevel::HIGH);
+BENCHMARK(SignatureCacheParallel8, benchmark::PriorityLevel::HIGH);
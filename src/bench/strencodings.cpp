@@ -4,18 +4,37 @@
 
 #include <bench/bench.h>
 #include <bench/data/block413567.raw.h>
+#include <crypto/hex_base.h>
 #include <span.h>
+#include <tinyformat.h>
+#include <uint256.h>
 #include <util/strencodings.h>
 
 #include <vector>
 
-static void HexStrBench(benchmark::Bench& bench)
+static void RunHexStr(benchmark::Bench& bench, const char* name, hex_implementation::UseImplementation impl)
 {
+    bench.name(strprintf("%s using the '%s' hex implementation", name, HexAutoDetect(impl)));
     auto const& data = benchmark::data::block413567;
     bench.batch(data.size()).unit("byte").run([&] {
         auto hex = HexStr(data);
         ankerl::nanobench::doNotOptimizeAway(hex);
     });
+    HexAutoDetect();
+}
+
+static void HexStrBench(benchmark::Bench& bench) { RunHexStr(bench, __func__, hex_implementation::USE_ALL); }
+static void HexStrBenchStandard(benchmark::Bench& bench) { RunHexStr(bench, __func__, hex_implementation::STANDARD); }
+
+static void Uint256GetHex(benchmark::Bench& bench)
+{
+    const uint256 hash{uint256::ONE};
+    bench.run([&] {
+        auto hex = hash.GetHex();
+        ankerl::nanobench::doNotOptimizeAway(hex);
+    });
 }
 
 BENCHMARK(HexStrBench, benchmark::PriorityLevel::HIGH);
+BENCHMARK(HexStrBenchStandard, benchmark::PriorityLevel::HIGH);
+BENCHMARK(Uint256GetHex, benchmark::PriorityLevel::HIGH);
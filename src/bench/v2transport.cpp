@@ -0,0 +1,71 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <bench/bench.h>
+#include <key.h>
+#include <net.h>
+#include <protocol.h>
+#include <span.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+/** Move all bytes that from wants to send into to, and return the number of
+ *  complete messages that to received along the way. */
+size_t Deliver(Transport& from, Transport& to)
+{
+    size_t received{0};
+    while (true) {
+        const auto& [bytes, more, msg_type] = from.GetBytesToSend(false);
+        if (bytes.empty()) break;
+        std::span<const uint8_t> to_receive{bytes};
+        const size_t len{to_receive.size()};
+        while (!to_receive.empty()) {
+            const bool ok{to.ReceivedBytes(to_receive)};
+            assert(ok);
+            if (to.ReceivedMessageComplete()) {
+                bool reject{false};
+                to.GetReceivedMessage({}, reject);
+                assert(!reject);
+                ++received;
+            }
+        }
+        from.MarkBytesSent(len);
+    }
+    return received;
+}
+
+} // namespace
+
+/** Encrypt, transfer and decrypt 1 MB messages between two connected
+ *  V2Transport instances, after completing the BIP324 handshake. */
+static void V2Transport_1MB(benchmark::Bench& bench)
+{
+    ECC_Context ecc_context{};
+    V2Transport initiator{0, true};
+    V2Transport responder{1, false};
+    for (int i = 0; i < 4; ++i) {
+        Deliver(initiator, responder);
+        Deliver(responder, initiator);
+    }
+    assert(initiator.GetInfo().transport_type == TransportProtocolType::V2);
+    assert(responder.GetInfo().transport_type == TransportProtocolType::V2);
+
+    const std::vector<unsigned char> payload(1024 * 1024);
+    bench.batch(payload.size()).unit("byte").run([&] {
+        CSerializedNetMsg msg;
+        msg.m_type = NetMsgType::BLOCK;
+        msg.data = payload;
+        const bool queued{initiator.SetMessageToSend(msg)};
+        assert(queued);
+        const size_t received{Deliver(initiator, responder)};
+        assert(received == 1);
+    });
+}
+
+BENCHMARK(V2Transport_1MB, benchmark::PriorityLevel::HIGH);
@@ -24,7 +24,7 @@
 #include <string>
 
 namespace wallet {
-static void WalletBalance(benchmark::Bench& bench, const bool set_dirty, const bool add_mine)
+static void WalletBalance(benchmark::Bench& bench, const bool set_dirty, const bool add_mine, const bool tx_changed = false)
 {
     const auto test_setup = MakeNoLogFileContext<const TestingSetup>();
 
@@ -51,9 +51,11 @@ static void WalletBalance(benchmark::Bench& bench, const bool set_dirty, const b
     wallet.chain().waitForNotificationsIfTipChanged(uint256::ZERO);
 
     auto bal = GetBalance(wallet); // Cache
+    const CWalletTx* changed_tx{WITH_LOCK(wallet.cs_wallet, return &wallet.mapWallet.begin()->second)};
 
     bench.run([&] {
         if (set_dirty) wallet.MarkDirty();
+        if (tx_changed) WITH_LOCK(wallet.cs_wallet, wallet.MarkBalanceDirty(*changed_tx));
         bal = GetBalance(wallet);
         if (add_mine) assert(bal.m_mine_trusted > 0);
     });
@@ -61,11 +63,13 @@ static void WalletBalance(benchmark::Bench& bench, const bool set_dirty, const b
 
 static void WalletBalanceDirty(benchmark::Bench& bench) { WalletBalance(bench, /*set_dirty=*/true, /*add_mine=*/true); }
 static void WalletBalanceClean(benchmark::Bench& bench) { WalletBalance(bench, /*set_dirty=*/false, /*add_mine=*/true); }
+static void WalletBalanceTxChanged(benchmark::Bench& bench) { WalletBalance(bench, /*set_dirty=*/false, /*add_mine=*/true, /*tx_changed=*/true); }
 static void WalletBalanceMine(benchmark::Bench& bench) { WalletBalance(bench, /*set_dirty=*/false, /*add_mine=*/true); }
 static void WalletBalanceWatch(benchmark::Bench& bench) { WalletBalance(bench, /*set_dirty=*/false, /*add_mine=*/false); }
 
 BENCHMARK(WalletBalanceDirty, benchmark::PriorityLevel::HIGH);
 BENCHMARK(WalletBalanceClean, benchmark::PriorityLevel::HIGH);
+BENCHMARK(WalletBalanceTxChanged, benchmark::PriorityLevel::HIGH);
 BENCHMARK(WalletBalanceMine, benchmark::PriorityLevel::HIGH);
 BENCHMARK(WalletBalanceWatch, benchmark::PriorityLevel::HIGH);
 } // namespace wallet
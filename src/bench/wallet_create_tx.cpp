@@ -22,16 +22,20 @@
 #include <uint256.h>
 #include <util/result.h>
 #include <util/time.h>
+#include <util/translation.h>
 #include <validation.h>
 #include <versionbits.h>
 #include <wallet/coincontrol.h>
 #include <wallet/coinselection.h>
 #include <wallet/spend.h>
+#include <wallet/sqlite.h>
 #include <wallet/test/util.h>
 #include <wallet/wallet.h>
+#include <wallet/walletdb.h>
 #include <wallet/walletutil.h>
 
 #include <cassert>
+#include <chrono>
 #include <cstdint>
 #include <map>
 #include <memory>
@@ -198,6 +202,38 @@ static void AvailableCoins(benchmark::Bench& bench, const std::vector<OutputType
     });
 }
 
+static void WalletCommitTx(benchmark::Bench& bench, bool use_wal, std::chrono::milliseconds group_commit_window)
+{
+    const auto test_setup = MakeNoLogFileContext<const TestingSetup>();
+
+    wallet::DatabaseOptions options;
+    options.use_wal = use_wal;
+    options.group_commit_window = group_commit_window;
+    wallet::DatabaseStatus status;
+    bilingual_str error;
+    auto database{wallet::MakeSQLiteDatabase(test_setup->m_path_root / "wallet", options, status, error)};
+    assert(database);
+
+    // Records written for every move sent: the transaction and an address label
+    CMutableTransaction mtx;
+    mtx.vin.resize(1);
+    mtx.vout.resize(2);
+    mtx.vout[0].scriptPubKey = CScript() << OP_TRUE;
+    uint32_t n{0};
+
+    bench.unit("commit").run([&] {
+        mtx.nLockTime = ++n;
+        const wallet::CWalletTx wtx{MakeTransactionRef(mtx), wallet::TxStateInactive{}};
+        wallet::WalletBatch batch{*database};
+        assert(batch.WriteTx(wtx));
+        assert(batch.WriteName(wtx.GetHash().GetHex(), "move"));
+    });
+}
+
+static void WalletCommitTxJournal(benchmark::Bench& bench) { WalletCommitTx(bench, /*use_wal=*/false, std::chrono::milliseconds{0}); }
+static void WalletCommitTxWal(benchmark::Bench& bench) { WalletCommitTx(bench, /*use_wal=*/true, std::chrono::milliseconds{0}); }
+static void WalletCommitTxWalGroupCommit(benchmark::Bench& bench) { WalletCommitTx(bench, /*use_wal=*/true, std::chrono::milliseconds{20}); }
+
 static void WalletCreateTxUseOnlyPresetInputs(benchmark::Bench& bench) { WalletCreateTx(bench, OutputType::BECH32, /*allow_other_inputs=*/false,
                                                                                         {{/*num_of_internal_inputs=*/4}}); }
 
@@ -209,3 +245,6 @@ static void WalletAvailableCoins(benchmark::Bench& bench) { AvailableCoins(bench
 BENCHMARK(WalletCreateTxUseOnlyPresetInputs, benchmark::PriorityLevel::LOW)
 BENCHMARK(WalletCreateTxUsePresetInputsAndCoinSelection, benchmark::PriorityLevel::LOW)
 BENCHMARK(WalletAvailableCoins, benchmark::PriorityLevel::LOW);
+BENCHMARK(WalletCommitTxJournal, benchmark::PriorityLevel::LOW);
+BENCHMARK(WalletCommitTxWal, benchmark::PriorityLevel::LOW);
+BENCHMARK(WalletCommitTxWalGroupCommit, benchmark::PriorityLevel::LOW);
@@ -7,10 +7,12 @@
 #include <key.h>
 #include <key_io.h>
 #include <script/descriptor.h>
+#include <script/names.h>
 #include <script/script.h>
 #include <script/signingprovider.h>
 #include <sync.h>
 #include <test/util/setup_common.h>
+#include <util/string.h>
 #include <wallet/context.h>
 #include <wallet/db.h>
 #include <wallet/test/util.h>
@@ -25,9 +27,10 @@
 #include <utility>
 
 namespace wallet {
-static void WalletIsMine(benchmark::Bench& bench, int num_combo = 0)
+static void WalletIsMine(benchmark::Bench& bench, int num_combo = 0, bool name_script = false, int keypool_size = 0)
 {
     const auto test_setup = MakeNoLogFileContext<TestingSetup>();
+    if (keypool_size > 0) test_setup->m_args.ForceSetArg("-keypool", util::ToString(keypool_size));
 
     WalletContext context;
     context.args = &test_setup->m_args;
@@ -54,7 +57,12 @@ static void WalletIsMine(benchmark::Bench& bench, int num_combo = 0)
         }
     }
 
-    const CScript script = GetScriptForDestination(DecodeDestination(ADDRESS_BCRT1_UNSPENDABLE));
+    CScript script = GetScriptForDestination(DecodeDestination(ADDRESS_BCRT1_UNSPENDABLE));
+    if (name_script) {
+        const valtype name{'p', '/', 'x'};
+        const valtype value{'{', '}'};
+        script = CNameScript::buildNameUpdate(script, name, value);
+    }
 
     bench.run([&] {
         LOCK(wallet->cs_wallet);
@@ -67,6 +75,10 @@ static void WalletIsMine(benchmark::Bench& bench, int num_combo = 0)
 
 static void WalletIsMineDescriptors(benchmark::Bench& bench) { WalletIsMine(bench); }
 static void WalletIsMineMigratedDescriptors(benchmark::Bench& bench) { WalletIsMine(bench, /*num_combo=*/2000); }
+static void WalletIsMineNameScript(benchmark::Bench& bench) { WalletIsMine(bench, /*num_combo=*/0, /*name_script=*/true); }
+static void WalletIsMineLargeKeypool(benchmark::Bench& bench) { WalletIsMine(bench, /*num_combo=*/0, /*name_script=*/false, /*keypool_size=*/10000); }
 BENCHMARK(WalletIsMineDescriptors, benchmark::PriorityLevel::LOW);
 BENCHMARK(WalletIsMineMigratedDescriptors, benchmark::PriorityLevel::LOW);
+BENCHMARK(WalletIsMineNameScript, benchmark::PriorityLevel::LOW);
+BENCHMARK(WalletIsMineLargeKeypool, benchmark::PriorityLevel::LOW);
 } // namespace wallet
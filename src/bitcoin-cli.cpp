@@ -286,7 +286,7 @@ struct AddrinfoRequestHandler : BaseRequestHandler {
     UniValue ProcessReply(const UniValue& reply) override
     {
         if (!reply["error"].isNull()) return reply;
-        const std::vector<UniValue>& nodes{reply["result"].getValues()};
+        const UniValue::Values& nodes{reply["result"].getValues()};
         if (!nodes.empty() && nodes.at(0)["network"].isNull()) {
             throw std::runtime_error("-addrinfo requires xayad server to be running v22.0 and up");
         }
@@ -643,7 +643,7 @@ public:
 
         // Report local addresses, ports, and scores.
         result += "\n\nLocal addresses";
-        const std::vector<UniValue>& local_addrs{networkinfo["localaddresses"].getValues()};
+        const UniValue::Values& local_addrs{networkinfo["localaddresses"].getValues()};
         if (local_addrs.empty()) {
             result += ": n/a\n";
         } else {
@@ -28,6 +28,11 @@
   * the master is done adding work, it temporarily joins the worker pool
   * as an N'th worker, until all jobs are done.
   *
+  * If T defines a type T::Batch, and batch verification is enabled, each
+  * worker runs its checks with operator()(T::Batch&) instead, and then
+  * calls Batch::Verify() once for all of them. If that fails (or any check
+  * fails), the checks are repeated one by one to find the error.
+  *
   */
 template <typename T, typename R = std::remove_cvref_t<decltype(std::declval<T>()().value())>>
 class CCheckQueue
@@ -65,9 +70,29 @@ private:
     //! The maximum number of elements to be processed in one batch
     const unsigned int nBatchSize;
 
+    //! Whether to use T::Batch (if it exists)
+    const bool m_batch_verify;
+
     std::vector<std::thread> m_worker_threads;
     bool m_request_stop GUARDED_BY(m_mutex){false};
 
+    /** Run the checks of one batch, and return the first error (if any). */
+    std::optional<R> RunChecks(std::vector<T>& checks) const
+    {
+        if constexpr (requires { typename T::Batch; }) {
+            if (m_batch_verify) {
+                typename T::Batch batch;
+                const bool checks_ok{std::all_of(checks.begin(), checks.end(), [&](T& check) { return !check(batch).has_value(); })};
+                if (checks_ok && batch.Verify()) return std::nullopt;
+            }
+        }
+        for (T& check : checks) {
+            auto result{check()};
+            if (result.has_value()) return result;
+        }
+        return std::nullopt;
+    }
+
     /** Internal function that does bulk of the verification work. If fMaster, return the final result. */
     std::optional<R> Loop(bool fMaster) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
@@ -127,10 +152,7 @@ private:
             }
             // execute work
             if (do_work) {
-                for (T& check : vChecks) {
-                    local_result = check();
-                    if (local_result.has_value()) break;
-                }
+                local_result = RunChecks(vChecks);
             }
             vChecks.clear();
         } while (true);
@@ -141,8 +163,8 @@ public:
     Mutex m_control_mutex;
 
     //! Create a new check queue
-    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num)
-        : nBatchSize(batch_size)
+    explicit CCheckQueue(unsigned int batch_size, int worker_threads_num, bool batch_verify = true)
+        : nBatchSize(batch_size), m_batch_verify(batch_verify)
     {
         LogInfo("Script verification uses %d additional threads", worker_threads_num);
         m_worker_threads.reserve(worker_threads_num);
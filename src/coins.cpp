@@ -21,6 +21,12 @@ bool CCoinsView::GetNameHistory(const valtype &name, CNameHistory &data) const {
 CNameIterator* CCoinsView::IterateNames() const { assert (false); }
 bool CCoinsView::BatchWrite(CoinsViewCacheCursor& cursor, const uint256 &hashBlock, const CNameCache& names) { return false; }
 std::unique_ptr<CCoinsViewCursor> CCoinsView::Cursor() const { return nullptr; }
+std::vector<std::unique_ptr<CCoinsViewCursor>> CCoinsView::RangeCursors(size_t max_ranges) const
+{
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    cursors.push_back(Cursor());
+    return cursors;
+}
 bool CCoinsView::ValidateNameDB(const Chainstate& chainState, const std::function<void()>& interruption_point) const { return false; }
 
 bool CCoinsView::HaveCoin(const COutPoint &outpoint) const
@@ -39,6 +45,7 @@ CNameIterator* CCoinsViewBacked::IterateNames() const { return base->IterateName
 void CCoinsViewBacked::SetBackend(CCoinsView &viewIn) { base = &viewIn; }
 bool CCoinsViewBacked::BatchWrite(CoinsViewCacheCursor& cursor, const uint256 &hashBlock, const CNameCache& names) { return base->BatchWrite(cursor, hashBlock, names); }
 std::unique_ptr<CCoinsViewCursor> CCoinsViewBacked::Cursor() const { return base->Cursor(); }
+std::vector<std::unique_ptr<CCoinsViewCursor>> CCoinsViewBacked::RangeCursors(size_t max_ranges) const { return base->RangeCursors(max_ranges); }
 size_t CCoinsViewBacked::EstimateSize() const { return base->EstimateSize(); }
 bool CCoinsViewBacked::ValidateNameDB(const Chainstate& chainState, const std::function<void()>& interruption_point) const { return base->ValidateNameDB(chainState, interruption_point); }
 
@@ -343,6 +343,11 @@ public:
     //! Get a cursor to iterate over the whole state
     virtual std::unique_ptr<CCoinsViewCursor> Cursor() const;
 
+    //! Get cursors over consecutive ranges of the whole state, which all read
+    //! the same state and can be used concurrently. All outputs of a
+    //! transaction are in the same range. Returns at most max_ranges cursors.
+    virtual std::vector<std::unique_ptr<CCoinsViewCursor>> RangeCursors(size_t max_ranges) const;
+
     // Validate the name database.
     virtual bool ValidateNameDB(const Chainstate& chainState, const std::function<void()>& interruption_point) const;
 
@@ -372,6 +377,7 @@ public:
     void SetBackend(CCoinsView &viewIn);
     bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256 &hashBlock, const CNameCache& names) override;
     std::unique_ptr<CCoinsViewCursor> Cursor() const override;
+    std::vector<std::unique_ptr<CCoinsViewCursor>> RangeCursors(size_t max_ranges) const override;
     size_t EstimateSize() const override;
     bool ValidateNameDB(const Chainstate& chainState, const std::function<void()>& interruption_point) const override;
 };
@@ -421,6 +427,9 @@ public:
     std::unique_ptr<CCoinsViewCursor> Cursor() const override {
         throw std::logic_error("CCoinsViewCache cursor iteration not supported.");
     }
+    std::vector<std::unique_ptr<CCoinsViewCursor>> RangeCursors(size_t max_ranges) const override {
+        throw std::logic_error("CCoinsViewCache cursor iteration not supported.");
+    }
 
     /* Changes to the name database.  */
     void SetName(const valtype &name, const CNameData &data, bool undo);
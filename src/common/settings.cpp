@@ -103,8 +103,8 @@ bool ReadSettings(const fs::path& path, std::map<std::string, SettingsValue>& va
         return false;
     }
 
-    const std::vector<std::string>& in_keys = in.getKeys();
-    const std::vector<SettingsValue>& in_values = in.getValues();
+    const UniValue::Keys& in_keys = in.getKeys();
+    const SettingsValue::Values& in_values = in.getValues();
     for (size_t i = 0; i < in_keys.size(); ++i) {
         auto inserted = values.emplace(in_keys[i], in_values[i]);
         if (!inserted.second) {
@@ -22,5 +22,25 @@ void static inline GetCPUID(uint32_t leaf, uint32_t subleaf, uint32_t& a, uint32
 #endif
 }
 
+/** Check whether the OS has enabled AVX registers. */
+bool static inline AVXEnabled()
+{
+    uint32_t a, d;
+    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
+    return (a & 6) == 6;
+}
+
+/** Check whether the CPU supports AVX2 and the OS has enabled AVX registers. */
+bool static inline AVX2Enabled()
+{
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    const bool have_xsave = (ecx >> 27) & 1;
+    const bool have_avx = (ecx >> 28) & 1;
+    if (!have_xsave || !have_avx || !AVXEnabled()) return false;
+    GetCPUID(7, 0, eax, ebx, ecx, edx);
+    return (ebx >> 5) & 1;
+}
+
 #endif // defined(__x86_64__) || defined(__amd64__) || defined(__i386__)
 #endif // BITCOIN_COMPAT_CPUID_H
@@ -7,12 +7,24 @@
 
 #include <crypto/common.h>
 #include <crypto/chacha20.h>
+#include <compat/cpuid.h>
 #include <support/cleanse.h>
 #include <span.h>
 
 #include <algorithm>
 #include <bit>
 #include <cstring>
+#include <string>
+
+namespace chacha20_sse2
+{
+void Crypt4(const uint32_t input[12], const std::byte* in, std::byte* out);
+}
+
+namespace chacha20_avx2
+{
+void Crypt8(const uint32_t input[12], const std::byte* in, std::byte* out);
+}
 
 #define QUARTERROUND(a,b,c,d) \
   a += b; d = std::rotl(d ^ a, 16); \
@@ -22,6 +34,34 @@
 
 #define REPEAT10(a) do { {a}; {a}; {a}; {a}; {a}; {a}; {a}; {a}; {a}; {a}; } while(0)
 
+namespace {
+
+/** Vectorized implementations computing 8 and 4 blocks at a time, if any. */
+void (*Crypt8)(const uint32_t input[12], const std::byte* in, std::byte* out) = nullptr;
+void (*Crypt4)(const uint32_t input[12], const std::byte* in, std::byte* out) = nullptr;
+
+/** Process as many whole groups of blocks as the vectorized implementations
+ *  allow, advancing the 64-bit block counter in input[8..9] the same way the
+ *  scalar code does.  in is null for keystream output.  The remaining blocks
+ *  are left to the scalar code. */
+void CryptMultiBlock(uint32_t input[12], const std::byte*& in, std::byte*& out, size_t& blocks)
+{
+    const auto run = [&](void (*kernel)(const uint32_t*, const std::byte*, std::byte*), size_t n) {
+        for (; blocks >= n; blocks -= n) {
+            kernel(input, in, out);
+            const uint64_t counter = (uint64_t{input[9]} << 32 | input[8]) + n;
+            input[8] = uint32_t(counter);
+            input[9] = uint32_t(counter >> 32);
+            if (in) in += n * ChaCha20Aligned::BLOCKLEN;
+            out += n * ChaCha20Aligned::BLOCKLEN;
+        }
+    };
+    if (Crypt8) run(Crypt8, 8);
+    if (Crypt4) run(Crypt4, 4);
+}
+
+} // namespace
+
 void ChaCha20Aligned::SetKey(std::span<const std::byte> key) noexcept
 {
     assert(key.size() == KEYLEN);
@@ -66,6 +106,8 @@ inline void ChaCha20Aligned::Keystream(std::span<std::byte> output) noexcept
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
+    const std::byte* m = nullptr;
+    CryptMultiBlock(input, m, c, blocks);
     if (!blocks) return;
 
     j4 = input[0];
@@ -169,6 +211,7 @@ inline void ChaCha20Aligned::Crypt(std::span<const std::byte> in_bytes, std::spa
     uint32_t x0, x1, x2, x3, x4, x5, x6, x7, x8, x9, x10, x11, x12, x13, x14, x15;
     uint32_t j4, j5, j6, j7, j8, j9, j10, j11, j12, j13, j14, j15;
 
+    CryptMultiBlock(input, m, c, blocks);
     if (!blocks) return;
 
     j4 = input[0];
@@ -370,3 +413,40 @@ void FSChaCha20::Crypt(std::span<const std::byte> input, std::span<std::byte> ou
         m_chunk_counter = 0;
     }
 }
+
+std::string ChaCha20AutoDetect(chacha20_implementation::UseImplementation use_implementation)
+{
+    std::string ret = "standard";
+    Crypt8 = nullptr;
+    Crypt4 = nullptr;
+
+#if defined(HAVE_GETCPUID)
+    [[maybe_unused]] bool have_sse2 = false;
+    [[maybe_unused]] bool have_avx2 = false;
+
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    if (use_implementation & chacha20_implementation::USE_SSE2) {
+        have_sse2 = (edx >> 26) & 1;
+    }
+    if (use_implementation & chacha20_implementation::USE_AVX2) {
+        have_avx2 = AVX2Enabled();
+    }
+
+#if defined(ENABLE_SSE2)
+    if (have_sse2) {
+        Crypt4 = chacha20_sse2::Crypt4;
+        ret = "sse2(4way)";
+    }
+#endif
+
+#if defined(ENABLE_AVX2)
+    if (have_avx2) {
+        Crypt8 = chacha20_avx2::Crypt8;
+        ret = Crypt4 ? "sse2(4way),avx2(8way)" : "avx2(8way)";
+    }
+#endif
+#endif // defined(HAVE_GETCPUID)
+
+    return ret;
+}
@@ -11,6 +11,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <string>
 #include <utility>
 
 // classes for ChaCha20 256-bit stream cipher developed by Daniel J. Bernstein
@@ -73,6 +74,20 @@ public:
     void Crypt(std::span<const std::byte> input, std::span<std::byte> output) noexcept;
 };
 
+namespace chacha20_implementation {
+enum UseImplementation : uint8_t {
+    STANDARD = 0,
+    USE_SSE2 = 1 << 0,
+    USE_AVX2 = 1 << 1,
+    USE_ALL = USE_SSE2 | USE_AVX2,
+};
+}
+
+/** Autodetect the best available implementation for computing several
+ *  ChaCha20 blocks at once.  Returns the name of the implementation.
+ */
+std::string ChaCha20AutoDetect(chacha20_implementation::UseImplementation use_implementation = chacha20_implementation::USE_ALL);
+
 /** Unrestricted ChaCha20 cipher. */
 class ChaCha20
 {
@@ -0,0 +1,114 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace chacha20_avx2 {
+namespace {
+
+inline __m256i Rotl16(__m256i x)
+{
+    const __m256i shuffle = _mm256_setr_epi8(2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13,
+                                             2, 3, 0, 1, 6, 7, 4, 5, 10, 11, 8, 9, 14, 15, 12, 13);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+inline __m256i Rotl12(__m256i x) { return _mm256_or_si256(_mm256_slli_epi32(x, 12), _mm256_srli_epi32(x, 20)); }
+inline __m256i Rotl8(__m256i x)
+{
+    const __m256i shuffle = _mm256_setr_epi8(3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14,
+                                             3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10, 15, 12, 13, 14);
+    return _mm256_shuffle_epi8(x, shuffle);
+}
+inline __m256i Rotl7(__m256i x) { return _mm256_or_si256(_mm256_slli_epi32(x, 7), _mm256_srli_epi32(x, 25)); }
+
+inline void QuarterRound(__m256i& a, __m256i& b, __m256i& c, __m256i& d)
+{
+    a = _mm256_add_epi32(a, b); d = Rotl16(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi32(c, d); b = Rotl12(_mm256_xor_si256(b, c));
+    a = _mm256_add_epi32(a, b); d = Rotl8(_mm256_xor_si256(d, a));
+    c = _mm256_add_epi32(c, d); b = Rotl7(_mm256_xor_si256(b, c));
+}
+
+/** Transpose the four words a..d of all eight blocks.  Unpacking works
+ *  within 128-bit lanes, so blocks[i] holds block i in its low half and
+ *  block i + 4 in its high half. */
+inline void Transpose(__m256i a, __m256i b, __m256i c, __m256i d, __m256i blocks[4])
+{
+    const __m256i t0 = _mm256_unpacklo_epi32(a, b);
+    const __m256i t1 = _mm256_unpacklo_epi32(c, d);
+    const __m256i t2 = _mm256_unpackhi_epi32(a, b);
+    const __m256i t3 = _mm256_unpackhi_epi32(c, d);
+    blocks[0] = _mm256_unpacklo_epi64(t0, t1);
+    blocks[1] = _mm256_unpackhi_epi64(t0, t1);
+    blocks[2] = _mm256_unpacklo_epi64(t2, t3);
+    blocks[3] = _mm256_unpackhi_epi64(t2, t3);
+}
+
+inline void Store(__m256i x, const std::byte* in, std::byte* out)
+{
+    if (in) x = _mm256_xor_si256(x, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in)));
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), x);
+}
+
+} // namespace
+
+/** Compute eight consecutive blocks starting at the counter in input[8..9],
+ *  with one block per vector lane.  If in is not null, the keystream is
+ *  XORed with it.  The caller advances the counter. */
+void Crypt8(const uint32_t input[12], const std::byte* in, std::byte* out)
+{
+    uint32_t ctr_lo[8], ctr_hi[8];
+    for (uint32_t i = 0; i < 8; ++i) {
+        ctr_lo[i] = input[8] + i;
+        ctr_hi[i] = input[9] + (ctr_lo[i] < input[8]);
+    }
+
+    __m256i j[16];
+    j[0] = _mm256_set1_epi32(0x61707865);
+    j[1] = _mm256_set1_epi32(0x3320646e);
+    j[2] = _mm256_set1_epi32(0x79622d32);
+    j[3] = _mm256_set1_epi32(0x6b206574);
+    for (int i = 0; i < 8; ++i) j[4 + i] = _mm256_set1_epi32(input[i]);
+    j[12] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctr_lo));
+    j[13] = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(ctr_hi));
+    j[14] = _mm256_set1_epi32(input[10]);
+    j[15] = _mm256_set1_epi32(input[11]);
+
+    __m256i x[16];
+    for (int i = 0; i < 16; ++i) x[i] = j[i];
+
+    for (int round = 0; round < 10; ++round) {
+        QuarterRound(x[0], x[4], x[8], x[12]);
+        QuarterRound(x[1], x[5], x[9], x[13]);
+        QuarterRound(x[2], x[6], x[10], x[14]);
+        QuarterRound(x[3], x[7], x[11], x[15]);
+        QuarterRound(x[0], x[5], x[10], x[15]);
+        QuarterRound(x[1], x[6], x[11], x[12]);
+        QuarterRound(x[2], x[7], x[8], x[13]);
+        QuarterRound(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; ++i) x[i] = _mm256_add_epi32(x[i], j[i]);
+
+    // Words 0-7 and 8-15 of each block are combined into 32-byte stores.
+    for (int half = 0; half < 2; ++half) {
+        __m256i lo[4], hi[4];
+        Transpose(x[8 * half], x[8 * half + 1], x[8 * half + 2], x[8 * half + 3], lo);
+        Transpose(x[8 * half + 4], x[8 * half + 5], x[8 * half + 6], x[8 * half + 7], hi);
+        for (int i = 0; i < 4; ++i) {
+            const size_t first = 64 * i + 32 * half;
+            const size_t second = 64 * (i + 4) + 32 * half;
+            Store(_mm256_permute2x128_si256(lo[i], hi[i], 0x20), in ? in + first : nullptr, out + first);
+            Store(_mm256_permute2x128_si256(lo[i], hi[i], 0x31), in ? in + second : nullptr, out + second);
+        }
+    }
+}
+
+} // namespace chacha20_avx2
+
+#endif
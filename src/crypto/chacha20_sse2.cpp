@@ -0,0 +1,93 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_SSE2
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace chacha20_sse2 {
+namespace {
+
+inline __m128i Rotl16(__m128i x) { return _mm_shufflehi_epi16(_mm_shufflelo_epi16(x, 0xb1), 0xb1); }
+inline __m128i Rotl12(__m128i x) { return _mm_or_si128(_mm_slli_epi32(x, 12), _mm_srli_epi32(x, 20)); }
+inline __m128i Rotl8(__m128i x) { return _mm_or_si128(_mm_slli_epi32(x, 8), _mm_srli_epi32(x, 24)); }
+inline __m128i Rotl7(__m128i x) { return _mm_or_si128(_mm_slli_epi32(x, 7), _mm_srli_epi32(x, 25)); }
+
+inline void QuarterRound(__m128i& a, __m128i& b, __m128i& c, __m128i& d)
+{
+    a = _mm_add_epi32(a, b); d = Rotl16(_mm_xor_si128(d, a));
+    c = _mm_add_epi32(c, d); b = Rotl12(_mm_xor_si128(b, c));
+    a = _mm_add_epi32(a, b); d = Rotl8(_mm_xor_si128(d, a));
+    c = _mm_add_epi32(c, d); b = Rotl7(_mm_xor_si128(b, c));
+}
+
+/** Write the four words a..d of all four blocks, XORed with in if given. */
+inline void Store(__m128i a, __m128i b, __m128i c, __m128i d, const std::byte* in, std::byte* out)
+{
+    const __m128i t0 = _mm_unpacklo_epi32(a, b);
+    const __m128i t1 = _mm_unpacklo_epi32(c, d);
+    const __m128i t2 = _mm_unpackhi_epi32(a, b);
+    const __m128i t3 = _mm_unpackhi_epi32(c, d);
+    __m128i blocks[4] = {
+        _mm_unpacklo_epi64(t0, t1),
+        _mm_unpackhi_epi64(t0, t1),
+        _mm_unpacklo_epi64(t2, t3),
+        _mm_unpackhi_epi64(t2, t3),
+    };
+    for (int i = 0; i < 4; ++i) {
+        if (in) blocks[i] = _mm_xor_si128(blocks[i], _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 64 * i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 64 * i), blocks[i]);
+    }
+}
+
+} // namespace
+
+/** Compute four consecutive blocks starting at the counter in input[8..9],
+ *  with one block per vector lane.  If in is not null, the keystream is
+ *  XORed with it.  The caller advances the counter. */
+void Crypt4(const uint32_t input[12], const std::byte* in, std::byte* out)
+{
+    uint32_t ctr_lo[4], ctr_hi[4];
+    for (uint32_t i = 0; i < 4; ++i) {
+        ctr_lo[i] = input[8] + i;
+        ctr_hi[i] = input[9] + (ctr_lo[i] < input[8]);
+    }
+
+    __m128i j[16];
+    j[0] = _mm_set1_epi32(0x61707865);
+    j[1] = _mm_set1_epi32(0x3320646e);
+    j[2] = _mm_set1_epi32(0x79622d32);
+    j[3] = _mm_set1_epi32(0x6b206574);
+    for (int i = 0; i < 8; ++i) j[4 + i] = _mm_set1_epi32(input[i]);
+    j[12] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctr_lo));
+    j[13] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(ctr_hi));
+    j[14] = _mm_set1_epi32(input[10]);
+    j[15] = _mm_set1_epi32(input[11]);
+
+    __m128i x[16];
+    for (int i = 0; i < 16; ++i) x[i] = j[i];
+
+    for (int round = 0; round < 10; ++round) {
+        QuarterRound(x[0], x[4], x[8], x[12]);
+        QuarterRound(x[1], x[5], x[9], x[13]);
+        QuarterRound(x[2], x[6], x[10], x[14]);
+        QuarterRound(x[3], x[7], x[11], x[15]);
+        QuarterRound(x[0], x[5], x[10], x[15]);
+        QuarterRound(x[1], x[6], x[11], x[12]);
+        QuarterRound(x[2], x[7], x[8], x[13]);
+        QuarterRound(x[3], x[4], x[9], x[14]);
+    }
+
+    for (int i = 0; i < 16; ++i) x[i] = _mm_add_epi32(x[i], j[i]);
+
+    for (int i = 0; i < 4; ++i) {
+        Store(x[4 * i], x[4 * i + 1], x[4 * i + 2], x[4 * i + 3], in ? in + 16 * i : nullptr, out + 16 * i);
+    }
+}
+
+} // namespace chacha20_sse2
+
+#endif
@@ -0,0 +1,65 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace hex_avx2 {
+
+/** Encode 32 bytes at a time, returning how many bytes were encoded. */
+size_t Encode(const uint8_t* in, size_t len, char* out)
+{
+    const __m256i table = _mm256_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f',
+                                           '0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m256i low_nibble = _mm256_set1_epi8(0x0f);
+
+    size_t done = 0;
+    for (; len - done >= 32; done += 32) {
+        const __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + done));
+        const __m256i hi = _mm256_shuffle_epi8(table, _mm256_and_si256(_mm256_srli_epi16(x, 4), low_nibble));
+        const __m256i lo = _mm256_shuffle_epi8(table, _mm256_and_si256(x, low_nibble));
+        // Unpacking works within 128-bit lanes, so the halves are reordered.
+        const __m256i a = _mm256_unpacklo_epi8(hi, lo);
+        const __m256i b = _mm256_unpackhi_epi8(hi, lo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * done), _mm256_permute2x128_si256(a, b, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + 2 * done + 32), _mm256_permute2x128_si256(a, b, 0x31));
+    }
+    return done;
+}
+
+/** Decode 32 hex digits at a time, stopping before the first block that
+ *  contains anything else.  Returns how many bytes were decoded. */
+size_t Decode(const char* in, size_t max_bytes, uint8_t* out)
+{
+    const __m256i nine = _mm256_set1_epi8(9);
+    const __m256i five = _mm256_set1_epi8(5);
+    const __m256i ten = _mm256_set1_epi8(10);
+    const __m256i lower_case = _mm256_set1_epi8(0x20);
+    // Multipliers to combine pairs of nibbles into bytes.
+    const __m256i combine = _mm256_set1_epi16(0x0110);
+
+    size_t done = 0;
+    for (; max_bytes - done >= 16; done += 16) {
+        const __m256i c = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(in + 2 * done));
+        const __m256i digit = _mm256_sub_epi8(c, _mm256_set1_epi8('0'));
+        const __m256i is_digit = _mm256_cmpeq_epi8(_mm256_min_epu8(digit, nine), digit);
+        const __m256i alpha = _mm256_sub_epi8(_mm256_or_si256(c, lower_case), _mm256_set1_epi8('a'));
+        const __m256i is_alpha = _mm256_cmpeq_epi8(_mm256_min_epu8(alpha, five), alpha);
+        if (_mm256_movemask_epi8(_mm256_or_si256(is_digit, is_alpha)) != -1) break;
+
+        const __m256i nibbles = _mm256_blendv_epi8(_mm256_add_epi8(alpha, ten), digit, is_digit);
+        const __m256i bytes = _mm256_maddubs_epi16(nibbles, combine);
+        // Packing works within 128-bit lanes, so gather the two low halves.
+        const __m256i packed = _mm256_permute4x64_epi64(_mm256_packus_epi16(bytes, bytes), 0x08);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + done), _mm256_castsi256_si128(packed));
+    }
+    return done;
+}
+
+} // namespace hex_avx2
+
+#endif
@@ -4,10 +4,25 @@
 
 #include <crypto/hex_base.h>
 
+#include <compat/cpuid.h>
+
 #include <array>
+#include <cassert>
 #include <cstring>
 #include <string>
 
+namespace hex_sse41
+{
+size_t Encode(const uint8_t* in, size_t len, char* out);
+size_t Decode(const char* in, size_t max_bytes, uint8_t* out);
+}
+
+namespace hex_avx2
+{
+size_t Encode(const uint8_t* in, size_t len, char* out);
+size_t Decode(const char* in, size_t max_bytes, uint8_t* out);
+}
+
 namespace {
 
 using ByteAsHex = std::array<char, 2>;
@@ -24,21 +39,54 @@ constexpr std::array<ByteAsHex, 256> CreateByteToHexMap()
     return byte_to_hex;
 }
 
-} // namespace
-
-std::string HexStr(const std::span<const uint8_t> s)
+void EncodeStandard(const uint8_t* in, size_t len, char* out)
 {
-    std::string rv(s.size() * 2, '\0');
     static constexpr auto byte_to_hex = CreateByteToHexMap();
     static_assert(sizeof(byte_to_hex) == 512);
 
-    char* it = rv.data();
-    for (uint8_t v : s) {
-        std::memcpy(it, byte_to_hex[v].data(), 2);
-        it += 2;
+    for (size_t i = 0; i < len; ++i) {
+        std::memcpy(out, byte_to_hex[in[i]].data(), 2);
+        out += 2;
     }
+}
+
+size_t DecodeStandard(const char* in, size_t max_bytes, uint8_t* out)
+{
+    size_t i = 0;
+    for (; i < max_bytes; ++i) {
+        const signed char c1 = HexDigit(in[2 * i]);
+        const signed char c2 = HexDigit(in[2 * i + 1]);
+        if (c1 < 0 || c2 < 0) break;
+        out[i] = uint8_t(c1 << 4) | uint8_t(c2);
+    }
+    return i;
+}
+
+/** Vectorized implementations handle whole blocks, and leave the rest to
+ *  the standard implementation. */
+template <size_t (*Kernel)(const uint8_t*, size_t, char*)>
+void EncodeWrapper(const uint8_t* in, size_t len, char* out)
+{
+    const size_t done = Kernel(in, len, out);
+    EncodeStandard(in + done, len - done, out + 2 * done);
+}
+
+template <size_t (*Kernel)(const char*, size_t, uint8_t*)>
+size_t DecodeWrapper(const char* in, size_t max_bytes, uint8_t* out)
+{
+    const size_t done = Kernel(in, max_bytes, out);
+    return done + DecodeStandard(in + 2 * done, max_bytes - done, out + done);
+}
+
+void (*Encode)(const uint8_t* in, size_t len, char* out) = EncodeStandard;
+size_t (*Decode)(const char* in, size_t max_bytes, uint8_t* out) = DecodeStandard;
+
+} // namespace
 
-    assert(it == rv.data() + rv.size());
+std::string HexStr(const std::span<const uint8_t> s)
+{
+    std::string rv(s.size() * 2, '\0');
+    Encode(s.data(), s.size(), rv.data());
     return rv;
 }
 
@@ -65,3 +113,46 @@ signed char HexDigit(char c)
     return p_util_hexdigit[(unsigned char)c];
 }
 
+size_t DecodeHexPairs(const char* in, size_t max_bytes, uint8_t* out)
+{
+    return Decode(in, max_bytes, out);
+}
+
+std::string HexAutoDetect(hex_implementation::UseImplementation use_implementation)
+{
+    std::string ret = "standard";
+    Encode = EncodeStandard;
+    Decode = DecodeStandard;
+
+#if defined(HAVE_GETCPUID)
+    [[maybe_unused]] bool have_sse41 = false;
+    [[maybe_unused]] bool have_avx2 = false;
+
+    uint32_t eax, ebx, ecx, edx;
+    GetCPUID(1, 0, eax, ebx, ecx, edx);
+    if (use_implementation & hex_implementation::USE_SSE41) {
+        have_sse41 = (ecx >> 19) & 1;
+    }
+    if (have_sse41 && (use_implementation & hex_implementation::USE_AVX2)) {
+        have_avx2 = AVX2Enabled();
+    }
+
+#if defined(ENABLE_SSE41)
+    if (have_sse41) {
+        Encode = EncodeWrapper<hex_sse41::Encode>;
+        Decode = DecodeWrapper<hex_sse41::Decode>;
+        ret = "sse41";
+    }
+#endif
+
+#if defined(ENABLE_AVX2)
+    if (have_avx2) {
+        Encode = EncodeWrapper<hex_avx2::Encode>;
+        Decode = DecodeWrapper<hex_avx2::Decode>;
+        ret = "avx2";
+    }
+#endif
+#endif // defined(HAVE_GETCPUID)
+
+    return ret;
+}
@@ -20,4 +20,25 @@ inline std::string HexStr(const std::span<const std::byte> s) { return HexStr(Ma
 
 signed char HexDigit(char c);
 
+/**
+ * Decode hex digit pairs from in (which holds at least 2 * max_bytes
+ * characters) to out, stopping at the first pair that is not two hex
+ * digits.  Returns the number of bytes decoded.
+ */
+size_t DecodeHexPairs(const char* in, size_t max_bytes, uint8_t* out);
+
+namespace hex_implementation {
+enum UseImplementation : uint8_t {
+    STANDARD = 0,
+    USE_SSE41 = 1 << 0,
+    USE_AVX2 = 1 << 1,
+    USE_ALL = USE_SSE41 | USE_AVX2,
+};
+}
+
+/** Autodetect the best available implementation of HexStr and
+ *  DecodeHexPairs.  Returns the name of the implementation.
+ */
+std::string HexAutoDetect(hex_implementation::UseImplementation use_implementation = hex_implementation::USE_ALL);
+
 #endif // BITCOIN_CRYPTO_HEX_BASE_H
@@ -0,0 +1,59 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_SSE41
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace hex_sse41 {
+
+/** Encode 16 bytes at a time, returning how many bytes were encoded. */
+size_t Encode(const uint8_t* in, size_t len, char* out)
+{
+    const __m128i table = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7', '8', '9', 'a', 'b', 'c', 'd', 'e', 'f');
+    const __m128i low_nibble = _mm_set1_epi8(0x0f);
+
+    size_t done = 0;
+    for (; len - done >= 16; done += 16) {
+        const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + done));
+        const __m128i hi = _mm_shuffle_epi8(table, _mm_and_si128(_mm_srli_epi16(x, 4), low_nibble));
+        const __m128i lo = _mm_shuffle_epi8(table, _mm_and_si128(x, low_nibble));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * done), _mm_unpacklo_epi8(hi, lo));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * done + 16), _mm_unpackhi_epi8(hi, lo));
+    }
+    return done;
+}
+
+/** Decode 16 hex digits at a time, stopping before the first block that
+ *  contains anything else.  Returns how many bytes were decoded. */
+size_t Decode(const char* in, size_t max_bytes, uint8_t* out)
+{
+    const __m128i nine = _mm_set1_epi8(9);
+    const __m128i five = _mm_set1_epi8(5);
+    const __m128i ten = _mm_set1_epi8(10);
+    const __m128i lower_case = _mm_set1_epi8(0x20);
+    // Multipliers to combine pairs of nibbles into bytes.
+    const __m128i combine = _mm_set1_epi16(0x0110);
+
+    size_t done = 0;
+    for (; max_bytes - done >= 8; done += 8) {
+        const __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(in + 2 * done));
+        const __m128i digit = _mm_sub_epi8(c, _mm_set1_epi8('0'));
+        const __m128i is_digit = _mm_cmpeq_epi8(_mm_min_epu8(digit, nine), digit);
+        const __m128i alpha = _mm_sub_epi8(_mm_or_si128(c, lower_case), _mm_set1_epi8('a'));
+        const __m128i is_alpha = _mm_cmpeq_epi8(_mm_min_epu8(alpha, five), alpha);
+        if (_mm_movemask_epi8(_mm_or_si128(is_digit, is_alpha)) != 0xffff) break;
+
+        const __m128i nibbles = _mm_blendv_epi8(_mm_add_epi8(alpha, ten), digit, is_digit);
+        const __m128i bytes = _mm_maddubs_epi16(nibbles, combine);
+        _mm_storel_epi64(reinterpret_cast<__m128i*>(out + done), _mm_packus_epi16(bytes, bytes));
+    }
+    return done;
+}
+
+} // namespace hex_sse41
+
+#endif
@@ -5,7 +5,27 @@
 #include <crypto/common.h>
 #include <crypto/poly1305.h>
 
+#include <compat/cpuid.h>
+
 #include <cstring>
+#include <string>
+
+namespace poly1305_avx2
+{
+size_t Blocks(uint32_t h[5], const uint32_t r[5], const unsigned char* m, size_t blocks);
+}
+
+namespace {
+
+/** Vectorized implementation for runs of full blocks, if any.  Returns how
+ *  many blocks it processed. */
+size_t (*BlocksMulti)(uint32_t h[5], const uint32_t r[5], const unsigned char* m, size_t blocks) = nullptr;
+
+/** Below this many blocks, computing the powers of r for the vectorized
+ *  implementation does not pay off. */
+constexpr size_t MIN_MULTI_BLOCKS{16};
+
+} // namespace
 
 namespace poly1305_donna {
 
@@ -45,6 +65,12 @@ static void poly1305_blocks(poly1305_context *st, const unsigned char *m, size_t
     uint64_t d0,d1,d2,d3,d4;
     uint32_t c;
 
+    if (!st->final && BlocksMulti && bytes >= MIN_MULTI_BLOCKS * POLY1305_BLOCK_SIZE) {
+        const size_t done = BlocksMulti(st->h, st->r, m, bytes / POLY1305_BLOCK_SIZE) * POLY1305_BLOCK_SIZE;
+        m += done;
+        bytes -= done;
+    }
+
     r0 = st->r[0];
     r1 = st->r[1];
     r2 = st->r[2];
@@ -221,3 +247,26 @@ void poly1305_update(poly1305_context *st, const unsigned char *m, size_t bytes)
 }
 
 }  // namespace poly1305_donna
+
+std::string Poly1305AutoDetect(poly1305_implementation::UseImplementation use_implementation)
+{
+    std::string ret = "standard";
+    BlocksMulti = nullptr;
+
+#if defined(HAVE_GETCPUID)
+    [[maybe_unused]] bool have_avx2 = false;
+
+    if (use_implementation & poly1305_implementation::USE_AVX2) {
+        have_avx2 = AVX2Enabled();
+    }
+
+#if defined(ENABLE_AVX2)
+    if (have_avx2) {
+        BlocksMulti = poly1305_avx2::Blocks;
+        ret = "avx2(4way)";
+    }
+#endif
+#endif // defined(HAVE_GETCPUID)
+
+    return ret;
+}
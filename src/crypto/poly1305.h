@@ -10,6 +10,7 @@
 #include <cassert>
 #include <cstdint>
 #include <cstdlib>
+#include <string>
 
 #define POLY1305_BLOCK_SIZE 16
 
@@ -33,6 +34,19 @@ void poly1305_finish(poly1305_context *st, unsigned char mac[16]) noexcept;
 
 }  // namespace poly1305_donna
 
+namespace poly1305_implementation {
+enum UseImplementation : uint8_t {
+    STANDARD = 0,
+    USE_AVX2 = 1 << 0,
+    USE_ALL = USE_AVX2,
+};
+}
+
+/** Autodetect the best available implementation for runs of full Poly1305
+ *  blocks.  Returns the name of the implementation.
+ */
+std::string Poly1305AutoDetect(poly1305_implementation::UseImplementation use_implementation = poly1305_implementation::USE_ALL);
+
 /** C++ wrapper with std::byte span interface around poly1305_donna code. */
 class Poly1305
 {
@@ -0,0 +1,138 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifdef ENABLE_AVX2
+
+#include <cstddef>
+#include <cstdint>
+#include <immintrin.h>
+
+namespace poly1305_avx2 {
+namespace {
+
+constexpr uint32_t LIMB_MASK{0x3ffffff};
+
+/** out = a * b, with the partial reduction of poly1305-donna-32. */
+void Mul(uint32_t out[5], const uint32_t a[5], const uint32_t b[5])
+{
+    const uint32_t s1 = b[1] * 5, s2 = b[2] * 5, s3 = b[3] * 5, s4 = b[4] * 5;
+    uint64_t d0 = (uint64_t)a[0] * b[0] + (uint64_t)a[1] * s4 + (uint64_t)a[2] * s3 + (uint64_t)a[3] * s2 + (uint64_t)a[4] * s1;
+    uint64_t d1 = (uint64_t)a[0] * b[1] + (uint64_t)a[1] * b[0] + (uint64_t)a[2] * s4 + (uint64_t)a[3] * s3 + (uint64_t)a[4] * s2;
+    uint64_t d2 = (uint64_t)a[0] * b[2] + (uint64_t)a[1] * b[1] + (uint64_t)a[2] * b[0] + (uint64_t)a[3] * s4 + (uint64_t)a[4] * s3;
+    uint64_t d3 = (uint64_t)a[0] * b[3] + (uint64_t)a[1] * b[2] + (uint64_t)a[2] * b[1] + (uint64_t)a[3] * b[0] + (uint64_t)a[4] * s4;
+    uint64_t d4 = (uint64_t)a[0] * b[4] + (uint64_t)a[1] * b[3] + (uint64_t)a[2] * b[2] + (uint64_t)a[3] * b[1] + (uint64_t)a[4] * b[0];
+
+    uint32_t c;
+                 c = (uint32_t)(d0 >> 26); out[0] = (uint32_t)d0 & LIMB_MASK;
+    d1 += c;     c = (uint32_t)(d1 >> 26); out[1] = (uint32_t)d1 & LIMB_MASK;
+    d2 += c;     c = (uint32_t)(d2 >> 26); out[2] = (uint32_t)d2 & LIMB_MASK;
+    d3 += c;     c = (uint32_t)(d3 >> 26); out[3] = (uint32_t)d3 & LIMB_MASK;
+    d4 += c;     c = (uint32_t)(d4 >> 26); out[4] = (uint32_t)d4 & LIMB_MASK;
+    out[0] += c * 5; c = out[0] >> 26; out[0] &= LIMB_MASK;
+    out[1] += c;
+}
+
+/** Multiply the four lanes of h by r, where s holds the limbs of r times 5. */
+inline void MulLanes(__m256i h[5], const __m256i r[5], const __m256i s[5])
+{
+    __m256i d[5];
+    d[0] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(
+        _mm256_mul_epu32(h[0], r[0]), _mm256_mul_epu32(h[1], s[4])), _mm256_mul_epu32(h[2], s[3])),
+        _mm256_mul_epu32(h[3], s[2])), _mm256_mul_epu32(h[4], s[1]));
+    d[1] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(
+        _mm256_mul_epu32(h[0], r[1]), _mm256_mul_epu32(h[1], r[0])), _mm256_mul_epu32(h[2], s[4])),
+        _mm256_mul_epu32(h[3], s[3])), _mm256_mul_epu32(h[4], s[2]));
+    d[2] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(
+        _mm256_mul_epu32(h[0], r[2]), _mm256_mul_epu32(h[1], r[1])), _mm256_mul_epu32(h[2], r[0])),
+        _mm256_mul_epu32(h[3], s[4])), _mm256_mul_epu32(h[4], s[3]));
+    d[3] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(
+        _mm256_mul_epu32(h[0], r[3]), _mm256_mul_epu32(h[1], r[2])), _mm256_mul_epu32(h[2], r[1])),
+        _mm256_mul_epu32(h[3], r[0])), _mm256_mul_epu32(h[4], s[4]));
+    d[4] = _mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(_mm256_add_epi64(
+        _mm256_mul_epu32(h[0], r[4]), _mm256_mul_epu32(h[1], r[3])), _mm256_mul_epu32(h[2], r[2])),
+        _mm256_mul_epu32(h[3], r[1])), _mm256_mul_epu32(h[4], r[0]));
+
+    const __m256i mask = _mm256_set1_epi64x(LIMB_MASK);
+    __m256i c;
+    c = _mm256_srli_epi64(d[0], 26); h[0] = _mm256_and_si256(d[0], mask);
+    d[1] = _mm256_add_epi64(d[1], c); c = _mm256_srli_epi64(d[1], 26); h[1] = _mm256_and_si256(d[1], mask);
+    d[2] = _mm256_add_epi64(d[2], c); c = _mm256_srli_epi64(d[2], 26); h[2] = _mm256_and_si256(d[2], mask);
+    d[3] = _mm256_add_epi64(d[3], c); c = _mm256_srli_epi64(d[3], 26); h[3] = _mm256_and_si256(d[3], mask);
+    d[4] = _mm256_add_epi64(d[4], c); c = _mm256_srli_epi64(d[4], 26); h[4] = _mm256_and_si256(d[4], mask);
+    h[0] = _mm256_add_epi64(h[0], _mm256_add_epi64(c, _mm256_slli_epi64(c, 2)));
+    c = _mm256_srli_epi64(h[0], 26); h[0] = _mm256_and_si256(h[0], mask);
+    h[1] = _mm256_add_epi64(h[1], c);
+}
+
+} // namespace
+
+/** Process full 16-byte blocks four at a time, with block i going to lane
+ *  i % 4.  Every lane is multiplied by r^4 per step, except for the last step
+ *  where the lanes are multiplied by r^4, r^3, r^2 and r so that their sum
+ *  equals the result of the sequential evaluation.  Returns how many blocks
+ *  were processed; the rest is left to the scalar code. */
+size_t Blocks(uint32_t h[5], const uint32_t r[5], const unsigned char* m, size_t blocks)
+{
+    blocks &= ~size_t{3};
+    if (blocks == 0) return 0;
+
+    uint32_t r2[5], r3[5], r4[5];
+    Mul(r2, r, r);
+    Mul(r3, r2, r);
+    Mul(r4, r3, r);
+
+    __m256i step_r[5], step_s[5], last_r[5], last_s[5], acc[5];
+    for (int i = 0; i < 5; ++i) {
+        step_r[i] = _mm256_set1_epi64x(r4[i]);
+        last_r[i] = _mm256_setr_epi64x(r4[i], r3[i], r2[i], r[i]);
+        step_s[i] = _mm256_add_epi64(step_r[i], _mm256_slli_epi64(step_r[i], 2));
+        last_s[i] = _mm256_add_epi64(last_r[i], _mm256_slli_epi64(last_r[i], 2));
+        acc[i] = _mm256_setr_epi64x(h[i], 0, 0, 0);
+    }
+
+    const __m256i mask = _mm256_set1_epi64x(LIMB_MASK);
+    const __m256i hibit = _mm256_set1_epi64x(1 << 24);
+    for (size_t i = 0; i < blocks; i += 4, m += 64) {
+        const __m256i a = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m));
+        const __m256i b = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(m + 32));
+        // Split the blocks into their low and high 64 bits, in block order.
+        const __m256i lo = _mm256_permute4x64_epi64(_mm256_unpacklo_epi64(a, b), 0xd8);
+        const __m256i hi = _mm256_permute4x64_epi64(_mm256_unpackhi_epi64(a, b), 0xd8);
+
+        acc[0] = _mm256_add_epi64(acc[0], _mm256_and_si256(lo, mask));
+        acc[1] = _mm256_add_epi64(acc[1], _mm256_and_si256(_mm256_srli_epi64(lo, 26), mask));
+        acc[2] = _mm256_add_epi64(acc[2], _mm256_and_si256(_mm256_or_si256(_mm256_srli_epi64(lo, 52), _mm256_slli_epi64(hi, 12)), mask));
+        acc[3] = _mm256_add_epi64(acc[3], _mm256_and_si256(_mm256_srli_epi64(hi, 14), mask));
+        acc[4] = _mm256_add_epi64(acc[4], _mm256_or_si256(_mm256_srli_epi64(hi, 40), hibit));
+
+        if (i + 4 < blocks) {
+            MulLanes(acc, step_r, step_s);
+        } else {
+            MulLanes(acc, last_r, last_s);
+        }
+    }
+
+    uint64_t t[5];
+    for (int i = 0; i < 5; ++i) {
+        alignas(32) uint64_t lanes[4];
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc[i]);
+        t[i] = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+
+    uint64_t c;
+                 c = t[0] >> 26; t[0] &= LIMB_MASK;
+    t[1] += c;   c = t[1] >> 26; t[1] &= LIMB_MASK;
+    t[2] += c;   c = t[2] >> 26; t[2] &= LIMB_MASK;
+    t[3] += c;   c = t[3] >> 26; t[3] &= LIMB_MASK;
+    t[4] += c;   c = t[4] >> 26; t[4] &= LIMB_MASK;
+    t[0] += c * 5; c = t[0] >> 26; t[0] &= LIMB_MASK;
+    t[1] += c;
+    for (int i = 0; i < 5; ++i) h[i] = uint32_t(t[i]);
+
+    return blocks;
+}
+
+} // namespace poly1305_avx2
+
+#endif
@@ -37,6 +37,7 @@ void Transform_4way(unsigned char* out, const unsigned char* in);
 namespace sha256d64_avx2
 {
 void Transform_8way(unsigned char* out, const unsigned char* in);
+void TransformMulti_8way(uint32_t* s, const unsigned char* const* chunks);
 }
 
 namespace sha256d64_x86_shani
@@ -437,6 +438,7 @@ void TransformD64(unsigned char* out, const unsigned char* in)
 
 typedef void (*TransformType)(uint32_t*, const unsigned char*, size_t);
 typedef void (*TransformD64Type)(unsigned char*, const unsigned char*);
+typedef void (*TransformMultiType)(uint32_t*, const unsigned char* const*);
 
 template<TransformType tr>
 void TransformD64Wrapper(unsigned char* out, const unsigned char* in)
@@ -482,6 +484,7 @@ TransformD64Type TransformD64 = sha256::TransformD64;
 TransformD64Type TransformD64_2way = nullptr;
 TransformD64Type TransformD64_4way = nullptr;
 TransformD64Type TransformD64_8way = nullptr;
+TransformMultiType TransformMulti_8way = nullptr;
 
 bool SelfTest() {
     // Input state (equal to the initial SHA256 state)
@@ -565,20 +568,24 @@ bool SelfTest() {
         if (!std::equal(out, out + 256, result_d64)) return false;
     }
 
-    return true;
-}
+    // Test TransformMulti_8way, if available, on lanes at different offsets.
+    if (TransformMulti_8way) {
+        uint32_t state[64];
+        const unsigned char* chunks[8];
+        for (size_t lane = 0; lane < 8; ++lane) {
+            for (size_t i = 0; i < 8; ++i) state[8 * i + lane] = result[lane][i];
+            chunks[lane] = data + 1 + 64 * lane;
+        }
+        TransformMulti_8way(state, chunks);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            for (size_t i = 0; i < 8; ++i) {
+                if (state[8 * i + lane] != result[lane + 1][i]) return false;
+            }
+        }
+    }
 
-#if !defined(DISABLE_OPTIMIZED_SHA256)
-#if (defined(__x86_64__) || defined(__amd64__) || defined(__i386__))
-/** Check whether the OS has enabled AVX registers. */
-bool AVXEnabled()
-{
-    uint32_t a, d;
-    __asm__("xgetbv" : "=a"(a), "=d"(d) : "c"(0));
-    return (a & 6) == 6;
+    return true;
 }
-#endif
-#endif // DISABLE_OPTIMIZED_SHA256
 } // namespace
 
 
@@ -590,6 +597,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
     TransformD64_2way = nullptr;
     TransformD64_4way = nullptr;
     TransformD64_8way = nullptr;
+    TransformMulti_8way = nullptr;
 
 #if !defined(DISABLE_OPTIMIZED_SHA256)
 #if defined(HAVE_GETCPUID)
@@ -646,6 +654,7 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
 #if defined(ENABLE_AVX2)
     if (have_avx2 && have_avx && enabled_avx) {
         TransformD64_8way = sha256d64_avx2::Transform_8way;
+        TransformMulti_8way = sha256d64_avx2::TransformMulti_8way;
         ret += ",avx2(8way)";
     }
 #endif
@@ -779,3 +788,158 @@ void SHA256D64(unsigned char* out, const unsigned char* in, size_t blocks)
         --blocks;
     }
 }
+
+namespace {
+/** One lane of SHA256DMulti: the double-SHA256 of a single message in progress. */
+struct MultiLane
+{
+    //! Whether the lane is hashing a message, and the index of that message.
+    bool busy{false};
+    size_t index{0};
+    //! Whether the lane is computing the outer hash.
+    bool outer{false};
+    //! Full message blocks that remain to be processed.
+    const unsigned char* data{nullptr};
+    size_t blocks{0};
+    //! The padded final block(s), and how many of them remain.
+    unsigned char tail[128];
+    size_t tail_total{0};
+    size_t tail_blocks{0};
+
+    void Start(size_t i, std::span<const unsigned char> msg)
+    {
+        busy = true;
+        index = i;
+        outer = false;
+        data = msg.data();
+        blocks = msg.size() / 64;
+        const size_t rem = msg.size() % 64;
+        tail_total = rem + 9 <= 64 ? 1 : 2;
+        std::fill(tail, tail + 64 * tail_total, 0);
+        if (rem) std::memcpy(tail, data + 64 * blocks, rem);
+        tail[rem] = 0x80;
+        WriteBE64(tail + 64 * tail_total - 8, uint64_t{msg.size()} << 3);
+        tail_blocks = tail_total;
+    }
+
+    void StartOuter(const unsigned char inner[CSHA256::OUTPUT_SIZE])
+    {
+        outer = true;
+        blocks = 0;
+        std::memcpy(tail, inner, 32);
+        std::fill(tail + 32, tail + 64, 0);
+        tail[32] = 0x80;
+        WriteBE64(tail + 56, 256);
+        tail_total = tail_blocks = 1;
+    }
+
+    bool Done() const { return blocks == 0 && tail_blocks == 0; }
+
+    const unsigned char* Next()
+    {
+        if (blocks) {
+            --blocks;
+            data += 64;
+            return data - 64;
+        }
+        return tail + 64 * (tail_total - tail_blocks--);
+    }
+};
+
+void WriteState(unsigned char* out, const uint32_t* s)
+{
+    for (int i = 0; i < 8; ++i) WriteBE32(out + 4 * i, s[i]);
+}
+
+void SHA256DSingle(unsigned char* out, std::span<const unsigned char> in)
+{
+    unsigned char inner[CSHA256::OUTPUT_SIZE];
+    CSHA256().Write(in.data(), in.size()).Finalize(inner);
+    CSHA256().Write(inner, sizeof(inner)).Finalize(out);
+}
+} // namespace
+
+void SHA256DMulti(unsigned char* output, std::span<const std::span<const unsigned char>> inputs)
+{
+    // With fewer active lanes than this, finishing the remaining messages
+    // with the single-buffer transform is faster than running idle lanes.
+    static constexpr size_t MIN_ACTIVE_LANES = 3;
+
+    if (!TransformMulti_8way || inputs.size() < MIN_ACTIVE_LANES) {
+        for (const auto& in : inputs) {
+            SHA256DSingle(output, in);
+            output += CSHA256::OUTPUT_SIZE;
+        }
+        return;
+    }
+
+    static const uint32_t init[8] = {
+        0x6a09e667ul, 0xbb67ae85ul, 0x3c6ef372ul, 0xa54ff53aul, 0x510e527ful, 0x9b05688cul, 0x1f83d9abul, 0x5be0cd19ul
+    };
+    static const unsigned char idle_block[64] = {};
+
+    MultiLane lanes[8];
+    uint32_t state[64]; // word-major, see TransformMulti_8way
+    const unsigned char* chunks[8];
+    size_t next = 0;
+    size_t active = 0;
+
+    const auto reset_state = [&](size_t lane) {
+        for (size_t i = 0; i < 8; ++i) state[8 * i + lane] = init[i];
+    };
+    const auto read_state = [&](size_t lane, uint32_t* s) {
+        for (size_t i = 0; i < 8; ++i) s[i] = state[8 * i + lane];
+    };
+    for (size_t lane = 0; lane < 8 && next < inputs.size(); ++lane, ++next, ++active) {
+        lanes[lane].Start(next, inputs[next]);
+        reset_state(lane);
+    }
+
+    // Lanes are refilled as soon as they finish, so only the tail of the
+    // batch runs with idle lanes.
+    while (active >= MIN_ACTIVE_LANES) {
+        for (size_t lane = 0; lane < 8; ++lane) {
+            chunks[lane] = lanes[lane].busy ? lanes[lane].Next() : idle_block;
+        }
+        TransformMulti_8way(state, chunks);
+        for (size_t lane = 0; lane < 8; ++lane) {
+            MultiLane& l = lanes[lane];
+            if (!l.busy || !l.Done()) continue;
+            uint32_t s[8];
+            read_state(lane, s);
+            if (!l.outer) {
+                unsigned char inner[CSHA256::OUTPUT_SIZE];
+                WriteState(inner, s);
+                l.StartOuter(inner);
+                reset_state(lane);
+                continue;
+            }
+            WriteState(output + CSHA256::OUTPUT_SIZE * l.index, s);
+            if (next < inputs.size()) {
+                l.Start(next, inputs[next]);
+                reset_state(lane);
+                ++next;
+            } else {
+                l.busy = false;
+                --active;
+            }
+        }
+    }
+
+    // Finish the stragglers with the single-buffer transform.
+    for (size_t lane = 0; lane < 8; ++lane) {
+        MultiLane& l = lanes[lane];
+        if (!l.busy) continue;
+        uint32_t s[8];
+        read_state(lane, s);
+        if (l.blocks) Transform(s, l.data, l.blocks);
+        if (l.tail_blocks) Transform(s, l.tail + 64 * (l.tail_total - l.tail_blocks), l.tail_blocks);
+        if (!l.outer) {
+            unsigned char inner[CSHA256::OUTPUT_SIZE];
+            WriteState(inner, s);
+            CSHA256().Write(inner, sizeof(inner)).Finalize(output + CSHA256::OUTPUT_SIZE * l.index);
+        } else {
+            WriteState(output + CSHA256::OUTPUT_SIZE * l.index, s);
+        }
+    }
+}
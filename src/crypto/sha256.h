@@ -7,6 +7,7 @@
 
 #include <cstdint>
 #include <cstdlib>
+#include <span>
 #include <string>
 
 /** A hasher class for SHA-256. */
@@ -50,4 +51,12 @@ std::string SHA256AutoDetect(sha256_implementation::UseImplementation use_implem
  */
 void SHA256D64(unsigned char* output, const unsigned char* input, size_t blocks);
 
+/** Compute the double-SHA256 of multiple messages of arbitrary length.
+ *  output:  pointer to an inputs.size()*32 byte output buffer
+ *  inputs:  the messages to hash
+ *  Where the implementation supports it (AVX2), up to 8 messages are hashed
+ *  in parallel, so this is much faster than hashing them one by one.
+ */
+void SHA256DMulti(unsigned char* output, std::span<const std::span<const unsigned char>> inputs);
+
 #endif // BITCOIN_CRYPTO_SHA256_H
@@ -324,6 +324,65 @@ void Transform_8way(unsigned char* out, const unsigned char* in)
     Write8(out, 28, Add(h, K(0x5be0cd19ul)));
 }
 
+
+void TransformMulti_8way(uint32_t* s, const unsigned char* const* chunks)
+{
+    static const uint32_t ROUND_K[64] = {
+        0x428a2f98ul, 0x71374491ul, 0xb5c0fbcful, 0xe9b5dba5ul, 0x3956c25bul, 0x59f111f1ul, 0x923f82a4ul, 0xab1c5ed5ul,
+        0xd807aa98ul, 0x12835b01ul, 0x243185beul, 0x550c7dc3ul, 0x72be5d74ul, 0x80deb1feul, 0x9bdc06a7ul, 0xc19bf174ul,
+        0xe49b69c1ul, 0xefbe4786ul, 0x0fc19dc6ul, 0x240ca1ccul, 0x2de92c6ful, 0x4a7484aaul, 0x5cb0a9dcul, 0x76f988daul,
+        0x983e5152ul, 0xa831c66dul, 0xb00327c8ul, 0xbf597fc7ul, 0xc6e00bf3ul, 0xd5a79147ul, 0x06ca6351ul, 0x14292967ul,
+        0x27b70a85ul, 0x2e1b2138ul, 0x4d2c6dfcul, 0x53380d13ul, 0x650a7354ul, 0x766a0abbul, 0x81c2c92eul, 0x92722c85ul,
+        0xa2bfe8a1ul, 0xa81a664bul, 0xc24b8b70ul, 0xc76c51a3ul, 0xd192e819ul, 0xd6990624ul, 0xf40e3585ul, 0x106aa070ul,
+        0x19a4c116ul, 0x1e376c08ul, 0x2748774cul, 0x34b0bcb5ul, 0x391c0cb3ul, 0x4ed8aa4aul, 0x5b9cca4ful, 0x682e6ff3ul,
+        0x748f82eeul, 0x78a5636ful, 0x84c87814ul, 0x8cc70208ul, 0x90befffaul, 0xa4506cebul, 0xbef9a3f7ul, 0xc67178f2ul,
+    };
+
+    // The state is stored word-major: s[8 * i + lane] is word i of the state of lane.
+    __m256i* state = reinterpret_cast<__m256i*>(s);
+    __m256i a = _mm256_loadu_si256(state + 0);
+    __m256i b = _mm256_loadu_si256(state + 1);
+    __m256i c = _mm256_loadu_si256(state + 2);
+    __m256i d = _mm256_loadu_si256(state + 3);
+    __m256i e = _mm256_loadu_si256(state + 4);
+    __m256i f = _mm256_loadu_si256(state + 5);
+    __m256i g = _mm256_loadu_si256(state + 6);
+    __m256i h = _mm256_loadu_si256(state + 7);
+
+    __m256i w[16];
+    for (int i = 0; i < 16; ++i) {
+        w[i] = _mm256_set_epi32(
+            ReadBE32(chunks[7] + 4 * i), ReadBE32(chunks[6] + 4 * i), ReadBE32(chunks[5] + 4 * i), ReadBE32(chunks[4] + 4 * i),
+            ReadBE32(chunks[3] + 4 * i), ReadBE32(chunks[2] + 4 * i), ReadBE32(chunks[1] + 4 * i), ReadBE32(chunks[0] + 4 * i));
+    }
+
+    for (int i = 0; i < 64; i += 8) {
+        if (i >= 16) {
+            for (int j = 0; j < 8; ++j) {
+                const int n = i + j;
+                Inc(w[n & 15], sigma1(w[(n + 14) & 15]), w[(n + 9) & 15], sigma0(w[(n + 1) & 15]));
+            }
+        }
+        Round(a, b, c, d, e, f, g, h, Add(K(ROUND_K[i + 0]), w[(i + 0) & 15]));
+        Round(h, a, b, c, d, e, f, g, Add(K(ROUND_K[i + 1]), w[(i + 1) & 15]));
+        Round(g, h, a, b, c, d, e, f, Add(K(ROUND_K[i + 2]), w[(i + 2) & 15]));
+        Round(f, g, h, a, b, c, d, e, Add(K(ROUND_K[i + 3]), w[(i + 3) & 15]));
+        Round(e, f, g, h, a, b, c, d, Add(K(ROUND_K[i + 4]), w[(i + 4) & 15]));
+        Round(d, e, f, g, h, a, b, c, Add(K(ROUND_K[i + 5]), w[(i + 5) & 15]));
+        Round(c, d, e, f, g, h, a, b, Add(K(ROUND_K[i + 6]), w[(i + 6) & 15]));
+        Round(b, c, d, e, f, g, h, a, Add(K(ROUND_K[i + 7]), w[(i + 7) & 15]));
+    }
+
+    _mm256_storeu_si256(state + 0, Add(a, _mm256_loadu_si256(state + 0)));
+    _mm256_storeu_si256(state + 1, Add(b, _mm256_loadu_si256(state + 1)));
+    _mm256_storeu_si256(state + 2, Add(c, _mm256_loadu_si256(state + 2)));
+    _mm256_storeu_si256(state + 3, Add(d, _mm256_loadu_si256(state + 3)));
+    _mm256_storeu_si256(state + 4, Add(e, _mm256_loadu_si256(state + 4)));
+    _mm256_storeu_si256(state + 5, Add(f, _mm256_loadu_si256(state + 5)));
+    _mm256_storeu_si256(state + 6, Add(g, _mm256_loadu_si256(state + 6)));
+    _mm256_storeu_si256(state + 7, Add(h, _mm256_loadu_si256(state + 7)));
+}
+
 }
 
 #endif
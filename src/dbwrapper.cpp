@@ -389,6 +389,22 @@ CDBIterator* CDBWrapper::NewIterator()
     return new CDBIterator{*this, std::make_unique<CDBIterator::IteratorImpl>(DBContext().pdb->NewIterator(DBContext().iteroptions))};
 }
 
+std::vector<std::unique_ptr<CDBIterator>> CDBWrapper::NewIterators(size_t count)
+{
+    // Each iterator keeps the state it was created with alive, so the
+    // snapshot is only needed while creating them.
+    const leveldb::Snapshot* snapshot{DBContext().pdb->GetSnapshot()};
+    leveldb::ReadOptions options{DBContext().iteroptions};
+    options.snapshot = snapshot;
+    std::vector<std::unique_ptr<CDBIterator>> iterators;
+    iterators.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        iterators.push_back(std::make_unique<CDBIterator>(*this, std::make_unique<CDBIterator::IteratorImpl>(DBContext().pdb->NewIterator(options))));
+    }
+    DBContext().pdb->ReleaseSnapshot(snapshot);
+    return iterators;
+}
+
 void CDBIterator::SeekImpl(std::span<const std::byte> key)
 {
     leveldb::Slice slKey(CharCast(key.data()), key.size());
@@ -276,6 +276,9 @@ public:
 
     CDBIterator* NewIterator();
 
+    /** Create several iterators that all read the same state of the database. */
+    std::vector<std::unique_ptr<CDBIterator>> NewIterators(size_t count);
+
     /**
      * Return true if the database managed by this class contains no entries.
      */
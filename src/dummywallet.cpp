@@ -45,10 +45,12 @@ void DummyWalletInit::AddWalletOptions(ArgsManager& argsman) const
         "-wallet=<path>",
         "-walletbroadcast",
         "-walletdir=<dir>",
+        "-walletgroupcommit=<ms>",
         "-walletnotify=<cmd>",
         "-walletrbf",
         "-walletrejectlongchains",
         "-walletcrosschain",
+        "-walletwal",
         "-unsafesqlitesync",
     });
 }
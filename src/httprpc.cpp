@@ -9,6 +9,7 @@
 #include <httpserver.h>
 #include <logging.h>
 #include <netaddress.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/server.h>
 #include <util/fs.h>
@@ -97,6 +98,68 @@ static void JSONErrorReply(HTTPRequest* req, UniValue objError, const JSONRPCReq
     req->WriteReply(nStatus, strReply);
 }
 
+/** Streams the result of a single JSON-RPC request to the client as a
+ * chunked HTTP reply, for RPC methods that support it.
+ */
+class HTTPResultStream final : public JSONRPCResultStream
+{
+public:
+    HTTPResultStream(HTTPRequest& req, const JSONRPCRequest& jreq) : m_req{req}, m_jreq{jreq} {}
+
+    JSONStreamWriter& Start() override
+    {
+        assert(!m_writer);
+        m_req.WriteHeader("Content-Type", "application/json");
+        m_req.StartChunkedReply(HTTP_OK);
+        m_writer.emplace([this](std::string_view chunk) {
+            if (!m_req.WriteReplyChunk(std::as_bytes(std::span{chunk}))) {
+                throw std::runtime_error("connection closed");
+            }
+        });
+        m_writer->BeginObject();
+        if (m_jreq.m_json_version == JSONRPCVersion::V2) m_writer->KeyValue("jsonrpc", "2.0");
+        m_writer->Key("result");
+        return *m_writer;
+    }
+
+    bool Started() const override { return m_writer.has_value(); }
+
+    /** Complete the reply, given what JSONRPCExec returned.  Returns false
+     * if the reply had to be aborted instead.  */
+    bool Finish(const UniValue& reply)
+    {
+        if (!reply.find_value("error").isNull()) {
+            return Abort();
+        }
+        try {
+            if (m_jreq.m_json_version == JSONRPCVersion::V1_LEGACY) m_writer->KeyValue("error", NullUniValue);
+            if (m_jreq.id.has_value()) m_writer->KeyValue("id", *m_jreq.id);
+            m_writer->EndObject();
+            m_writer->Flush();
+        } catch (const std::exception&) {
+            return Abort();
+        }
+        const std::string_view newline{"\n"};
+        m_req.WriteReplyChunk(std::as_bytes(std::span{newline}));
+        m_req.EndChunkedReply();
+        return true;
+    }
+
+    /** End the reply after an error that can no longer be reported.  The
+     * client is left with truncated JSON.  */
+    bool Abort()
+    {
+        LogPrintf("RPC %s failed after its result was partially sent, aborting reply\n", m_jreq.strMethod);
+        m_req.EndChunkedReply();
+        return false;
+    }
+
+private:
+    HTTPRequest& m_req;
+    const JSONRPCRequest& m_jreq;
+    std::optional<JSONStreamWriter> m_writer;
+};
+
 //This function checks username and password against -rpcauth
 //entries from config file.
 static bool CheckUserAuthorized(std::string_view user, std::string_view pass)
@@ -171,6 +234,9 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
         return false;
     }
 
+    // The request and reply JSON only live until the reply is written.
+    UniValue::Arena arena;
+
     try {
         // Parse request
         UniValue valRequest;
@@ -201,7 +267,17 @@ static bool HTTPReq_JSONRPC(const std::any& context, HTTPRequest* req)
             // 2.0 behavior is to catch exceptions and return HTTP success with
             // RPC errors, as long as there is not an actual HTTP server error.
             const bool catch_errors{jreq.m_json_version == JSONRPCVersion::V2};
-            reply = JSONRPCExec(jreq, catch_errors);
+            HTTPResultStream stream{*req, jreq};
+            if (!jreq.IsNotification()) jreq.m_result_stream = &stream;
+            try {
+                reply = JSONRPCExec(jreq, catch_errors);
+            } catch (...) {
+                jreq.m_result_stream = nullptr;
+                if (!stream.Started()) throw;
+                return stream.Abort();
+            }
+            jreq.m_result_stream = nullptr;
+            if (stream.Started()) return stream.Finish(reply);
 
             if (jreq.IsNotification()) {
                 // Even though we do execute notifications, we do not respond to them
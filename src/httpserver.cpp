@@ -48,6 +48,8 @@ using common::InvalidPortErrMsg;
 
 /** Maximum size of http request (request line + headers) */
 static const size_t MAX_HEADERS_SIZE = 8192;
+/** Maximum size of a chunked reply that may be queued but not yet sent */
+static const size_t MAX_CHUNKED_REPLY_QUEUED = 1 << 20;
 
 /** HTTP request work item */
 class HTTPWorkItem final : public HTTPClosure
@@ -260,6 +262,12 @@ std::string RequestMethodString(HTTPRequest::RequestMethod m)
     assert(false);
 }
 
+/** Callback for when a connection is closed, to stop tracking its requests */
+static void http_connection_close_cb(struct evhttp_connection* conn, void* arg)
+{
+    g_requests.RemoveConnection(conn);
+}
+
 /** HTTP request callback */
 static void http_request_cb(struct evhttp_request* req, void* arg)
 {
@@ -270,9 +278,7 @@ static void http_request_cb(struct evhttp_request* req, void* arg)
         evhttp_request_set_on_complete_cb(req, [](struct evhttp_request* req, void*) {
             g_requests.RemoveRequest(req);
         }, nullptr);
-        evhttp_connection_set_closecb(conn, [](evhttp_connection* conn, void* arg) {
-            g_requests.RemoveConnection(conn);
-        }, nullptr);
+        evhttp_connection_set_closecb(conn, http_connection_close_cb, nullptr);
     }
 
     // Disable reading to work around a libevent bug, fixed in 2.1.9
@@ -593,6 +599,47 @@ void HTTPEvent::trigger(struct timeval* tv)
     else
         evtimer_add(ev, tv); // trigger after timeval passed
 }
+/** State of a chunked reply, shared between the worker thread producing
+ * the reply and the main http thread sending it.
+ */
+struct HTTPChunkedReply
+{
+    Mutex mutex;
+    std::condition_variable cv;
+    //! Bytes of the body queued by the worker thread
+    uint64_t queued GUARDED_BY(mutex){0};
+    //! Bytes of the body handed to libevent by the main thread
+    uint64_t handed GUARDED_BY(mutex){0};
+    //! Bytes of the body written to the connection
+    uint64_t written GUARDED_BY(mutex){0};
+    //! Whether the connection was closed before the reply ended
+    bool closed GUARDED_BY(mutex){false};
+};
+
+/** Callback for when all handed-over chunks have been written */
+static void http_chunk_written_cb(struct evhttp_connection* conn, void* arg)
+{
+    auto& state{*static_cast<HTTPChunkedReply*>(arg)};
+    LOCK(state.mutex);
+    state.written = state.handed;
+    state.cv.notify_all();
+}
+
+/** Callback for when the connection of a chunked reply is closed. It
+ * replaces http_connection_close_cb while the reply is sent. */
+static void http_chunked_close_cb(struct evhttp_connection* conn, void* arg)
+{
+    auto& state{*static_cast<HTTPChunkedReply*>(arg)};
+    {
+        LOCK(state.mutex);
+        state.closed = true;
+        state.cv.notify_all();
+    }
+    // libevent detaches the unfinished request from the connection, so its
+    // completion callback will not run.
+    http_connection_close_cb(conn, nullptr);
+}
+
 HTTPRequest::HTTPRequest(struct evhttp_request* _req, const util::SignalInterrupt& interrupt, bool _replySent)
     : req(_req), m_interrupt(interrupt), replySent(_replySent)
 {
@@ -600,7 +647,10 @@ HTTPRequest::HTTPRequest(struct evhttp_request* _req, const util::SignalInterrup
 
 HTTPRequest::~HTTPRequest()
 {
-    if (!replySent) {
+    if (!replySent && m_chunked) {
+        LogPrintf("%s: Unfinished chunked reply\n", __func__);
+        EndChunkedReply();
+    } else if (!replySent) {
         // Keep track of whether reply was sent to avoid request leaks
         LogPrintf("%s: Unhandled request\n", __func__);
         WriteReply(HTTP_INTERNAL_SERVER_ERROR, "Unhandled request");
@@ -653,7 +703,7 @@ void HTTPRequest::WriteHeader(const std::string& hdr, const std::string& value)
  */
 void HTTPRequest::WriteReply(int nStatus, std::span<const std::byte> reply)
 {
-    assert(!replySent && req);
+    assert(!replySent && req && !m_chunked);
     if (m_interrupt) {
         WriteHeader("Connection", "close");
     }
@@ -681,6 +731,81 @@ void HTTPRequest::WriteReply(int nStatus, std::span<const std::byte> reply)
     req = nullptr; // transferred back to main thread
 }
 
+void HTTPRequest::StartChunkedReply(int nStatus)
+{
+    assert(!replySent && req && !m_chunked);
+    if (m_interrupt) {
+        WriteHeader("Connection", "close");
+    }
+    m_chunked = std::make_shared<HTTPChunkedReply>();
+    auto req_copy = req;
+    auto state = m_chunked;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, state, nStatus]{
+        // Notice if the client goes away, so the worker can stop producing
+        // the reply.  The request itself stays valid until the reply ends.
+        evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            evhttp_connection_set_closecb(conn, http_chunked_close_cb, state.get());
+        }
+        evhttp_send_reply_start(req_copy, nStatus, nullptr);
+    });
+    ev->trigger(nullptr);
+}
+
+bool HTTPRequest::WriteReplyChunk(std::span<const std::byte> chunk)
+{
+    assert(!replySent && req && m_chunked);
+    auto state = m_chunked;
+    {
+        WAIT_LOCK(state->mutex, lock);
+        while (!state->closed && state->queued - state->written > MAX_CHUNKED_REPLY_QUEUED) {
+            if (m_interrupt) return false;
+            state->cv.wait_for(lock, std::chrono::seconds{1});
+        }
+        if (state->closed) return false;
+        state->queued += chunk.size();
+    }
+    // An empty chunk would end the reply.
+    if (chunk.empty()) return true;
+
+    struct evbuffer* evb = evbuffer_new();
+    assert(evb);
+    evbuffer_add(evb, chunk.data(), chunk.size());
+    auto req_copy = req;
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, state, evb]{
+        WITH_LOCK(state->mutex, state->handed += evbuffer_get_length(evb));
+        evhttp_send_reply_chunk_with_cb(req_copy, evb, http_chunk_written_cb, state.get());
+        evbuffer_free(evb);
+    });
+    ev->trigger(nullptr);
+    return true;
+}
+
+void HTTPRequest::EndChunkedReply()
+{
+    assert(!replySent && req && m_chunked);
+    auto req_copy = req;
+    auto state = std::move(m_chunked);
+    HTTPEvent* ev = new HTTPEvent(eventBase, true, [req_copy, state]{
+        evhttp_connection* conn = evhttp_request_get_connection(req_copy);
+        if (conn) {
+            evhttp_connection_set_closecb(conn, http_connection_close_cb, nullptr);
+        }
+        // This also frees the request if the connection is already gone.
+        evhttp_send_reply_end(req_copy);
+        // Re-enable reading from the socket, as in WriteReply.
+        if (conn && event_get_version_number() >= 0x02010600 && event_get_version_number() < 0x02010900) {
+            bufferevent* bev = evhttp_connection_get_bufferevent(conn);
+            if (bev) {
+                bufferevent_enable(bev, EV_READ | EV_WRITE);
+            }
+        }
+    });
+    ev->trigger(nullptr);
+    replySent = true;
+    req = nullptr; // transferred back to main thread
+}
+
 CService HTTPRequest::GetPeer() const
 {
     evhttp_connection* con = evhttp_request_get_connection(req);
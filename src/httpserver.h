@@ -6,6 +6,7 @@
 #define BITCOIN_HTTPSERVER_H
 
 #include <functional>
+#include <memory>
 #include <optional>
 #include <span>
 #include <string>
@@ -31,6 +32,7 @@ struct evhttp_request;
 struct event_base;
 class CService;
 class HTTPRequest;
+struct HTTPChunkedReply;
 
 /** Initialize HTTP server.
  * Call this before RegisterHTTPHandler or EventBase().
@@ -73,6 +75,8 @@ private:
     struct evhttp_request* req;
     const util::SignalInterrupt& m_interrupt;
     bool replySent;
+    //! State of the chunked reply, if one was started
+    std::shared_ptr<HTTPChunkedReply> m_chunked;
 
 public:
     explicit HTTPRequest(struct evhttp_request* req, const util::SignalInterrupt& interrupt, bool replySent = false);
@@ -143,6 +147,32 @@ public:
         WriteReply(nStatus, std::as_bytes(std::span{reply}));
     }
     void WriteReply(int nStatus, std::span<const std::byte> reply);
+
+    /**
+     * Start a reply whose body is sent in chunks, as it is produced.
+     * nStatus is the HTTP status code to send.
+     *
+     * @note call this instead of WriteReply, and then WriteReplyChunk for
+     * the body and EndChunkedReply when it is complete.
+     */
+    void StartChunkedReply(int nStatus);
+
+    /**
+     * Send the next part of a chunked reply's body.  This waits while too
+     * much of the body is still queued for sending, so that a slow client
+     * limits how fast the body is produced.
+     *
+     * @returns false if the client connection is gone or the server is
+     * shutting down, in which case the reply should be ended right away.
+     */
+    bool WriteReplyChunk(std::span<const std::byte> chunk);
+
+    /**
+     * End a chunked reply.  As with WriteReply, the request is given back to
+     * the main thread, so do not call any other HTTPRequest methods after
+     * calling this.
+     */
+    void EndChunkedReply();
 };
 
 /** Get the query parameter value from request uri for a specified key, or std::nullopt if the key
@@ -5,6 +5,7 @@
 #include <chainparams.h>
 #include <common/args.h>
 #include <index/base.h>
+#include <index/synccoordinator.h>
 #include <interfaces/chain.h>
 #include <kernel/chain.h>
 #include <logging.h>
@@ -95,7 +96,9 @@ bool BaseIndex::Init()
         return &m_chain->context()->chainman->GetChainstateForIndexing());
     // Register to validation interface before setting the 'm_synced' flag, so that
     // callbacks are not missed once m_synced is true.
-    m_chain->context()->validation_signals->RegisterValidationInterface(this);
+    // The indexes share a queue, so that writing them does not hold up the
+    // other subscribers.
+    m_chain->context()->validation_signals->RegisterValidationInterface(this, "index");
 
     CBlockLocator locator;
     if (!GetDB().ReadBestBlock(locator)) {
@@ -149,7 +152,7 @@ static const CBlockIndex* NextSyncBlock(const CBlockIndex* pindex_prev, CChain&
     return chain.Next(chain.FindFork(pindex_prev));
 }
 
-bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data)
+bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data, const CBlockUndo* undo_data)
 {
     interfaces::BlockInfo block_info = kernel::MakeBlockInfo(pindex, block_data);
 
@@ -164,7 +167,9 @@ bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data
     }
 
     CBlockUndo block_undo;
-    if (CustomOptions().connect_undo_data) {
+    if (CustomOptions().connect_undo_data && undo_data) {
+        block_info.undo_data = undo_data;
+    } else if (CustomOptions().connect_undo_data) {
         if (pindex->nHeight > 0 && !m_chainstate->m_blockman.ReadBlockUndo(block_undo, *pindex)) {
             FatalErrorf("%s: Failed to read undo block data %s from disk",
                         __func__, pindex->GetBlockHash().ToString());
@@ -184,8 +189,27 @@ bool BaseIndex::ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data
 
 void BaseIndex::Sync()
 {
+    if (!CustomUpgrade(m_interrupt)) {
+        FatalErrorf("%s: Failed to upgrade the %s database", __func__, GetName());
+        return;
+    }
+
     const CBlockIndex* pindex = m_best_block_index.load();
     if (!m_synced) {
+        // Share block reads with other indexes syncing at the same time, if
+        // a coordinator was set up for them.
+        std::shared_ptr<IndexSyncCoordinator> coordinator{std::exchange(m_sync_coordinator, nullptr)};
+        if (!coordinator) coordinator = std::make_shared<IndexSyncCoordinator>(m_chainstate->m_blockman);
+        IndexSyncCoordinator::AppendFn parallel_append;
+        if (AllowParallelAppend()) {
+            parallel_append = [this](const interfaces::BlockInfo& block) { return CustomAppend(block); };
+        }
+        IndexSyncCoordinator::PrepareFn parallel_prepare;
+        if (AllowParallelPrepare()) {
+            parallel_prepare = [this](const interfaces::BlockInfo& block) { CustomPrepare(block); };
+        }
+        const auto registration{coordinator->Register(*this, pindex ? pindex->nHeight + 1 : 0, CustomOptions().connect_undo_data, std::move(parallel_append), std::move(parallel_prepare))};
+
         std::chrono::steady_clock::time_point last_log_time{0s};
         std::chrono::steady_clock::time_point last_locator_write_time{0s};
         while (true) {
@@ -197,6 +221,7 @@ void BaseIndex::Sync()
                 // logged. The best way to recover is to continue, as index cannot be corrupted by
                 // a missed commit to disk for an advanced index state.
                 Commit();
+                CustomDiscardPrepared();
                 return;
             }
 
@@ -226,8 +251,21 @@ void BaseIndex::Sync()
             }
             pindex = pindex_next;
 
-
-            if (!ProcessBlock(pindex)) return; // error logged internally
+            const IndexSyncCoordinator::Result result{coordinator->Next(*this, pindex, m_chainstate->m_chain)};
+            if (!result.read_ok) {
+                FatalErrorf("%s: Failed to read block %s from disk",
+                            __func__, pindex->GetBlockHash().ToString());
+                return;
+            }
+            if (result.append_ok) {
+                if (!*result.append_ok) {
+                    FatalErrorf("%s: Failed to write block %s to index database",
+                                __func__, pindex->GetBlockHash().ToString());
+                    return;
+                }
+            } else if (!ProcessBlock(pindex, result.block.get(), result.undo.get())) {
+                return; // error logged internally
+            }
 
             auto current_time{std::chrono::steady_clock::now()};
             if (last_log_time + SYNC_LOG_INTERVAL < current_time) {
@@ -243,6 +281,7 @@ void BaseIndex::Sync()
                 Commit();
             }
         }
+        CustomDiscardPrepared();
     }
 
     if (pindex) {
@@ -442,6 +481,7 @@ bool BaseIndex::BlockUntilSyncedToCurrentChain() const
 void BaseIndex::Interrupt()
 {
     m_interrupt();
+    CustomDiscardPrepared();
 }
 
 bool BaseIndex::StartBackgroundSync()
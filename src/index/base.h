@@ -12,11 +12,14 @@
 #include <util/threadinterrupt.h>
 #include <validationinterface.h>
 
+#include <memory>
 #include <string>
 
 class CBlock;
 class CBlockIndex;
+class CBlockUndo;
 class Chainstate;
+class IndexSyncCoordinator;
 class ChainstateManager;
 namespace interfaces {
 class Chain;
@@ -80,6 +83,9 @@ private:
     std::thread m_thread_sync;
     CThreadInterrupt m_interrupt;
 
+    /// Coordinator shared with other indexes for the initial sync, if any.
+    std::shared_ptr<IndexSyncCoordinator> m_sync_coordinator;
+
     /// Write the current index state (eg. chain block locator and subclass-specific items) to disk.
     ///
     /// Recommendations for error handling:
@@ -93,10 +99,19 @@ private:
     /// Loop over disconnected blocks and call CustomRemove.
     bool Rewind(const CBlockIndex* current_tip, const CBlockIndex* new_tip);
 
-    bool ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data = nullptr);
+    bool ProcessBlock(const CBlockIndex* pindex, const CBlock* block_data = nullptr, const CBlockUndo* undo_data = nullptr);
 
     virtual bool AllowPrune() const = 0;
 
+    /// Whether CustomAppend only depends on the block passed to it and not on
+    /// blocks appended before, so that the initial sync may append blocks in
+    /// parallel and out of order. The best block still only advances in order.
+    virtual bool AllowParallelAppend() const { return false; }
+
+    /// Whether CustomPrepare should be called for upcoming blocks on worker
+    /// threads during the initial sync.
+    virtual bool AllowParallelPrepare() const { return false; }
+
     template <typename... Args>
     void FatalErrorf(util::ConstevalFormatString<sizeof...(Args)> fmt, const Args&... args);
 
@@ -115,9 +130,23 @@ protected:
     /// Initialize internal state from the database and block index.
     [[nodiscard]] virtual bool CustomInit(const std::optional<interfaces::BlockRef>& block) { return true; }
 
+    /// Bring the database up to date on the sync thread, before the initial
+    /// sync and without holding cs_main. Slow upgrades should return early
+    /// once `interrupt` is set and continue on the next start.
+    [[nodiscard]] virtual bool CustomUpgrade(const CThreadInterrupt& interrupt) { return true; }
+
     /// Write update index entries for a newly connected block.
     [[nodiscard]] virtual bool CustomAppend(const interfaces::BlockInfo& block) { return true; }
 
+    /// Precompute data for a later CustomAppend of the block, which may run
+    /// concurrently with CustomAppend of earlier blocks. CustomAppend must
+    /// still work if this was not called for the block.
+    virtual void CustomPrepare(const interfaces::BlockInfo& block) {}
+
+    /// Drop data from CustomPrepare that was not used by CustomAppend yet.
+    /// Called when the initial sync ends or is interrupted.
+    virtual void CustomDiscardPrepared() {}
+
     /// Virtual method called internally by Commit that can be overridden to atomically
     /// commit more index state.
     virtual bool CustomCommit(CDBBatch& batch) { return true; }
@@ -151,6 +180,10 @@ public:
     /// validation interface so that it stays in sync with blockchain updates.
     [[nodiscard]] bool Init();
 
+    /// Share the block reads of the initial sync with other indexes using the
+    /// same coordinator. Must be called before StartBackgroundSync.
+    void SetSyncCoordinator(std::shared_ptr<IndexSyncCoordinator> coordinator) { m_sync_coordinator = std::move(coordinator); }
+
     /// Starts the initial sync process on a background thread.
     [[nodiscard]] bool StartBackgroundSync();
 
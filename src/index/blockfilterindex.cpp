@@ -9,6 +9,7 @@
 #include <dbwrapper.h>
 #include <hash.h>
 #include <index/blockfilterindex.h>
+#include <index/synccoordinator.h>
 #include <logging.h>
 #include <node/blockstorage.h>
 #include <undo.h>
@@ -143,6 +144,7 @@ bool BlockFilterIndex::CustomInit(const std::optional<interfaces::BlockRef>& blo
         }
         m_last_header = *op_last_header;
     }
+    WITH_LOCK(m_cs_prepared_filters, m_prepared_window_start = block ? block->height + 1 : 0);
 
     return true;
 }
@@ -254,9 +256,39 @@ std::optional<uint256> BlockFilterIndex::ReadFilterHeader(int height, const uint
     return read_out.second.header;
 }
 
-bool BlockFilterIndex::CustomAppend(const interfaces::BlockInfo& block)
+bool BlockFilterIndex::InPreparedWindow(int height) const
 {
+    return height >= m_prepared_window_start && height <= m_prepared_window_start + IndexSyncCoordinator::READ_AHEAD;
+}
+
+void BlockFilterIndex::CustomPrepare(const interfaces::BlockInfo& block)
+{
+    // Blocks outside the read window would not be appended soon, if at all
+    if (!WITH_LOCK(m_cs_prepared_filters, return InPreparedWindow(block.height))) return;
     BlockFilter filter(m_filter_type, *Assert(block.data), *Assert(block.undo_data));
+    LOCK(m_cs_prepared_filters);
+    if (InPreparedWindow(block.height)) {
+        m_prepared_filters.insert_or_assign(block.hash, std::pair{block.height, std::move(filter)});
+    }
+}
+
+void BlockFilterIndex::CustomDiscardPrepared()
+{
+    LOCK(m_cs_prepared_filters);
+    m_prepared_filters.clear();
+}
+
+bool BlockFilterIndex::CustomAppend(const interfaces::BlockInfo& block)
+{
+    std::optional<BlockFilter> prepared;
+    {
+        LOCK(m_cs_prepared_filters);
+        if (auto node{m_prepared_filters.extract(block.hash)}) prepared = std::move(node.mapped().second);
+        // Anything prepared up to this height is for blocks of another chain
+        m_prepared_window_start = block.height + 1;
+        std::erase_if(m_prepared_filters, [&](const auto& entry) { return entry.second.first < m_prepared_window_start; });
+    }
+    const BlockFilter filter{prepared ? std::move(*prepared) : BlockFilter(m_filter_type, *Assert(block.data), *Assert(block.undo_data))};
     const uint256& header = filter.ComputeHeader(m_last_header);
     bool res = Write(filter, block.height, header);
     if (res) m_last_header = header; // update last header
@@ -307,6 +339,13 @@ bool BlockFilterIndex::Write(const BlockFilter& filter, uint32_t block_height, c
 
 bool BlockFilterIndex::CustomRemove(const interfaces::BlockInfo& block)
 {
+    // Filters prepared for blocks of the abandoned chain will not be used
+    {
+        LOCK(m_cs_prepared_filters);
+        m_prepared_filters.clear();
+        m_prepared_window_start = block.height;
+    }
+
     CDBBatch batch(*m_db);
     std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
 
@@ -13,6 +13,7 @@
 #include <util/hasher.h>
 
 #include <unordered_map>
+#include <utility>
 
 static const char* const DEFAULT_BLOCKFILTERINDEX = "0";
 
@@ -45,7 +46,16 @@ private:
     // Last computed header to avoid disk reads on every new block.
     uint256 m_last_header{};
 
+    Mutex m_cs_prepared_filters;
+    /** Filters built on worker threads ahead of CustomAppend during the initial sync, with their height. */
+    std::unordered_map<uint256, std::pair<int, BlockFilter>, FilterHeaderHasher> m_prepared_filters GUARDED_BY(m_cs_prepared_filters);
+    /** Height of the block appended next. Only blocks in the sync read window from there are prepared. */
+    int m_prepared_window_start GUARDED_BY(m_cs_prepared_filters){0};
+
+    bool InPreparedWindow(int height) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_prepared_filters);
+
     bool AllowPrune() const override { return true; }
+    bool AllowParallelPrepare() const override { return true; }
 
     bool Write(const BlockFilter& filter, uint32_t block_height, const uint256& filter_header);
 
@@ -54,13 +64,17 @@ private:
 protected:
     interfaces::Chain::NotifyOptions CustomOptions() override;
 
-    bool CustomInit(const std::optional<interfaces::BlockRef>& block) override;
+    bool CustomInit(const std::optional<interfaces::BlockRef>& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_filters);
 
     bool CustomCommit(CDBBatch& batch) override;
 
-    bool CustomAppend(const interfaces::BlockInfo& block) override;
+    void CustomPrepare(const interfaces::BlockInfo& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_filters);
+
+    bool CustomAppend(const interfaces::BlockInfo& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_filters);
+
+    bool CustomRemove(const interfaces::BlockInfo& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_filters);
 
-    bool CustomRemove(const interfaces::BlockInfo& block) override;
+    void CustomDiscardPrepared() override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_filters);
 
     BaseIndex::DB& GetDB() const LIFETIMEBOUND override { return *m_db; }
 
@@ -7,6 +7,7 @@
 #include <common/args.h>
 #include <crypto/muhash.h>
 #include <index/coinstatsindex.h>
+#include <index/synccoordinator.h>
 #include <kernel/coinstats.h>
 #include <logging.h>
 #include <node/blockstorage.h>
@@ -113,6 +114,29 @@ void AddCoinValueToTotals (const Coin& coin, const int sign,
   totalNames = *names;
 }
 
+/** Change of the UTXO set hash by a block: its spendable outputs over the coins it spends. */
+MuHash3072 BlockMuHash(const interfaces::BlockInfo& block)
+{
+    MuHash3072 muhash;
+    for (size_t i = 0; i < Assert(block.data)->vtx.size(); ++i) {
+        const auto& tx{block.data->vtx.at(i)};
+
+        for (uint32_t j = 0; j < tx->vout.size(); ++j) {
+            const Coin coin{tx->vout[j], block.height, tx->IsCoinBase()};
+            if (coin.out.scriptPubKey.IsUnspendable()) continue;
+            ApplyCoinHash(muhash, COutPoint{tx->GetHash(), j}, coin);
+        }
+
+        if (!tx->IsCoinBase()) {
+            const auto& tx_undo{Assert(block.undo_data)->vtxundo.at(i - 1)};
+            for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
+                RemoveCoinHash(muhash, tx->vin[j].prevout, tx_undo.vprevout[j]);
+            }
+        }
+    }
+    return muhash;
+}
+
 }; // namespace
 
 std::unique_ptr<CoinStatsIndex> g_coin_stats_index;
@@ -126,6 +150,28 @@ CoinStatsIndex::CoinStatsIndex(std::unique_ptr<interfaces::Chain> chain, size_t
     m_db = std::make_unique<CoinStatsIndex::DB>(path / "db", n_cache_size, f_memory, f_wipe);
 }
 
+bool CoinStatsIndex::InPreparedWindow(int height) const
+{
+    return height >= m_prepared_window_start && height <= m_prepared_window_start + IndexSyncCoordinator::READ_AHEAD;
+}
+
+void CoinStatsIndex::CustomPrepare(const interfaces::BlockInfo& block)
+{
+    // Blocks outside the read window would not be appended soon, if at all
+    if (!WITH_LOCK(m_cs_prepared_muhash, return InPreparedWindow(block.height))) return;
+    MuHash3072 muhash{BlockMuHash(block)};
+    LOCK(m_cs_prepared_muhash);
+    if (InPreparedWindow(block.height)) {
+        m_prepared_muhash.insert_or_assign(block.hash, std::pair{block.height, std::move(muhash)});
+    }
+}
+
+void CoinStatsIndex::CustomDiscardPrepared()
+{
+    LOCK(m_cs_prepared_muhash);
+    m_prepared_muhash.clear();
+}
+
 bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
 {
     CAmount block_subsidy;
@@ -156,6 +202,17 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
         }
         }
 
+        // Use the set hash change if it was computed ahead of time
+        std::optional<MuHash3072> prepared;
+        {
+            LOCK(m_cs_prepared_muhash);
+            if (auto node{m_prepared_muhash.extract(block.hash)}) prepared = std::move(node.mapped().second);
+            // Anything prepared up to this height is for blocks of another chain
+            m_prepared_window_start = block.height + 1;
+            std::erase_if(m_prepared_muhash, [&](const auto& entry) { return entry.second.first < m_prepared_window_start; });
+        }
+        m_muhash *= prepared ? *prepared : BlockMuHash(block);
+
         // Add the new utxos created from the block
         assert(block.data);
         for (size_t i = 0; i < block.data->vtx.size(); ++i) {
@@ -164,7 +221,6 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
             for (uint32_t j = 0; j < tx->vout.size(); ++j) {
                 const CTxOut& out{tx->vout[j]};
                 Coin coin{out, block.height, tx->IsCoinBase()};
-                COutPoint outpoint{tx->GetHash(), j};
 
                 // Skip unspendable coins
                 if (coin.out.scriptPubKey.IsUnspendable()) {
@@ -173,8 +229,6 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
                     continue;
                 }
 
-                ApplyCoinHash(m_muhash, outpoint, coin);
-
                 if (tx->IsCoinBase()) {
                     m_total_coinbase_amount += coin.out.nValue;
                 } else {
@@ -192,9 +246,6 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
 
                 for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
                     Coin coin{tx_undo.vprevout[j]};
-                    COutPoint outpoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n};
-
-                    RemoveCoinHash(m_muhash, outpoint, coin);
 
                     m_total_prevout_spent_amount += coin.out.nValue;
 
@@ -273,6 +324,13 @@ bool CoinStatsIndex::CustomAppend(const interfaces::BlockInfo& block)
 
 bool CoinStatsIndex::CustomRemove(const interfaces::BlockInfo& block)
 {
+    // Set hash changes prepared for blocks of the abandoned chain will not be used
+    {
+        LOCK(m_cs_prepared_muhash);
+        m_prepared_muhash.clear();
+        m_prepared_window_start = block.height;
+    }
+
     CDBBatch batch(*m_db);
     std::unique_ptr<CDBIterator> db_it(m_db->NewIterator());
 
@@ -381,6 +439,7 @@ bool CoinStatsIndex::CustomInit(const std::optional<interfaces::BlockRef>& block
         m_total_unspendables_scripts = entry.total_unspendables_scripts;
         m_total_unspendables_unclaimed_rewards = entry.total_unspendables_unclaimed_rewards;
     }
+    WITH_LOCK(m_cs_prepared_muhash, m_prepared_window_start = block ? block->height + 1 : 0);
 
     return true;
 }
@@ -432,12 +491,12 @@ bool CoinStatsIndex::ReverseBlock(const interfaces::BlockInfo& block)
     // Remove the new UTXOs that were created from the block
     assert(block.data);
     assert(block.undo_data);
+    m_muhash /= BlockMuHash(block);
     for (size_t i = 0; i < block.data->vtx.size(); ++i) {
         const auto& tx{block.data->vtx.at(i)};
 
         for (uint32_t j = 0; j < tx->vout.size(); ++j) {
             const CTxOut& out{tx->vout[j]};
-            COutPoint outpoint{tx->GetHash(), j};
             Coin coin{out, block.height, tx->IsCoinBase()};
 
             // Skip unspendable coins
@@ -447,8 +506,6 @@ bool CoinStatsIndex::ReverseBlock(const interfaces::BlockInfo& block)
                 continue;
             }
 
-            RemoveCoinHash(m_muhash, outpoint, coin);
-
             if (tx->IsCoinBase()) {
                 m_total_coinbase_amount -= coin.out.nValue;
             } else {
@@ -466,9 +523,6 @@ bool CoinStatsIndex::ReverseBlock(const interfaces::BlockInfo& block)
 
             for (size_t j = 0; j < tx_undo.vprevout.size(); ++j) {
                 Coin coin{tx_undo.vprevout[j]};
-                COutPoint outpoint{tx->vin[j].prevout.hash, tx->vin[j].prevout.n};
-
-                ApplyCoinHash(m_muhash, outpoint, coin);
 
                 m_total_prevout_spent_amount -= coin.out.nValue;
 
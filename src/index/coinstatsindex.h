@@ -7,6 +7,11 @@
 
 #include <crypto/muhash.h>
 #include <index/base.h>
+#include <sync.h>
+#include <util/hasher.h>
+
+#include <unordered_map>
+#include <utility>
 
 class CBlockIndex;
 class CDBBatch;
@@ -39,20 +44,33 @@ private:
     CAmount m_total_unspendables_scripts{0};
     CAmount m_total_unspendables_unclaimed_rewards{0};
 
+    Mutex m_cs_prepared_muhash;
+    /** Set hash changes of blocks computed on worker threads ahead of CustomAppend during the initial sync, with their height. */
+    std::unordered_map<uint256, std::pair<int, MuHash3072>, BlockHasher> m_prepared_muhash GUARDED_BY(m_cs_prepared_muhash);
+    /** Height of the block appended next. Only blocks in the sync read window from there are prepared. */
+    int m_prepared_window_start GUARDED_BY(m_cs_prepared_muhash){0};
+
+    bool InPreparedWindow(int height) const EXCLUSIVE_LOCKS_REQUIRED(m_cs_prepared_muhash);
+
     [[nodiscard]] bool ReverseBlock(const interfaces::BlockInfo& block);
 
     bool AllowPrune() const override { return true; }
+    bool AllowParallelPrepare() const override { return true; }
 
 protected:
     interfaces::Chain::NotifyOptions CustomOptions() override;
 
-    bool CustomInit(const std::optional<interfaces::BlockRef>& block) override;
+    bool CustomInit(const std::optional<interfaces::BlockRef>& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_muhash);
 
     bool CustomCommit(CDBBatch& batch) override;
 
-    bool CustomAppend(const interfaces::BlockInfo& block) override;
+    void CustomPrepare(const interfaces::BlockInfo& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_muhash);
+
+    bool CustomAppend(const interfaces::BlockInfo& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_muhash);
+
+    bool CustomRemove(const interfaces::BlockInfo& block) override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_muhash);
 
-    bool CustomRemove(const interfaces::BlockInfo& block) override;
+    void CustomDiscardPrepared() override EXCLUSIVE_LOCKS_REQUIRED(!m_cs_prepared_muhash);
 
     BaseIndex::DB& GetDB() const override { return *m_db; }
 
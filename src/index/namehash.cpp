@@ -62,13 +62,13 @@ NameHashIndex::CustomAppend (const interfaces::BlockInfo& block)
   for (const auto& tx : block.data->vtx)
     for (const auto& out : tx->vout)
       {
-        const CNameScript nameOp(out.scriptPubKey);
+        const NameScriptView nameOp(out.scriptPubKey);
         if (!nameOp.isNameOp () || nameOp.getNameOp () != OP_NAME_REGISTER)
           continue;
 
-        const valtype& name = nameOp.getOpName ();
+        const auto name = nameOp.getOpName ();
         const uint256 hash = Hash (name);
-        data.emplace_back (hash, name);
+        data.emplace_back (hash, valtype (name.begin (), name.end ()));
       }
 
   return db->WritePreimages (data);
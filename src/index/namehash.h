@@ -39,6 +39,7 @@ private:
   const std::unique_ptr<DB> db;
 
   bool AllowPrune() const override { return false; }
+  bool AllowParallelAppend () const override { return true; }
 
 protected:
 
@@ -0,0 +1,246 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <index/synccoordinator.h>
+
+#include <chain.h>
+#include <kernel/chain.h>
+#include <logging.h>
+#include <node/blockstorage.h>
+#include <primitives/block.h>
+#include <serialize.h>
+#include <tinyformat.h>
+#include <undo.h>
+#include <util/thread.h>
+
+#include <algorithm>
+#include <limits>
+
+//! Maximum number of threads reading blocks for syncing indexes
+constexpr unsigned int MAX_SYNC_READ_THREADS{4};
+
+struct IndexSyncCoordinator::Job {
+    explicit Job(const CBlockIndex* index_in) : index(index_in) {}
+
+    const CBlockIndex* const index;
+    bool claimed{false};
+    bool done{false};
+
+    //! The fields below are written by the worker that claimed the job and read once it is done
+    bool read_ok{false};
+    bool undo_read{false};
+    std::shared_ptr<const CBlock> block;
+    std::shared_ptr<const CBlockUndo> undo;
+    std::map<const BaseIndex*, bool> appended;
+};
+
+IndexSyncCoordinator::IndexSyncCoordinator(node::BlockManager& blockman)
+    : m_blockman(blockman)
+{
+    const unsigned int threads{std::clamp(std::thread::hardware_concurrency(), 1U, MAX_SYNC_READ_THREADS)};
+    for (unsigned int n = 0; n < threads; ++n) {
+        m_workers.emplace_back(&util::TraceThread, strprintf("idxread.%i", n), [this] { ThreadRead(); });
+    }
+}
+
+IndexSyncCoordinator::~IndexSyncCoordinator()
+{
+    WITH_LOCK(m_mutex, m_stop = true);
+    m_work_cv.notify_all();
+    for (auto& worker : m_workers) worker.join();
+
+    if (m_blocks_read > 0) {
+        LogPrintf("Index sync read %d blocks (%.2f MB) from disk\n", m_blocks_read.load(), m_bytes_read / (1000.0 * 1000.0));
+    }
+}
+
+IndexSyncCoordinator::Registration IndexSyncCoordinator::Register(const BaseIndex& consumer, int next_height, bool read_undo, AppendFn append, PrepareFn prepare)
+{
+    LOCK(m_mutex);
+    m_consumers.emplace(&consumer, Consumer{read_undo, std::move(append), std::move(prepare), next_height});
+    return {*this, consumer};
+}
+
+void IndexSyncCoordinator::Unregister(const BaseIndex& consumer)
+{
+    WAIT_LOCK(m_mutex, lock);
+    // Workers may still be running callbacks of the consumer, which must not
+    // be destroyed before they are done.
+    m_done_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_consumers.at(&consumer).callbacks_running == 0; });
+    m_consumers.erase(&consumer);
+    EvictJobs();
+    m_done_cv.notify_all();
+}
+
+int IndexSyncCoordinator::MinNextHeight() const
+{
+    int min_height{std::numeric_limits<int>::max()};
+    for (const auto& [_, consumer] : m_consumers) min_height = std::min(min_height, consumer.next_height);
+    return min_height;
+}
+
+void IndexSyncCoordinator::EvictJobs()
+{
+    const int min_height{MinNextHeight()};
+    while (!m_jobs.empty() && m_jobs.begin()->first < min_height) m_jobs.erase(m_jobs.begin());
+}
+
+bool IndexSyncCoordinator::ReadData(const CBlockIndex& index, bool read_block, bool read_undo, std::shared_ptr<const CBlock>& block, std::shared_ptr<const CBlockUndo>& undo)
+{
+    uint64_t bytes{0};
+    if (read_block) {
+        auto new_block{std::make_shared<CBlock>()};
+        if (!m_blockman.ReadBlock(*new_block, index)) return false;
+        bytes += ::GetSerializeSize(TX_WITH_WITNESS(*new_block));
+        block = std::move(new_block);
+        ++m_blocks_read;
+    }
+    if (read_undo) {
+        auto new_undo{std::make_shared<CBlockUndo>()};
+        if (index.nHeight > 0) {
+            if (!m_blockman.ReadBlockUndo(*new_undo, index)) return false;
+            bytes += ::GetSerializeSize(*new_undo);
+        }
+        undo = std::move(new_undo);
+    }
+    m_bytes_read += bytes;
+    return true;
+}
+
+IndexSyncCoordinator::Result IndexSyncCoordinator::Next(const BaseIndex& consumer, const CBlockIndex* pindex, const CChain& chain)
+{
+    const int height{pindex->nHeight};
+    WAIT_LOCK(m_mutex, lock);
+    Consumer& state{m_consumers.at(&consumer)};
+    state.next_height = height;
+    EvictJobs();
+    m_done_cv.notify_all();
+
+    // Blocks of the read window are shared by the consumers inside it. A
+    // consumer at the end of the window waits for the slowest one, while one
+    // that is far ahead reads its own blocks instead of waiting for a
+    // consumer that may need a long time to catch up.
+    m_done_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+        const int lead{height - MinNextHeight()};
+        return lead < READ_AHEAD || lead >= MAX_LEAD;
+    });
+    const int window_start{MinNextHeight()};
+    const bool in_window{height < window_start + READ_AHEAD};
+
+    // Queue the heights of the read window that are not queued yet
+    std::vector<int> missing;
+    if (in_window) {
+        for (int h = window_start; h < window_start + READ_AHEAD; ++h) {
+            if (!m_jobs.contains(h)) missing.push_back(h);
+        }
+    }
+    if (!missing.empty()) {
+        std::vector<const CBlockIndex*> new_blocks;
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            LOCK(::cs_main);
+            for (const int h : missing) {
+                if (const CBlockIndex* block{chain[h]}) new_blocks.push_back(block);
+            }
+        }
+        for (const CBlockIndex* block : new_blocks) {
+            if (block->nHeight >= MinNextHeight()) m_jobs.try_emplace(block->nHeight, std::make_shared<Job>(block));
+        }
+    }
+
+    Result result;
+    std::shared_ptr<Job> job;
+    if (auto it{m_jobs.find(height)}; in_window && it != m_jobs.end()) {
+        // The queued block may be stale after a reorg
+        if (it->second->index != pindex) it->second = std::make_shared<Job>(pindex);
+        job = it->second;
+    }
+    m_work_cv.notify_all();
+
+    if (job) {
+        m_done_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return job->done; });
+        result.read_ok = job->read_ok;
+        result.block = job->block;
+        if (state.read_undo && job->undo_read) result.undo = job->undo;
+        if (const auto it{job->appended.find(&consumer)}; it != job->appended.end()) result.append_ok = it->second;
+    }
+    state.next_height = height + 1;
+    EvictJobs();
+    m_done_cv.notify_all();
+
+    // Read the data ourselves if the block was not queued (it is outside the
+    // read window or no longer in the chain), or if nobody needed its undo
+    // data when it was read.
+    const bool read_block{!job};
+    const bool read_undo{state.read_undo && !result.undo && (read_block || result.read_ok)};
+    if (read_block || read_undo) {
+        REVERSE_LOCK(lock, m_mutex);
+        result.read_ok = ReadData(*pindex, read_block, read_undo, result.block, result.undo);
+    }
+    return result;
+}
+
+void IndexSyncCoordinator::ThreadRead()
+{
+    WAIT_LOCK(m_mutex, lock);
+    while (true) {
+        std::shared_ptr<Job> job;
+        m_work_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+            if (m_stop) return true;
+            for (const auto& [_, queued] : m_jobs) {
+                if (!queued->claimed) {
+                    job = queued;
+                    return true;
+                }
+            }
+            return false;
+        });
+        if (m_stop) return;
+
+        // Serve all consumers that have yet to reach this block
+        job->claimed = true;
+        const int height{job->index->nHeight};
+        bool read_undo{false};
+        std::vector<std::pair<const BaseIndex*, AppendFn>> appends;
+        std::vector<std::pair<const BaseIndex*, PrepareFn>> prepares;
+        for (auto& [consumer, state] : m_consumers) {
+            if (state.next_height > height) continue;
+            read_undo |= state.read_undo;
+            if (state.append) {
+                appends.emplace_back(consumer, state.append);
+                ++state.callbacks_running;
+            } else if (state.prepare) {
+                prepares.emplace_back(consumer, state.prepare);
+                ++state.callbacks_running;
+            }
+        }
+
+        std::map<const BaseIndex*, bool> appended;
+        bool read_ok;
+        std::shared_ptr<const CBlock> block;
+        std::shared_ptr<const CBlockUndo> undo;
+        {
+            REVERSE_LOCK(lock, m_mutex);
+            read_ok = ReadData(*job->index, /*read_block=*/true, read_undo, block, undo);
+            if (read_ok) {
+                interfaces::BlockInfo block_info{kernel::MakeBlockInfo(job->index, block.get())};
+                block_info.undo_data = undo.get();
+                for (const auto& [consumer, append] : appends) {
+                    appended.emplace(consumer, append(block_info));
+                }
+                for (const auto& [_, prepare] : prepares) prepare(block_info);
+            }
+        }
+
+        for (const auto& [consumer, _] : appends) --m_consumers.at(consumer).callbacks_running;
+        for (const auto& [consumer, _] : prepares) --m_consumers.at(consumer).callbacks_running;
+        job->read_ok = read_ok;
+        job->undo_read = read_undo;
+        job->block = std::move(block);
+        job->undo = std::move(undo);
+        job->appended = std::move(appended);
+        job->done = true;
+        m_done_cv.notify_all();
+    }
+}
@@ -0,0 +1,141 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_INDEX_SYNCCOORDINATOR_H
+#define BITCOIN_INDEX_SYNCCOORDINATOR_H
+
+#include <interfaces/chain.h>
+#include <kernel/cs_main.h>
+#include <sync.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <thread>
+#include <vector>
+
+class BaseIndex;
+class CBlock;
+class CBlockIndex;
+class CBlockUndo;
+class CChain;
+namespace node {
+class BlockManager;
+} // namespace node
+
+/**
+ * Reads blocks and undo data once for all indexes catching up with the chain.
+ *
+ * Each syncing index registers as a consumer and requests blocks in chain
+ * order. Worker threads read a window of blocks starting at the position of
+ * the slowest consumer, so every block in it is read from disk only once for
+ * all consumers inside the window. A consumer that reaches the end of the
+ * window waits for the slowest one to catch up, so faster indexes do not read
+ * the chain again on their own. Only a consumer that is at least MAX_LEAD
+ * blocks ahead, e.g. because it was registered with a much higher starting
+ * height, reads its blocks itself instead of waiting.
+ *
+ * A consumer may pass an append function if its entries depend only on the
+ * block itself. Workers then append blocks for it as soon as they are read,
+ * so such indexes are built in parallel. Other consumers may pass a prepare
+ * function to precompute data for their in-order append on the workers.
+ * Results are still handed out in chain order, so every index advances its
+ * best block in order.
+ */
+class IndexSyncCoordinator
+{
+public:
+    using AppendFn = std::function<bool(const interfaces::BlockInfo&)>;
+    using PrepareFn = std::function<void(const interfaces::BlockInfo&)>;
+
+    //! Number of blocks read ahead of the slowest syncing index
+    static constexpr int READ_AHEAD{32};
+    //! Lead over the slowest syncing index from which a consumer no longer waits for it
+    static constexpr int MAX_LEAD{2 * READ_AHEAD};
+
+    struct Result {
+        bool read_ok{false};
+        //! Set if a worker appended the block on behalf of the consumer
+        std::optional<bool> append_ok;
+        std::shared_ptr<const CBlock> block;
+        //! Null if the consumer did not ask for undo data
+        std::shared_ptr<const CBlockUndo> undo;
+    };
+
+    /** Unregisters the consumer when it goes out of scope. */
+    class Registration
+    {
+    public:
+        Registration(IndexSyncCoordinator& coordinator, const BaseIndex& consumer)
+            : m_coordinator(coordinator), m_consumer(consumer) {}
+        ~Registration() { m_coordinator.Unregister(m_consumer); }
+        Registration(const Registration&) = delete;
+        Registration& operator=(const Registration&) = delete;
+
+    private:
+        IndexSyncCoordinator& m_coordinator;
+        const BaseIndex& m_consumer;
+    };
+
+    explicit IndexSyncCoordinator(node::BlockManager& blockman);
+    ~IndexSyncCoordinator();
+
+    /**
+     * Register a consumer that will request blocks starting at next_height,
+     * so that the blocks it needs are kept until it gets to them.
+     */
+    [[nodiscard]] Registration Register(const BaseIndex& consumer, int next_height, bool read_undo, AppendFn append, PrepareFn prepare = nullptr) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+
+    /**
+     * Return the data of pindex, the block in `chain` the consumer processes
+     * next. If the block is past the read window, wait until the slowest
+     * consumer catches up, unless the consumer is at least MAX_LEAD blocks
+     * ahead, in which case the data is read from disk directly.
+     */
+    Result Next(const BaseIndex& consumer, const CBlockIndex* pindex, const CChain& chain) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex, !::cs_main);
+
+    //! Number of blocks read from disk so far
+    uint64_t GetBlocksRead() const { return m_blocks_read; }
+    //! Serialized size of the block and undo data read from disk so far
+    uint64_t GetBytesRead() const { return m_bytes_read; }
+
+private:
+    struct Job;
+    struct Consumer {
+        bool read_undo;
+        AppendFn append;
+        PrepareFn prepare;
+        //! Height of the block the consumer requests next
+        int next_height;
+        //! Appends or preparations running on worker threads for this consumer
+        int callbacks_running{0};
+    };
+
+    node::BlockManager& m_blockman;
+
+    Mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+    std::map<const BaseIndex*, Consumer> m_consumers GUARDED_BY(m_mutex);
+    //! Blocks in the read window by height
+    std::map<int, std::shared_ptr<Job>> m_jobs GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_workers;
+
+    std::atomic<uint64_t> m_blocks_read{0};
+    std::atomic<uint64_t> m_bytes_read{0};
+
+    void Unregister(const BaseIndex& consumer) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+    int MinNextHeight() const EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+    /** Drop blocks that all consumers are past. */
+    void EvictJobs() EXCLUSIVE_LOCKS_REQUIRED(m_mutex);
+    bool ReadData(const CBlockIndex& index, bool read_block, bool read_undo, std::shared_ptr<const CBlock>& block, std::shared_ptr<const CBlockUndo>& undo);
+    void ThreadRead() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex);
+};
+
+#endif // BITCOIN_INDEX_SYNCCOORDINATOR_H
@@ -9,51 +9,338 @@
 #include <index/disktxpos.h>
 #include <logging.h>
 #include <node/blockstorage.h>
+#include <util/time.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+
 constexpr uint8_t DB_TXINDEX{'t'};
 
+/*
+ * Keys of the compact format are [DB_TXINDEX_COMPACT, txid prefix, height] for
+ * transactions and [DB_TXINDEX_BLOCK, height] for the block positions. The
+ * presence of DB_TXINDEX_FORMAT marks an index in the compact format.
+ */
+constexpr uint8_t DB_TXINDEX_COMPACT{'c'};
+constexpr uint8_t DB_TXINDEX_BLOCK{'p'};
+constexpr uint8_t DB_TXINDEX_FORMAT{'F'};
+
+constexpr uint8_t TXINDEX_FORMAT_COMPACT{1};
+
+/*
+ * While an index in the full format is converted to the compact format,
+ * DB_TXINDEX_MIGRATION holds the height of the next block to convert. New
+ * entries are written in the compact format during that time, and lookups
+ * check both formats.
+ */
+constexpr uint8_t DB_TXINDEX_MIGRATION{'M'};
+
+/** Number of entries converted or dropped per batch when migrating to the compact format. */
+constexpr size_t MIGRATION_BATCH_SIZE{10000};
+constexpr auto MIGRATION_LOG_INTERVAL{30s};
+
 std::unique_ptr<TxIndex> g_txindex;
 
+namespace {
+
+struct CompactTxKey {
+    uint64_t txid_prefix;
+    uint32_t height;
+
+    CompactTxKey(const uint256& txid, uint32_t height_in) : txid_prefix(txid.GetUint64(0)), height(height_in) {}
+
+    template<typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_TXINDEX_COMPACT);
+        ser_writedata64(s, txid_prefix);
+        ser_writedata32be(s, height);
+    }
+
+    template<typename Stream>
+    void Unserialize(Stream& s)
+    {
+        const uint8_t prefix{ser_readdata8(s)};
+        if (prefix != DB_TXINDEX_COMPACT) {
+            throw std::ios_base::failure("Invalid format for compact txindex DB key");
+        }
+        txid_prefix = ser_readdata64(s);
+        height = ser_readdata32be(s);
+    }
+};
+
+struct CompactTxVal {
+    unsigned int tx_offset;
+
+    SERIALIZE_METHODS(CompactTxVal, obj) { READWRITE(VARINT(obj.tx_offset)); }
+};
+
+struct CompactBlockKey {
+    uint32_t height;
+
+    explicit CompactBlockKey(uint32_t height_in) : height(height_in) {}
+
+    template<typename Stream>
+    void Serialize(Stream& s) const
+    {
+        ser_writedata8(s, DB_TXINDEX_BLOCK);
+        ser_writedata32be(s, height);
+    }
+};
+
+} // namespace
 
 /** Access to the txindex database (indexes/txindex/) */
 class TxIndex::DB : public BaseIndex::DB
 {
+private:
+    bool m_compact;
+    std::atomic<bool> m_migrating;
+
 public:
     explicit DB(size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
 
+    /// Open the database, wiping it if it is in the compact format but the
+    /// full format is requested.
+    static std::unique_ptr<DB> Open(size_t n_cache_size, bool f_memory, bool f_wipe, bool compact);
+
+    /// Whether new entries are stored in the compact format.
+    bool IsCompact() const { return m_compact; }
+
+    /// Whether existing entries are still being converted to the compact
+    /// format, so that some of them are in the full format.
+    bool IsMigrating() const { return m_migrating; }
+
     /// Read the disk location of the transaction data with the given hash. Returns false if the
     /// transaction hash is not indexed.
     bool ReadTxPos(const uint256& txid, CDiskTxPos& pos) const;
 
-    /// Write a batch of transaction positions to the DB.
-    [[nodiscard]] bool WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos);
+    /// Read the disk locations of all transactions in the compact format
+    /// whose truncated txid matches, highest blocks first.
+    std::vector<CDiskTxPos> ReadCompactTxPos(const uint256& txid) const;
+
+    /// Write a batch of transaction positions of the block at the given height to the DB.
+    [[nodiscard]] bool WriteTxs(int height, const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos);
+
+    /// Erase the compact format entries of a disconnected block. The entries
+    /// would otherwise point into the block stored next at the same height.
+    [[nodiscard]] bool EraseCompactTxs(int height, const CBlock& block);
+
+    /// Height of the next block to convert to the compact format.
+    int ReadMigrationHeight() const;
+
+    /// Add the conversion of the entries of a block to the compact format to
+    /// the batch, and return the number of converted entries.
+    size_t MigrateBlock(CDBBatch& batch, int height, const CBlock& block, const FlatFilePos& block_pos) const;
+
+    /// Record the height of the next block to convert in the batch.
+    void WriteMigrationHeight(CDBBatch& batch, int height);
+
+    /// Drop the entries left in the full format, which belong to blocks that
+    /// are not in the active chain, and mark the migration as done. Returns
+    /// early if interrupted.
+    [[nodiscard]] bool FinishMigration(const CThreadInterrupt& interrupt);
 };
 
 TxIndex::DB::DB(size_t n_cache_size, bool f_memory, bool f_wipe) :
-    BaseIndex::DB(gArgs.GetDataDirNet() / "indexes" / "txindex", n_cache_size, f_memory, f_wipe)
+    BaseIndex::DB(gArgs.GetDataDirNet() / "indexes" / "txindex", n_cache_size, f_memory, f_wipe),
+    m_compact(Exists(DB_TXINDEX_FORMAT) || Exists(DB_TXINDEX_MIGRATION)),
+    m_migrating(Exists(DB_TXINDEX_MIGRATION))
 {}
 
+std::unique_ptr<TxIndex::DB> TxIndex::DB::Open(size_t n_cache_size, bool f_memory, bool f_wipe, bool compact)
+{
+    auto db{std::make_unique<DB>(n_cache_size, f_memory, f_wipe)};
+    if (db->IsCompact() && !compact) {
+        // The full txids cannot be recovered from the compact format.
+        LogPrintf("txindex is in the compact format, rebuilding it in the full format\n");
+        db.reset();
+        db = std::make_unique<DB>(n_cache_size, f_memory, /*f_wipe=*/true);
+    } else if (!db->IsCompact() && compact) {
+        // An existing index is converted on the sync thread, while a new one
+        // can use the compact format right away.
+        CBlockLocator locator;
+        if (db->ReadBestBlock(locator) && !locator.IsNull()) {
+            LogPrintf("txindex will be converted to the compact format\n");
+            db->Write(DB_TXINDEX_MIGRATION, 0, /*fSync=*/true);
+            db->m_migrating = true;
+        } else {
+            db->Write(DB_TXINDEX_FORMAT, TXINDEX_FORMAT_COMPACT, /*fSync=*/true);
+        }
+        db->m_compact = true;
+    }
+    return db;
+}
+
 bool TxIndex::DB::ReadTxPos(const uint256 &txid, CDiskTxPos& pos) const
 {
     return Read(std::make_pair(DB_TXINDEX, txid), pos);
 }
 
-bool TxIndex::DB::WriteTxs(const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos)
+std::vector<CDiskTxPos> TxIndex::DB::ReadCompactTxPos(const uint256& txid) const
+{
+    std::vector<CDiskTxPos> result;
+    std::unique_ptr<CDBIterator> db_it(const_cast<DB&>(*this).NewIterator());
+    CompactTxKey key(txid, 0);
+    const uint64_t txid_prefix{key.txid_prefix};
+    for (db_it->Seek(key); db_it->Valid(); db_it->Next()) {
+        if (!db_it->GetKey(key) || key.txid_prefix != txid_prefix) break;
+        CompactTxVal value;
+        FlatFilePos block_pos;
+        if (!db_it->GetValue(value) || !Read(CompactBlockKey(key.height), block_pos)) {
+            LogError("%s: Cannot read compact txindex entry at height %d\n", __func__, key.height);
+            continue;
+        }
+        result.emplace_back(block_pos, value.tx_offset);
+    }
+    std::reverse(result.begin(), result.end());
+    return result;
+}
+
+bool TxIndex::DB::WriteTxs(int height, const std::vector<std::pair<uint256, CDiskTxPos>>& v_pos)
+{
+    CDBBatch batch(*this);
+    if (m_compact) {
+        if (!v_pos.empty()) {
+            batch.Write(CompactBlockKey(height), FlatFilePos{v_pos.front().second.nFile, v_pos.front().second.nPos});
+        }
+        for (const auto& [txid, pos] : v_pos) {
+            batch.Write(CompactTxKey(txid, height), CompactTxVal{pos.nTxOffset});
+        }
+    } else {
+        for (const auto& tuple : v_pos) {
+            batch.Write(std::make_pair(DB_TXINDEX, tuple.first), tuple.second);
+        }
+    }
+    return WriteBatch(batch);
+}
+
+bool TxIndex::DB::EraseCompactTxs(int height, const CBlock& block)
 {
     CDBBatch batch(*this);
-    for (const auto& tuple : v_pos) {
-        batch.Write(std::make_pair(DB_TXINDEX, tuple.first), tuple.second);
+    batch.Erase(CompactBlockKey(height));
+    for (const auto& tx : block.vtx) {
+        batch.Erase(CompactTxKey(tx->GetHash(), height));
     }
     return WriteBatch(batch);
 }
 
-TxIndex::TxIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe)
-    : BaseIndex(std::move(chain), "txindex"), m_db(std::make_unique<TxIndex::DB>(n_cache_size, f_memory, f_wipe))
+int TxIndex::DB::ReadMigrationHeight() const
+{
+    int height{0};
+    Read(DB_TXINDEX_MIGRATION, height);
+    return height;
+}
+
+size_t TxIndex::DB::MigrateBlock(CDBBatch& batch, int height, const CBlock& block, const FlatFilePos& block_pos) const
+{
+    size_t converted{0};
+    for (const auto& tx : block.vtx) {
+        // Skip transactions whose entry points to another block, which
+        // happens for duplicate txids (BIP30).
+        CDiskTxPos pos;
+        if (!ReadTxPos(tx->GetHash(), pos) || pos.nFile != block_pos.nFile || pos.nPos != block_pos.nPos) continue;
+        batch.Erase(std::make_pair(DB_TXINDEX, tx->GetHash()));
+        batch.Write(CompactTxKey(tx->GetHash(), height), CompactTxVal{pos.nTxOffset});
+        ++converted;
+    }
+    if (converted > 0) batch.Write(CompactBlockKey(height), block_pos);
+    return converted;
+}
+
+void TxIndex::DB::WriteMigrationHeight(CDBBatch& batch, int height)
+{
+    batch.Write(DB_TXINDEX_MIGRATION, height);
+}
+
+bool TxIndex::DB::FinishMigration(const CThreadInterrupt& interrupt)
+{
+    std::unique_ptr<CDBIterator> db_it(NewIterator());
+    db_it->Seek(std::make_pair(DB_TXINDEX, uint256()));
+
+    size_t dropped{0};
+    while (true) {
+        if (interrupt) return true;
+        CDBBatch batch(*this);
+        size_t batch_count{0};
+        for (; db_it->Valid() && batch_count < MIGRATION_BATCH_SIZE; db_it->Next(), ++batch_count) {
+            std::pair<uint8_t, uint256> key;
+            if (!db_it->GetKey(key) || key.first != DB_TXINDEX) break;
+            batch.Erase(key);
+        }
+        dropped += batch_count;
+        if (batch_count == 0) break;
+        if (!WriteBatch(batch)) return false;
+        if (batch_count < MIGRATION_BATCH_SIZE) break;
+    }
+
+    CDBBatch batch(*this);
+    batch.Erase(DB_TXINDEX_MIGRATION);
+    batch.Write(DB_TXINDEX_FORMAT, TXINDEX_FORMAT_COMPACT);
+    if (!WriteBatch(batch, /*fSync=*/true)) return false;
+    m_migrating = false;
+    LogPrintf("Converted txindex to the compact format (%d entries of stale blocks dropped)\n", dropped);
+    return true;
+}
+
+TxIndex::TxIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory, bool f_wipe, bool compact)
+    : BaseIndex(std::move(chain), "txindex"), m_db(TxIndex::DB::Open(n_cache_size, f_memory, f_wipe, compact))
 {}
 
 TxIndex::~TxIndex() = default;
 
+interfaces::Chain::NotifyOptions TxIndex::CustomOptions()
+{
+    interfaces::Chain::NotifyOptions options;
+    options.disconnect_data = m_db->IsCompact();
+    return options;
+}
+
+bool TxIndex::CustomUpgrade(const CThreadInterrupt& interrupt)
+{
+    if (!m_db->IsMigrating()) return true;
+
+    // Blocks appended after the best block at this point already use the
+    // compact format. Blocks that are no longer in the active chain are
+    // not converted and their entries dropped in the end.
+    int height{m_db->ReadMigrationHeight()};
+    const int end_height{GetSummary().best_block_height};
+    LogPrintf("Converting txindex to the compact format from height %d to %d\n", height, end_height);
+
+    auto last_log_time{std::chrono::steady_clock::now()};
+    CDBBatch batch(*m_db);
+    size_t batch_count{0};
+    while (height <= end_height && !interrupt) {
+        const CBlockIndex* pindex{WITH_LOCK(::cs_main, return m_chainstate->m_chain[height])};
+        if (!pindex) break;
+        CBlock block;
+        if (!m_chainstate->m_blockman.ReadBlock(block, *pindex)) {
+            LogError("%s: Failed to read block %s from disk\n", __func__, pindex->GetBlockHash().ToString());
+            return false;
+        }
+        batch_count += m_db->MigrateBlock(batch, height, block, pindex->GetBlockPos());
+        ++height;
+
+        if (batch_count >= MIGRATION_BATCH_SIZE) {
+            m_db->WriteMigrationHeight(batch, height);
+            if (!m_db->WriteBatch(batch)) return false;
+            batch.Clear();
+            batch_count = 0;
+
+            if (const auto current_time{std::chrono::steady_clock::now()}; last_log_time + MIGRATION_LOG_INTERVAL < current_time) {
+                LogPrintf("Converting txindex to the compact format at height %d\n", height);
+                last_log_time = current_time;
+            }
+        }
+    }
+    m_db->WriteMigrationHeight(batch, height);
+    if (!m_db->WriteBatch(batch)) return false;
+
+    return interrupt || m_db->FinishMigration(interrupt);
+}
+
 bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
 {
     // Exclude genesis block transaction because outputs are not spendable.
@@ -67,19 +354,24 @@ bool TxIndex::CustomAppend(const interfaces::BlockInfo& block)
         vPos.emplace_back(tx->GetHash(), pos);
         pos.nTxOffset += ::GetSerializeSize(TX_WITH_WITNESS(*tx));
     }
-    return m_db->WriteTxs(vPos);
+    return m_db->WriteTxs(block.height, vPos);
+}
+
+bool TxIndex::CustomRemove(const interfaces::BlockInfo& block)
+{
+    // Entries in the full format store the whole position, so they still
+    // point at the disconnected block.
+    if (!m_db->IsCompact() || block.height == 0) return true;
+
+    assert(block.data);
+    return m_db->EraseCompactTxs(block.height, *block.data);
 }
 
 BaseIndex::DB& TxIndex::GetDB() const { return *m_db; }
 
-bool TxIndex::FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRef& tx) const
+bool TxIndex::ReadTxFromDisk(const CDiskTxPos& pos, uint256& block_hash, CTransactionRef& tx) const
 {
-    CDiskTxPos postx;
-    if (!m_db->ReadTxPos(tx_hash, postx)) {
-        return false;
-    }
-
-    AutoFile file{m_chainstate->m_blockman.OpenBlockFile(postx, true)};
+    AutoFile file{m_chainstate->m_blockman.OpenBlockFile(pos, true)};
     if (file.IsNull()) {
         LogError("%s: OpenBlockFile failed\n", __func__);
         return false;
@@ -87,16 +379,45 @@ bool TxIndex::FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRe
     CBlockHeader header;
     try {
         file >> header;
-        file.seek(postx.nTxOffset, SEEK_CUR);
+        file.seek(pos.nTxOffset, SEEK_CUR);
         file >> TX_WITH_WITNESS(tx);
     } catch (const std::exception& e) {
         LogError("%s: Deserialize or I/O error - %s\n", __func__, e.what());
         return false;
     }
-    if (tx->GetHash() != tx_hash) {
-        LogError("%s: txid mismatch\n", __func__);
-        return false;
-    }
     block_hash = header.GetHash();
     return true;
 }
+
+bool TxIndex::FindTx(const uint256& tx_hash, uint256& block_hash, CTransactionRef& tx) const
+{
+    // Entries that are not converted to the compact format yet are looked up
+    // first, so that a conversion in the meantime is seen below.
+    CDiskTxPos postx;
+    if ((!m_db->IsCompact() || m_db->IsMigrating()) && m_db->ReadTxPos(tx_hash, postx)) {
+        uint256 tx_block_hash;
+        if (!ReadTxFromDisk(postx, tx_block_hash, tx)) {
+            return false;
+        }
+        if (tx->GetHash() != tx_hash) {
+            LogError("%s: txid mismatch\n", __func__);
+            return false;
+        }
+        block_hash = tx_block_hash;
+        return true;
+    }
+
+    if (m_db->IsCompact()) {
+        // Other transactions may share the truncated txid
+        for (const CDiskTxPos& candidate_pos : m_db->ReadCompactTxPos(tx_hash)) {
+            uint256 candidate_block_hash;
+            CTransactionRef candidate;
+            if (ReadTxFromDisk(candidate_pos, candidate_block_hash, candidate) && candidate->GetHash() == tx_hash) {
+                block_hash = candidate_block_hash;
+                tx = std::move(candidate);
+                return true;
+            }
+        }
+    }
+    return false;
+}
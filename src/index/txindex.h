@@ -8,11 +8,21 @@
 #include <index/base.h>
 
 static constexpr bool DEFAULT_TXINDEX{false};
+static constexpr bool DEFAULT_TXINDEX_COMPACT{false};
+
+struct CDiskTxPos;
 
 /**
  * TxIndex is used to look up transactions included in the blockchain by hash.
  * The index is written to a LevelDB database and records the filesystem
  * location of each transaction by transaction hash.
+ *
+ * In the compact format, transactions are keyed by a truncated txid and the
+ * block height, and only their offset within the block is stored, while the
+ * block position is recorded once per height. Lookups resolve collisions of
+ * the truncated txids by checking the transactions read from disk. An index
+ * in the full format is converted in place on the sync thread when the
+ * compact format is enabled; switching back requires rebuilding the index.
  */
 class TxIndex final : public BaseIndex
 {
@@ -23,15 +33,25 @@ private:
     const std::unique_ptr<DB> m_db;
 
     bool AllowPrune() const override { return false; }
+    bool AllowParallelAppend() const override { return true; }
+
+    /// Read the transaction at the given position from the block files.
+    bool ReadTxFromDisk(const CDiskTxPos& pos, uint256& block_hash, CTransactionRef& tx) const;
 
 protected:
+    interfaces::Chain::NotifyOptions CustomOptions() override;
+
+    bool CustomUpgrade(const CThreadInterrupt& interrupt) override;
+
     bool CustomAppend(const interfaces::BlockInfo& block) override;
 
+    bool CustomRemove(const interfaces::BlockInfo& block) override;
+
     BaseIndex::DB& GetDB() const override;
 
 public:
     /// Constructs the index, which becomes available to be queried.
-    explicit TxIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false);
+    explicit TxIndex(std::unique_ptr<interfaces::Chain> chain, size_t n_cache_size, bool f_memory = false, bool f_wipe = false, bool compact = DEFAULT_TXINDEX_COMPACT);
 
     // Destructor is declared because this class contains a unique_ptr to an incomplete type.
     virtual ~TxIndex() override;
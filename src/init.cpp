@@ -27,6 +27,7 @@
 #include <index/blockfilterindex.h>
 #include <index/coinstatsindex.h>
 #include <index/namehash.h>
+#include <index/synccoordinator.h>
 #include <index/txindex.h>
 #include <init/common.h>
 #include <interfaces/chain.h>
@@ -64,6 +65,7 @@
 #include <policy/fees_args.h>
 #include <policy/policy.h>
 #include <policy/settings.h>
+#include <primitives/transaction.h>
 #include <protocol.h>
 #include <rpc/blockchain.h>
 #include <rpc/game.h>
@@ -150,6 +152,8 @@ static constexpr bool DEFAULT_PROXYRANDOMIZE{true};
 static constexpr bool DEFAULT_REST_ENABLE{false};
 static constexpr bool DEFAULT_I2P_ACCEPT_INCOMING{true};
 static constexpr bool DEFAULT_STOPAFTERBLOCKIMPORT{false};
+//! Upper bound for the threads that help hash the transactions of blocks.
+static constexpr int MAX_TRANSACTION_HASH_THREADS{4};
 
 #ifdef WIN32
 // Win32 LevelDB doesn't use filedescriptors, and the ones used for
@@ -380,6 +384,8 @@ void Shutdown(NodeContext& node)
                 chainstate->ResetCoinsViews();
             }
         }
+        // Let the next startup load the block index in a single read
+        node.chainman->m_blockman.WriteBlockIndexSnapshot();
     }
     for (const auto& client : node.chain_clients) {
         client->stop();
@@ -399,6 +405,7 @@ void Shutdown(NodeContext& node)
     node.mempool.reset();
     node.fee_estimator.reset();
     node.chainman.reset();
+    StopTransactionHashThreads();
     node.validation_signals.reset();
     node.scheduler.reset();
     node.ecc_context.reset();
@@ -407,6 +414,7 @@ void Shutdown(NodeContext& node)
     RemovePidFile(*node.args);
 
     LogPrintf("%s: done\n", __func__);
+    LogInstance().StopAsyncLogging();
 }
 
 /**
@@ -524,6 +532,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-shutdownnotify=<cmd>", "Execute command immediately before beginning shutdown. The need for shutdown may be urgent, so be careful not to delay it long (if the command doesn't require interaction with the server, consider having it fork into the background).", ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
 #endif
     argsman.AddArg("-txindex", strprintf("Maintain a full transaction index, used by the getrawtransaction rpc call (default: %u)", DEFAULT_TXINDEX), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
+    argsman.AddArg("-txindexcompact", strprintf("Store the transaction index in a compact format with truncated transaction ids, converting an existing index on startup. Disabling it again rebuilds the index (default: %u)", DEFAULT_TXINDEX_COMPACT), ArgsManager::ALLOW_ANY, OptionsCategory::OPTIONS);
     argsman.AddArg("-blockfilterindex=<type>",
                  strprintf("Maintain an index of compact filters by block (default: %s, values: %s).", DEFAULT_BLOCKFILTERINDEX, ListBlockFilterTypes()) +
                  " If <type> is not supplied or if <type> = 1, indexes for all known types are enabled.",
@@ -650,6 +659,7 @@ void SetupServerArgs(ArgsManager& argsman, bool can_listen_ipc)
     argsman.AddArg("-capturemessages", "Capture all P2P messages to disk", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-mocktime=<n>", "Replace actual time with " + UNIX_EPOCH_TIME + " (default: 0)", ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxsigcachesize=<n>", strprintf("Limit sum of signature cache and script execution cache sizes to <n> MiB (default: %u)", DEFAULT_VALIDATION_CACHE_BYTES >> 20), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
+    argsman.AddArg("-batchschnorrverify", strprintf("Verify Schnorr signatures of blocks in batches on the script check threads (default: %u)", DEFAULT_BATCH_SCHNORR_VERIFICATION), ArgsManager::ALLOW_ANY | ArgsManager::DEBUG_ONLY, OptionsCategory::DEBUG_TEST);
     argsman.AddArg("-maxtipage=<n>",
                    strprintf("Maximum tip age in seconds to consider node in initial block download (default: %u)",
                              Ticks<std::chrono::seconds>(DEFAULT_MAX_TIP_AGE)),
@@ -1270,6 +1280,14 @@ static ChainstateLoadResult InitAndLoadChainstate(
     };
     Assert(ApplyArgsManOptions(args, chainman_opts)); // no error can happen, already checked in AppInitParameterInteraction
 
+    // Hash the transactions of deserialized blocks with (at most) as many
+    // helper threads as there are script verification threads.
+    const int tx_hash_threads{std::clamp(chainman_opts.worker_threads_num, 0, MAX_TRANSACTION_HASH_THREADS)};
+    if (tx_hash_threads > 0) {
+        LogPrintf("Using %d threads for transaction hashing\n", tx_hash_threads);
+        StartTransactionHashThreads(tx_hash_threads);
+    }
+
     BlockManager::Options blockman_opts{
         .chainparams = chainman_opts.chainparams,
         .blocks_dir = args.GetBlocksDirPath(),
@@ -1723,7 +1741,9 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
         );
 
     if (g_zmq_notification_interface) {
-        validation_signals.RegisterValidationInterface(g_zmq_notification_interface.get());
+        // Building the notifications can be slow for big blocks, so do not
+        // let them hold up the other subscribers.
+        validation_signals.RegisterValidationInterface(g_zmq_notification_interface.get(), "zmq");
     }
 #endif
 
@@ -1806,7 +1826,7 @@ bool AppInitMain(NodeContext& node, interfaces::BlockAndHeaderTipInfo* tip_info)
     // ********************************************************* Step 8: start indexers
 
     if (args.GetBoolArg("-txindex", DEFAULT_TXINDEX)) {
-        g_txindex = std::make_unique<TxIndex>(interfaces::MakeChain(node), index_cache_sizes.tx_index, false, do_reindex);
+        g_txindex = std::make_unique<TxIndex>(interfaces::MakeChain(node), index_cache_sizes.tx_index, false, do_reindex, args.GetBoolArg("-txindexcompact", DEFAULT_TXINDEX_COMPACT));
         node.indexes.emplace_back(g_txindex.get());
     }
 
@@ -2204,7 +2224,11 @@ bool StartIndexBackgroundSync(NodeContext& node)
         }
     }
 
-    // Start threads
-    for (auto index : node.indexes) if (!index->StartBackgroundSync()) return false;
+    // Start threads. Indexes catching up read each block only once between them.
+    const auto coordinator{std::make_shared<IndexSyncCoordinator>(chainman.m_blockman)};
+    for (auto index : node.indexes) {
+        if (!index->GetSummary().synced) index->SetSyncCoordinator(coordinator);
+        if (!index->StartBackgroundSync()) return false;
+    }
     return true;
 }
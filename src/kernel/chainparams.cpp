@@ -705,6 +705,12 @@ public:
                 .m_chain_tx_count = 111,
                 .blockhash = consteval_ctor(uint256{"64a6414abd7390e34eb05773e8deb293fe3b136e5e5c4612edf78b084ebb87e5"}),
             },
+            {   // For use by the unit test of names in snapshots
+                .height = 120,
+                .hash_serialized = AssumeutxoHash{uint256{"b8ae47499e4c52df1c2469d47fb161b719dcd05b95ab0c8d806e1de111547178"}},
+                .m_chain_tx_count = 124,
+                .blockhash = consteval_ctor(uint256{"386870d0bd6237533029748e1eae54b1a9ae0401f3d5578760e6e54f580cac19"}),
+            },
             {
                 // For use by fuzz target src/test/fuzz/utxo_snapshot.cpp
                 .height = 200,
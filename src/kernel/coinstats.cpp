@@ -22,13 +22,18 @@
 #include <util/overflow.h>
 #include <validation.h>
 
+#include <algorithm>
+#include <atomic>
 #include <cassert>
+#include <exception>
 #include <iosfwd>
 #include <iterator>
 #include <map>
 #include <memory>
 #include <string>
+#include <thread>
 #include <utility>
+#include <vector>
 
 namespace kernel {
 
@@ -52,8 +57,7 @@ AddCoinValueToTotals (const Coin& coin, const int sign,
                       std::optional<CAmount>& totalCoins,
                       std::optional<CAmount>& totalNames)
 {
-  const CNameScript nameOp(coin.out.scriptPubKey);
-  if (nameOp.isNameOp ()) {
+  if (CNameScript::isNameScript (coin.out.scriptPubKey)) {
     if (totalNames.has_value ())
       totalNames = CheckedAdd (*totalNames, sign * coin.out.nValue);
   } else {
@@ -124,20 +128,22 @@ static void ApplyStats(CCoinsStats& stats, const uint256& hash, const std::map<u
     }
 }
 
-//! Calculate statistics about the unspent transaction output set
+//! Maximum number of threads used to compute order-independent statistics
+static constexpr unsigned int MAX_UTXO_STATS_THREADS{8};
+//! Number of cursor ranges per thread, so that uneven ranges balance out
+static constexpr size_t UTXO_STATS_RANGES_PER_THREAD{4};
+
+//! Add the statistics and hash of the coins in the range of a cursor
 template <typename T>
-static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
+static bool ApplyCursor(CCoinsViewCursor& cursor, CCoinsStats& stats, T& hash_obj, const std::function<void()>& interruption_point)
 {
-    std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
-    assert(pcursor);
-
     Txid prevkey;
     std::map<uint32_t, Coin> outputs;
-    while (pcursor->Valid()) {
+    while (cursor.Valid()) {
         if (interruption_point) interruption_point();
         COutPoint key;
         Coin coin;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
+        if (cursor.GetKey(key) && cursor.GetValue(coin)) {
             if (!outputs.empty() && key.hash != prevkey) {
                 ApplyStats(stats, prevkey, outputs);
                 ApplyHash(hash_obj, prevkey, outputs);
@@ -150,12 +156,100 @@ static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, c
             LogError("%s: unable to read value\n", __func__);
             return false;
         }
-        pcursor->Next();
+        cursor.Next();
     }
     if (!outputs.empty()) {
         ApplyStats(stats, prevkey, outputs);
         ApplyHash(hash_obj, prevkey, outputs);
     }
+    return true;
+}
+
+//! Add the statistics of a disjoint part of the UTXO set
+static void MergeStats(CCoinsStats& stats, const CCoinsStats& part)
+{
+    stats.nTransactions += part.nTransactions;
+    stats.nTransactionOutputs += part.nTransactionOutputs;
+    stats.nBogoSize += part.nBogoSize;
+    stats.coins_count += part.coins_count;
+    const auto merge_amount{[](std::optional<CAmount>& total, const std::optional<CAmount>& part_total) {
+        if (total.has_value() && part_total.has_value()) {
+            total = CheckedAdd(*total, *part_total);
+        } else {
+            total = std::nullopt;
+        }
+    }};
+    merge_amount(stats.nCoinAmount, part.nCoinAmount);
+    merge_amount(stats.nNameAmount, part.nNameAmount);
+}
+
+static void MergeHash(MuHash3072& muhash, const MuHash3072& part) { muhash *= part; }
+static void MergeHash(std::nullptr_t, std::nullptr_t) {}
+
+//! Calculate statistics about the unspent transaction output set
+template <typename T>
+static bool ComputeUTXOStats(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
+{
+    std::unique_ptr<CCoinsViewCursor> pcursor(view->Cursor());
+    assert(pcursor);
+
+    if (!ApplyCursor(*pcursor, stats, hash_obj, interruption_point)) return false;
+
+    FinalizeHash(hash_obj, stats);
+
+    stats.nDiskSize = view->EstimateSize();
+
+    return true;
+}
+
+//! Calculate statistics about the unspent transaction output set, splitting
+//! the work between threads. Only valid for hashes that do not depend on the
+//! order in which the coins are added.
+template <typename T>
+static bool ComputeUTXOStatsParallel(CCoinsView* view, CCoinsStats& stats, T hash_obj, const std::function<void()>& interruption_point)
+{
+    const unsigned int num_threads{std::clamp(std::thread::hardware_concurrency(), 1U, MAX_UTXO_STATS_THREADS)};
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors{view->RangeCursors(num_threads * UTXO_STATS_RANGES_PER_THREAD)};
+    for (const auto& cursor : cursors) assert(cursor);
+
+    struct Part {
+        CCoinsStats stats;
+        T hash_obj{};
+        bool success{true};
+    };
+    std::vector<Part> parts(cursors.size());
+    std::atomic<size_t> next_range{0};
+    std::atomic<bool> failed{false};
+    std::exception_ptr exception;
+    Mutex exception_mutex;
+    const auto worker{[&] {
+        for (size_t r = next_range++; r < cursors.size() && !failed; r = next_range++) {
+            try {
+                parts[r].success = ApplyCursor(*cursors[r], parts[r].stats, parts[r].hash_obj, interruption_point);
+            } catch (...) {
+                WITH_LOCK(exception_mutex, if (!exception) exception = std::current_exception());
+                parts[r].success = false;
+            }
+            if (!parts[r].success) failed = true;
+        }
+    }};
+
+    std::vector<std::thread> threads;
+    for (unsigned int n = 1; n < std::min<size_t>(num_threads, cursors.size()); ++n) {
+        threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) thread.join();
+
+    // Interruption is reported to the caller the same way as when computing
+    // the statistics serially.
+    if (exception) std::rethrow_exception(exception);
+    if (failed) return false;
+
+    for (const Part& part : parts) {
+        MergeStats(stats, part.stats);
+        MergeHash(hash_obj, part.hash_obj);
+    }
 
     FinalizeHash(hash_obj, stats);
 
@@ -177,10 +271,10 @@ std::optional<CCoinsStats> ComputeUTXOStats(CoinStatsHashType hash_type, CCoinsV
         }
         case(CoinStatsHashType::MUHASH): {
             MuHash3072 muhash;
-            return ComputeUTXOStats(view, stats, muhash, interruption_point);
+            return ComputeUTXOStatsParallel(view, stats, muhash, interruption_point);
         }
         case(CoinStatsHashType::NONE): {
-            return ComputeUTXOStats(view, stats, nullptr, interruption_point);
+            return ComputeUTXOStatsParallel(view, stats, nullptr, interruption_point);
         }
         } // no default case, so the compiler can warn about missing cases
         assert(false);
@@ -4,6 +4,9 @@
 
 #include <kernel/context.h>
 
+#include <crypto/chacha20.h>
+#include <crypto/hex_base.h>
+#include <crypto/poly1305.h>
 #include <crypto/sha256.h>
 #include <logging.h>
 #include <random.h>
@@ -18,6 +21,12 @@ Context::Context()
     std::call_once(globals_initialized, []() {
         std::string sha256_algo = SHA256AutoDetect();
         LogInfo("Using the '%s' SHA256 implementation\n", sha256_algo);
+        std::string hex_algo = HexAutoDetect();
+        LogInfo("Using the '%s' hex implementation\n", hex_algo);
+        std::string chacha20_algo = ChaCha20AutoDetect();
+        LogInfo("Using the '%s' ChaCha20 implementation\n", chacha20_algo);
+        std::string poly1305_algo = Poly1305AutoDetect();
+        LogInfo("Using the '%s' Poly1305 implementation\n", poly1305_algo);
         RandomInit();
     });
 }
@@ -11,7 +11,9 @@
 #include <util/threadnames.h>
 #include <util/time.h>
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <map>
 #include <optional>
 
@@ -49,6 +51,76 @@ static int FileWriteStr(std::string_view str, FILE *fp)
     return fwrite(str.data(), 1, str.size(), fp);
 }
 
+//! How often the asynchronous writer checks for queued messages
+static constexpr auto ASYNC_LOG_WRITE_INTERVAL{std::chrono::milliseconds{20}};
+
+namespace BCLog {
+/**
+ * Fixed-size queue of formatted messages from one thread to the asynchronous
+ * writer. Only the owning thread pushes and only the writer pops, so no lock
+ * is needed.
+ */
+class AsyncLogQueue
+{
+public:
+    struct Entry {
+        uint64_t sequence;
+        std::string str;
+    };
+
+    AsyncLogQueue() : m_entries(ASYNC_LOG_QUEUE_SIZE) {}
+
+    /** Returns false if the queue is full */
+    bool TryPush(uint64_t sequence, std::string&& str)
+    {
+        const size_t head{m_head.load(std::memory_order_relaxed)};
+        if (head - m_tail.load(std::memory_order_acquire) == m_entries.size()) return false;
+        Entry& entry{m_entries[head % m_entries.size()]};
+        entry.sequence = sequence;
+        entry.str = std::move(str);
+        m_head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /** Move all queued entries to the end of out */
+    void PopAll(std::vector<Entry>& out)
+    {
+        const size_t tail{m_tail.load(std::memory_order_relaxed)};
+        const size_t head{m_head.load(std::memory_order_acquire)};
+        for (size_t i = tail; i < head; ++i) {
+            out.push_back(std::move(m_entries[i % m_entries.size()]));
+        }
+        m_tail.store(head, std::memory_order_release);
+    }
+
+    bool Empty() const { return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire); }
+
+    //! Set when the owning thread has exited, so that the queue can be dropped
+    //! once it is empty
+    std::atomic<bool> m_orphaned{false};
+
+private:
+    std::vector<Entry> m_entries;
+    std::atomic<size_t> m_head{0};
+    std::atomic<size_t> m_tail{0};
+};
+} // namespace BCLog
+
+namespace {
+/** The asynchronous log queue of a thread */
+struct ThreadAsyncLogQueue {
+    const BCLog::Logger* logger{nullptr};
+    uint64_t epoch{0};
+    std::shared_ptr<BCLog::AsyncLogQueue> queue;
+
+    ~ThreadAsyncLogQueue()
+    {
+        if (queue) queue->m_orphaned = true;
+    }
+};
+thread_local ThreadAsyncLogQueue g_thread_async_log_queue;
+} // namespace
+
 bool BCLog::Logger::StartLogging()
 {
     StdLockGuard scoped_lock(m_cs);
@@ -90,11 +162,32 @@ bool BCLog::Logger::StartLogging()
     m_cur_buffer_memusage = 0;
     if (m_print_to_console) fflush(stdout);
 
+    if (m_async && (m_print_to_file || m_print_to_console || !m_print_callbacks.empty())) {
+        m_async_stop = false;
+        ++m_async_epoch;
+        m_async_writer = std::thread{[this] { ThreadAsyncWriter(); }};
+        m_async_active = true;
+    }
+
     return true;
 }
 
+void BCLog::Logger::StopAsyncLogging()
+{
+    if (!m_async_active.exchange(false)) return;
+    // Wait for the threads that are still queueing a message, which the
+    // writer then picks up before exiting.
+    while (m_async_producers > 0) std::this_thread::yield();
+    m_async_stop = true;
+    m_async_wake_cv.notify_all();
+    m_async_writer.join();
+    StdLockGuard scoped_lock(m_async_queues_mutex);
+    m_async_queues.clear();
+}
+
 void BCLog::Logger::DisconnectTestLogger()
 {
+    StopAsyncLogging();
     StdLockGuard scoped_lock(m_cs);
     m_buffering = true;
     if (m_fileout != nullptr) fclose(m_fileout);
@@ -388,10 +481,98 @@ void BCLog::Logger::FormatLogStrInPlace(std::string& str, BCLog::LogFlags catego
 
 void BCLog::Logger::LogPrintStr(std::string_view str, std::string_view logging_function, std::string_view source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
 {
+    if (m_async_active && LogPrintStrAsync(str, logging_function, source_file, source_line, category, level)) return;
     StdLockGuard scoped_lock(m_cs);
     return LogPrintStr_(str, logging_function, source_file, source_line, category, level);
 }
 
+bool BCLog::Logger::LogPrintStrAsync(std::string_view str, std::string_view logging_function, std::string_view source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
+{
+    ++m_async_producers;
+    if (!m_async_active) {
+        --m_async_producers;
+        return false;
+    }
+
+    std::string str_prefixed = LogEscapeMessage(str);
+    FormatLogStrInPlace(str_prefixed, category, level, source_file, source_line, logging_function, util::ThreadGetInternalName(), SystemClock::now(), GetMockTime());
+
+    // If the queue is full, wait for the writer to make room instead of
+    // dropping the message. The writer takes m_async_wake_mutex before
+    // waking producers, so a wakeup between a failed push and the wait
+    // cannot be missed.
+    AsyncLogQueue& queue{ThreadAsyncQueue()};
+    const uint64_t sequence{m_async_sequence++};
+    if (!queue.TryPush(sequence, std::move(str_prefixed))) {
+        std::unique_lock<std::mutex> lock{m_async_wake_mutex};
+        while (!queue.TryPush(sequence, std::move(str_prefixed))) {
+            m_async_wake_cv.notify_all();
+            m_async_wake_cv.wait(lock);
+        }
+    }
+
+    --m_async_producers;
+    return true;
+}
+
+BCLog::AsyncLogQueue& BCLog::Logger::ThreadAsyncQueue()
+{
+    auto& thread_queue{g_thread_async_log_queue};
+    const uint64_t epoch{m_async_epoch};
+    if (thread_queue.logger != this || thread_queue.epoch != epoch || !thread_queue.queue) {
+        if (thread_queue.queue) thread_queue.queue->m_orphaned = true;
+        thread_queue.logger = this;
+        thread_queue.epoch = epoch;
+        thread_queue.queue = std::make_shared<AsyncLogQueue>();
+        // Only taken once per thread
+        StdLockGuard scoped_lock(m_async_queues_mutex);
+        m_async_queues.push_back(thread_queue.queue);
+    }
+    return *thread_queue.queue;
+}
+
+bool BCLog::Logger::WriteAsyncQueues()
+{
+    std::vector<AsyncLogQueue::Entry> entries;
+    {
+        StdLockGuard scoped_lock(m_async_queues_mutex);
+        for (const auto& queue : m_async_queues) queue->PopAll(entries);
+        std::erase_if(m_async_queues, [](const auto& queue) { return queue->m_orphaned && queue->Empty(); });
+    }
+    if (entries.empty()) return false;
+
+    // Write all messages with one call per output, in the order they were logged
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.sequence < b.sequence; });
+    std::string batch;
+    for (const auto& entry : entries) batch += entry.str;
+
+    StdLockGuard scoped_lock(m_cs);
+    for (const auto& cb : m_print_callbacks) {
+        for (const auto& entry : entries) cb(entry.str);
+    }
+    WriteFormatted(batch);
+    return true;
+}
+
+void BCLog::Logger::ThreadAsyncWriter()
+{
+    util::ThreadRename("logwriter");
+    while (true) {
+        // Check for the stop request before writing, so that all messages
+        // queued before it are written.
+        const bool stop{m_async_stop};
+        if (WriteAsyncQueues()) {
+            // Wake producers waiting for room in their queues
+            { std::lock_guard<std::mutex> lock{m_async_wake_mutex}; }
+            m_async_wake_cv.notify_all();
+            continue;
+        }
+        if (stop) return;
+        std::unique_lock<std::mutex> lock{m_async_wake_mutex};
+        m_async_wake_cv.wait_for(lock, ASYNC_LOG_WRITE_INTERVAL);
+    }
+}
+
 void BCLog::Logger::LogPrintStr_(std::string_view str, std::string_view logging_function, std::string_view source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
 {
     std::string str_prefixed = LogEscapeMessage(str);
@@ -428,14 +609,19 @@ void BCLog::Logger::LogPrintStr_(std::string_view str, std::string_view logging_
 
     FormatLogStrInPlace(str_prefixed, category, level, source_file, source_line, logging_function, util::ThreadGetInternalName(), SystemClock::now(), GetMockTime());
 
+    for (const auto& cb : m_print_callbacks) {
+        cb(str_prefixed);
+    }
+    WriteFormatted(str_prefixed);
+}
+
+void BCLog::Logger::WriteFormatted(std::string_view str)
+{
     if (m_print_to_console) {
         // print to console
-        fwrite(str_prefixed.data(), 1, str_prefixed.size(), stdout);
+        fwrite(str.data(), 1, str.size(), stdout);
         fflush(stdout);
     }
-    for (const auto& cb : m_print_callbacks) {
-        cb(str_prefixed);
-    }
     if (m_print_to_file) {
         assert(m_fileout != nullptr);
 
@@ -449,7 +635,7 @@ void BCLog::Logger::LogPrintStr_(std::string_view str, std::string_view logging_
                 m_fileout = new_fileout;
             }
         }
-        FileWriteStr(str_prefixed, m_fileout);
+        FileWriteStr(str, m_fileout);
     }
 }
 
@@ -13,11 +13,14 @@
 #include <util/time.h>
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <functional>
 #include <list>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 
@@ -27,6 +30,7 @@ static const bool DEFAULT_LOGTIMESTAMPS = true;
 static const bool DEFAULT_LOGTHREADNAMES = false;
 static const bool DEFAULT_LOGSOURCELOCATIONS = false;
 static constexpr bool DEFAULT_LOGLEVELALWAYS = false;
+static constexpr bool DEFAULT_LOGASYNC{false};
 extern const char * const DEFAULT_DEBUGLOGFILE;
 
 extern bool fLogIPs;
@@ -84,6 +88,9 @@ namespace BCLog {
     };
     constexpr auto DEFAULT_LOG_LEVEL{Level::Debug};
     constexpr size_t DEFAULT_MAX_LOG_BUFFER{1'000'000}; // buffer up to 1MB of log data prior to StartLogging
+    constexpr size_t ASYNC_LOG_QUEUE_SIZE{2048}; // messages queued per thread in asynchronous mode
+
+    class AsyncLogQueue;
 
     class Logger
     {
@@ -130,6 +137,34 @@ namespace BCLog {
 
         std::string GetLogPrefix(LogFlags category, Level level) const;
 
+        /** Write formatted messages to the console and the log file */
+        void WriteFormatted(std::string_view str) EXCLUSIVE_LOCKS_REQUIRED(m_cs);
+
+        //! Whether messages are currently passed to the asynchronous writer
+        std::atomic<bool> m_async_active{false};
+        //! Number of threads currently queueing a message for the writer
+        std::atomic<int> m_async_producers{0};
+        //! Incremented whenever asynchronous logging is started, so that
+        //! threads register a new queue with the new writer
+        std::atomic<uint64_t> m_async_epoch{0};
+        //! Orders the messages of the different threads
+        std::atomic<uint64_t> m_async_sequence{0};
+        std::atomic<bool> m_async_stop{false};
+        std::mutex m_async_wake_mutex;
+        std::condition_variable m_async_wake_cv;
+        mutable StdMutex m_async_queues_mutex;
+        std::vector<std::shared_ptr<AsyncLogQueue>> m_async_queues GUARDED_BY(m_async_queues_mutex);
+        std::thread m_async_writer;
+
+        /** Queue a message for the asynchronous writer, returns false if it is not running */
+        bool LogPrintStrAsync(std::string_view str, std::string_view logging_function, std::string_view source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
+            EXCLUSIVE_LOCKS_REQUIRED(!m_async_queues_mutex);
+        /** Get the queue of the calling thread, registering it if needed */
+        AsyncLogQueue& ThreadAsyncQueue() EXCLUSIVE_LOCKS_REQUIRED(!m_async_queues_mutex);
+        /** Write out all queued messages, returns whether there were any */
+        bool WriteAsyncQueues() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_queues_mutex);
+        void ThreadAsyncWriter() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_queues_mutex);
+
     public:
         bool m_print_to_console = false;
         bool m_print_to_file = false;
@@ -139,13 +174,15 @@ namespace BCLog {
         bool m_log_threadnames = DEFAULT_LOGTHREADNAMES;
         bool m_log_sourcelocations = DEFAULT_LOGSOURCELOCATIONS;
         bool m_always_print_category_level = DEFAULT_LOGLEVELALWAYS;
+        //! Write the log on a background thread once logging is started
+        bool m_async = DEFAULT_LOGASYNC;
 
         fs::path m_file_path;
         std::atomic<bool> m_reopen_file{false};
 
         /** Send a string to the log output */
         void LogPrintStr(std::string_view str, std::string_view logging_function, std::string_view source_file, int source_line, BCLog::LogFlags category, BCLog::Level level)
-            EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+            EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_queues_mutex);
 
         /** Returns whether logs will be written to any output */
         bool Enabled() const EXCLUSIVE_LOCKS_REQUIRED(!m_cs)
@@ -170,9 +207,15 @@ namespace BCLog {
         }
 
         /** Start logging (and flush all buffered messages) */
-        bool StartLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+        bool StartLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_queues_mutex);
         /** Only for testing */
-        void DisconnectTestLogger() EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+        void DisconnectTestLogger() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_queues_mutex);
+
+        /**
+         * Write out all queued messages and stop the asynchronous writer.
+         * Messages logged afterwards are written by the logging thread.
+         */
+        void StopAsyncLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_queues_mutex);
 
         /** Disable logging
          * This offers a slight speedup and slightly smaller memory usage
@@ -180,7 +223,7 @@ namespace BCLog {
          * Mostly intended for libbitcoin-kernel apps that don't want any logging.
          * Should be used instead of StartLogging().
          */
-        void DisableLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs);
+        void DisableLogging() EXCLUSIVE_LOCKS_REQUIRED(!m_cs, !m_async_queues_mutex);
 
         void ShrinkDebugFile();
 
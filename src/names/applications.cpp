@@ -120,21 +120,19 @@ IsValidJSONOrEmptyString (const std::string& text){
 
 bool
 IsMinimalJSONOrEmptyString (const std::string& text){
-    UniValue v;
     if(text.empty()){
         return true;
     } 
 
-    if(!v.read(text)){ 
+    /* Checks that text is what GetMinimalJSON would return for it, without
+       parsing and writing it again.  */
+    bool isMinimal;
+    if(!UniValue::validate(text, nullptr, &isMinimal)){ 
         return false;
     } 
 
-    const std::string minimalJSON = GetMinimalJSON(text);
-    
-    const bool isMinimal = (text == minimalJSON);
-
     if(!isMinimal){
-        LogDebug(BCLog::NAMES, "Minimalised JSON string is: %s \n", minimalJSON);
+        LogDebug(BCLog::NAMES, "Minimalised JSON string is: %s \n", GetMinimalJSON(text));
     }
 
     return isMinimal;
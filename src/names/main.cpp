@@ -24,6 +24,7 @@
 #include <univalue.h>
 
 #include <string>
+#include <string_view>
 
 namespace
 {
@@ -120,13 +121,17 @@ IsValueValid (const valtype& value, TxValidationState& state)
                           "tx-value-too-long",
                           "The value is too long");
 
-  /* The value must parse with Univalue as JSON and be an object.  */
-  UniValue jsonValue;
-  if (!jsonValue.read (std::string (value.begin (), value.end ())))
+  /* The value must parse with Univalue as JSON and be an object.  This
+     checks it exactly like UniValue::read would, but without building
+     the parsed value.  */
+  UniValue::VType type;
+  const std::string_view str(reinterpret_cast<const char*> (value.data ()),
+                             value.size ());
+  if (!UniValue::validate (str, &type))
     return state.Invalid (TxValidationResult::TX_CONSENSUS,
                           "tx-value-invalid-json",
                           "The value is not valid JSON");
-  if (!jsonValue.isObject ())
+  if (type != UniValue::VOBJ)
     return state.Invalid (TxValidationResult::TX_CONSENSUS,
                           "tx-value-no-json-object",
                           "The value must be a JSON object");
@@ -155,7 +160,7 @@ CheckNameTransaction (const CTransaction& tx, unsigned nHeight,
                               "bad-txns-inputs-missingorspent",
                               "Failed to fetch name input coin");
 
-      const CNameScript op(coin->out.scriptPubKey);
+      const NameScriptView op(coin->out.scriptPubKey);
       if (op.isNameOp ())
         {
           if (nameIn != -1)
@@ -163,7 +168,7 @@ CheckNameTransaction (const CTransaction& tx, unsigned nHeight,
                                   "tx-multiple-name-inputs",
                                   "Multiple name inputs");
           nameIn = i;
-          nameOpIn = op;
+          nameOpIn = CNameScript (op);
           coinIn = *coin;
         }
     }
@@ -172,7 +177,7 @@ CheckNameTransaction (const CTransaction& tx, unsigned nHeight,
   CNameScript nameOpOut;
   for (unsigned i = 0; i < tx.vout.size (); ++i)
     {
-      const CNameScript op(tx.vout[i].scriptPubKey);
+      const NameScriptView op(tx.vout[i].scriptPubKey);
       if (op.isNameOp ())
         {
           if (nameOut != -1)
@@ -180,7 +185,7 @@ CheckNameTransaction (const CTransaction& tx, unsigned nHeight,
                                   "tx-multiple-name-outputs",
                                   "Multiple name outputs");
           nameOut = i;
-          nameOpOut = op;
+          nameOpOut = CNameScript (op);
         }
     }
 
@@ -290,8 +295,11 @@ ApplyNameTransaction (const CTransaction& tx, unsigned nHeight,
 
   for (unsigned i = 0; i < tx.vout.size (); ++i)
     {
+      if (!CNameScript::isNameScript (tx.vout[i].scriptPubKey))
+        continue;
+
       const CNameScript op(tx.vout[i].scriptPubKey);
-      if (op.isNameOp () && op.isAnyUpdate ())
+      if (op.isAnyUpdate ())
         {
           const valtype& name = op.getOpName ();
           LogDebug (BCLog::NAMES, "Updating name at height %d: %s\n",
@@ -46,8 +46,7 @@ getNameOutput (const CTxMemPool& pool, const Txid& txid)
 
   for (unsigned i = 0; i != vout.size (); ++i)
     {
-      const CNameScript nameOp(vout[i].scriptPubKey);
-      if (nameOp.isNameOp ())
+      if (CNameScript::isNameScript (vout[i].scriptPubKey))
         return COutPoint (txid, i);
     }
 
@@ -158,10 +157,11 @@ CNameMemPool::removeConflicts (const CTransaction& tx)
 
   for (const auto& txout : tx.vout)
     {
-      const CNameScript nameOp(txout.scriptPubKey);
+      const NameScriptView nameOp(txout.scriptPubKey);
       if (nameOp.isNameOp () && nameOp.getNameOp () == OP_NAME_REGISTER)
         {
-          const valtype& name = nameOp.getOpName ();
+          const valtype name(nameOp.getOpName ().begin (),
+                             nameOp.getOpName ().end ());
           const auto mit = mapNameRegs.find (name);
           if (mit != mapNameRegs.end ())
             {
@@ -229,7 +229,7 @@ CNameMemPool::checkTx (const CTransaction& tx) const
 
   for (const auto& txout : tx.vout)
     {
-      const CNameScript nameOp(txout.scriptPubKey);
+      const NameScriptView nameOp(txout.scriptPubKey);
       if (!nameOp.isNameOp ())
         continue;
 
@@ -237,7 +237,8 @@ CNameMemPool::checkTx (const CTransaction& tx) const
         {
         case OP_NAME_REGISTER:
           {
-            const valtype& name = nameOp.getOpName ();
+            const valtype name(nameOp.getOpName ().begin (),
+                               nameOp.getOpName ().end ());
             if (registersName (name))
               return false;
             break;
@@ -31,12 +31,15 @@
 #include <util/batchpriority.h>
 #include <util/check.h>
 #include <util/fs.h>
+#include <util/fs_helpers.h>
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/translation.h>
 #include <validation.h>
 
+#include <array>
 #include <cstddef>
+#include <limits>
 #include <map>
 #include <optional>
 #include <unordered_map>
@@ -47,6 +50,7 @@ static constexpr uint8_t DB_BLOCK_INDEX{'b'};
 static constexpr uint8_t DB_FLAG{'F'};
 static constexpr uint8_t DB_REINDEX_FLAG{'R'};
 static constexpr uint8_t DB_LAST_BLOCK{'l'};
+static constexpr uint8_t DB_BLOCK_INDEX_SNAPSHOT{'S'};
 // Keys used in previous version that might still be found in the DB:
 // BlockTreeDB::DB_TXINDEX_BLOCK{'T'};
 // BlockTreeDB::DB_TXINDEX{'t'}
@@ -86,9 +90,42 @@ bool BlockTreeDB::WriteBatchSync(const std::vector<std::pair<int, const CBlockFi
     for (const CBlockIndex* bi : blockinfo) {
         batch.Write(std::make_pair(DB_BLOCK_INDEX, bi->GetBlockHash()), CDiskBlockIndex{bi});
     }
+    // The block index snapshot no longer matches the entries
+    if (!blockinfo.empty()) batch.Erase(DB_BLOCK_INDEX_SNAPSHOT);
     return WriteBatch(batch, true);
 }
 
+bool BlockTreeDB::ReadBlockIndexSnapshotId(uint256& id)
+{
+    return Read(DB_BLOCK_INDEX_SNAPSHOT, id);
+}
+
+bool BlockTreeDB::WriteBlockIndexSnapshotId(const uint256& id)
+{
+    return Write(DB_BLOCK_INDEX_SNAPSHOT, id, /*fSync=*/true);
+}
+
+bool BlockTreeDB::EraseBlockIndexSnapshotId()
+{
+    CDBBatch batch(*this);
+    batch.Erase(DB_BLOCK_INDEX_SNAPSHOT);
+    return WriteBatch(batch, /*fSync=*/true);
+}
+
+bool BlockTreeDB::ReadBlockIndex(const uint256& hash, CDiskBlockIndex& index)
+{
+    return Read(std::make_pair(DB_BLOCK_INDEX, hash), index);
+}
+
+uint256 BlockTreeDB::HashLastBlockFile()
+{
+    HashWriter hasher{};
+    int last_file;
+    CBlockFileInfo info;
+    if (ReadLastBlockFile(last_file) && ReadBlockFileInfo(last_file, info)) hasher << last_file << info;
+    return hasher.GetSHA256();
+}
+
 bool BlockTreeDB::WriteFlag(const std::string& name, bool fValue)
 {
     return Write(std::make_pair(DB_FLAG, name), fValue ? uint8_t{'1'} : uint8_t{'0'});
@@ -154,6 +191,136 @@ bool BlockTreeDB::LoadBlockIndexGuts(const Consensus::Params& consensusParams, s
 
 namespace node {
 
+/*
+ * The snapshot file consists of a header (magic, version, id, hash of the last
+ * block file info, number of entries), the fixed-size entries, and a SHA256
+ * checksum of the entries.
+ */
+static constexpr std::array<uint8_t, 4> BLOCK_INDEX_SNAPSHOT_MAGIC{'x', 'b', 'i', 's'};
+static constexpr uint16_t BLOCK_INDEX_SNAPSHOT_VERSION{2};
+static constexpr size_t BLOCK_INDEX_SNAPSHOT_HEADER_SIZE{4 + 2 + 32 + 32 + 8};
+static constexpr size_t BLOCK_INDEX_SNAPSHOT_ENTRY_SIZE{32 + 4 + 5 * 4 + 32 + 4 * 4 + 1 + 4};
+static constexpr size_t BLOCK_INDEX_SNAPSHOT_CHECKSUM_SIZE{32};
+//! Entry position marking the genesis block's missing predecessor
+static constexpr uint32_t BLOCK_INDEX_SNAPSHOT_NO_PREV{std::numeric_limits<uint32_t>::max()};
+
+bool WriteBlockIndexSnapshot(const fs::path& path, const uint256& id, const uint256& block_files_hash, const std::vector<CBlockIndex*>& sorted_by_height)
+{
+    AssertLockHeld(::cs_main);
+    // Predecessors are stored as their position in the file
+    std::unordered_map<const CBlockIndex*, uint32_t> positions;
+    positions.reserve(sorted_by_height.size());
+
+    const fs::path tmp_path{path + ".tmp"};
+    AutoFile file{fsbridge::fopen(tmp_path, "wb")};
+    if (file.IsNull()) {
+        LogError("%s: failed to open %s\n", __func__, fs::PathToString(tmp_path));
+        return false;
+    }
+    try {
+        DataStream buffer;
+        buffer << BLOCK_INDEX_SNAPSHOT_MAGIC << BLOCK_INDEX_SNAPSHOT_VERSION << id << block_files_hash << uint64_t{sorted_by_height.size()};
+        file.write(buffer);
+        buffer.clear();
+        HashWriter checksum{};
+        for (const CBlockIndex* pindex : sorted_by_height) {
+            uint32_t prev{BLOCK_INDEX_SNAPSHOT_NO_PREV};
+            if (pindex->pprev) prev = positions.at(pindex->pprev);
+            positions.emplace(pindex, positions.size());
+            buffer << pindex->GetBlockHash() << prev << pindex->nHeight << pindex->nFile << pindex->nDataPos
+                   << pindex->nUndoPos << pindex->nVersion << pindex->hashMerkleRoot << pindex->nTime
+                   << pindex->nBits << pindex->nNonce << pindex->nStatus << static_cast<uint8_t>(pindex->algo)
+                   << pindex->nTx;
+            if (buffer.size() >= (1 << 20)) {
+                checksum.write(buffer);
+                file.write(buffer);
+                buffer.clear();
+            }
+        }
+        checksum.write(buffer);
+        buffer << checksum.GetSHA256();
+        file.write(buffer);
+    } catch (const std::exception& e) {
+        LogError("%s: failed to write %s: %s\n", __func__, fs::PathToString(tmp_path), e.what());
+        return false;
+    }
+    if (!file.Commit() || file.fclose() != 0) {
+        LogError("%s: failed to write %s\n", __func__, fs::PathToString(tmp_path));
+        return false;
+    }
+    if (!RenameOver(tmp_path, path)) {
+        LogError("%s: failed to rename %s\n", __func__, fs::PathToString(tmp_path));
+        return false;
+    }
+    DirectoryCommit(path.parent_path());
+    return true;
+}
+
+std::optional<std::vector<CBlockIndex*>> ReadBlockIndexSnapshot(const fs::path& path, const uint256& id, const uint256& block_files_hash, const std::function<void(size_t)>& reserve, const std::function<CBlockIndex*(const uint256&)>& insert_block_index)
+{
+    AssertLockHeld(::cs_main);
+    AutoFile file{fsbridge::fopen(path, "rb")};
+    if (file.IsNull()) return std::nullopt;
+
+    try {
+        std::array<uint8_t, 4> magic;
+        uint16_t version;
+        uint256 file_id;
+        uint256 file_block_files_hash;
+        uint64_t count;
+        if (fs::file_size(path) < BLOCK_INDEX_SNAPSHOT_HEADER_SIZE) return std::nullopt;
+        file >> magic >> version >> file_id >> file_block_files_hash >> count;
+        // Blocks stored since the snapshot was written, e.g. by a version that
+        // does not know about it, change the info of the last block file.
+        if (magic != BLOCK_INDEX_SNAPSHOT_MAGIC || version != BLOCK_INDEX_SNAPSHOT_VERSION || file_id != id ||
+            file_block_files_hash != block_files_hash || count == 0 || count >= BLOCK_INDEX_SNAPSHOT_NO_PREV ||
+            fs::file_size(path) != BLOCK_INDEX_SNAPSHOT_HEADER_SIZE + count * BLOCK_INDEX_SNAPSHOT_ENTRY_SIZE + BLOCK_INDEX_SNAPSHOT_CHECKSUM_SIZE) {
+            LogPrintf("Block index snapshot %s does not match the block tree database, ignoring it\n", fs::PathToString(path));
+            return std::nullopt;
+        }
+
+        // Read and hash the entries in chunks, so that the file never has to
+        // be in memory as a whole
+        reserve(count);
+        std::vector<CBlockIndex*> entries;
+        entries.reserve(count);
+        HashWriter hasher{};
+        std::vector<std::byte> chunk;
+        constexpr uint64_t CHUNK_ENTRIES{(1 << 20) / BLOCK_INDEX_SNAPSHOT_ENTRY_SIZE};
+        for (uint64_t i = 0; i < count;) {
+            chunk.resize(std::min(CHUNK_ENTRIES, count - i) * BLOCK_INDEX_SNAPSHOT_ENTRY_SIZE);
+            file.read(chunk);
+            hasher.write(chunk);
+            SpanReader reader{chunk};
+            for (; !reader.empty(); ++i) {
+                uint256 hash;
+                uint32_t prev;
+                uint8_t algo;
+                reader >> hash >> prev;
+                if (prev != BLOCK_INDEX_SNAPSHOT_NO_PREV && prev >= i) return std::nullopt;
+                CBlockIndex* pindex{insert_block_index(hash)};
+                pindex->pprev = prev == BLOCK_INDEX_SNAPSHOT_NO_PREV ? nullptr : entries[prev];
+                reader >> pindex->nHeight >> pindex->nFile >> pindex->nDataPos >> pindex->nUndoPos >> pindex->nVersion
+                       >> pindex->hashMerkleRoot >> pindex->nTime >> pindex->nBits >> pindex->nNonce >> pindex->nStatus
+                       >> algo >> pindex->nTx;
+                pindex->algo = static_cast<PowAlgo>(algo);
+                if (pindex->pprev && pindex->nHeight != pindex->pprev->nHeight + 1) return std::nullopt;
+                entries.push_back(pindex);
+            }
+        }
+        uint256 checksum;
+        file >> checksum;
+        if (hasher.GetSHA256() != checksum) {
+            LogPrintf("Block index snapshot %s is corrupted, ignoring it\n", fs::PathToString(path));
+            return std::nullopt;
+        }
+        return entries;
+    } catch (const std::exception& e) {
+        LogError("%s: failed to read %s: %s\n", __func__, fs::PathToString(path), e.what());
+        return std::nullopt;
+    }
+}
+
 bool CBlockIndexWorkComparator::operator()(const CBlockIndex* pa, const CBlockIndex* pb) const
 {
     // First sort by most total work, ...
@@ -398,7 +565,36 @@ CBlockIndex* BlockManager::InsertBlockIndex(const uint256& hash)
 
 bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockhash)
 {
-    if (!m_block_tree_db->LoadBlockIndexGuts(
+    // Entries sorted by height, if they were loaded from the block index
+    // snapshot file
+    std::optional<std::vector<CBlockIndex*>> snapshot_entries;
+    uint256 snapshot_id;
+    if (m_block_index.empty() && m_block_tree_db->ReadBlockIndexSnapshotId(snapshot_id)) {
+        // The snapshot is used at most once, and only a clean shutdown makes
+        // a new one valid. Block index changes after this point cannot leave
+        // a stale snapshot behind, even if they are made without erasing it.
+        if (!m_block_tree_db->EraseBlockIndexSnapshotId()) return false;
+        snapshot_entries = ReadBlockIndexSnapshot(
+            m_opts.blocks_dir / BLOCK_INDEX_SNAPSHOT_FILENAME, snapshot_id, m_block_tree_db->HashLastBlockFile(),
+            [this](size_t count) EXCLUSIVE_LOCKS_REQUIRED(cs_main) { m_block_index.reserve(count); },
+            [this](const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main) { return this->InsertBlockIndex(hash); });
+        if (snapshot_entries) {
+            // The entry with the greatest height must match the database
+            const CBlockIndex& tip{*snapshot_entries->back()};
+            CDiskBlockIndex disk_tip;
+            if (!m_block_tree_db->ReadBlockIndex(tip.GetBlockHash(), disk_tip) ||
+                (DataStream{} << disk_tip).str() != (DataStream{} << CDiskBlockIndex{&tip}).str()) {
+                LogPrintf("Block index snapshot does not match the block tree database at %s, ignoring it\n", tip.GetBlockHash().ToString());
+                snapshot_entries.reset();
+            }
+        }
+        if (snapshot_entries) {
+            LogPrintf("Loaded %d block index entries from snapshot\n", snapshot_entries->size());
+        } else {
+            m_block_index.clear();
+        }
+    }
+    if (!snapshot_entries && !m_block_tree_db->LoadBlockIndexGuts(
             GetConsensus(), [this](const uint256& hash) EXCLUSIVE_LOCKS_REQUIRED(cs_main) { return this->InsertBlockIndex(hash); }, m_interrupt)) {
         return false;
     }
@@ -428,9 +624,14 @@ bool BlockManager::LoadBlockIndex(const std::optional<uint256>& snapshot_blockha
     Assert(m_snapshot_height.has_value() == snapshot_blockhash.has_value());
 
     // Calculate nChainWork
-    std::vector<CBlockIndex*> vSortedByHeight{GetAllBlockIndices()};
-    std::sort(vSortedByHeight.begin(), vSortedByHeight.end(),
-              CBlockIndexHeightOnlyComparator());
+    std::vector<CBlockIndex*> vSortedByHeight;
+    if (snapshot_entries) {
+        vSortedByHeight = std::move(*snapshot_entries);
+    } else {
+        vSortedByHeight = GetAllBlockIndices();
+        std::sort(vSortedByHeight.begin(), vSortedByHeight.end(),
+                  CBlockIndexHeightOnlyComparator());
+    }
 
     CBlockIndex* previous_index{nullptr};
     for (CBlockIndex* pindex : vSortedByHeight) {
@@ -497,6 +698,24 @@ bool BlockManager::WriteBlockIndexDB()
     return true;
 }
 
+bool BlockManager::WriteBlockIndexSnapshot()
+{
+    AssertLockHeld(::cs_main);
+    // The snapshot must match the entries in the block tree database
+    if (m_opts.block_tree_db_params.memory_only || !m_dirty_blockindex.empty() || !m_dirty_fileinfo.empty()) return false;
+
+    std::vector<CBlockIndex*> sorted_by_height{GetAllBlockIndices()};
+    if (sorted_by_height.empty()) return false;
+    std::sort(sorted_by_height.begin(), sorted_by_height.end(), CBlockIndexHeightOnlyComparator());
+    const uint256 id{GetRandHash()};
+    if (!node::WriteBlockIndexSnapshot(m_opts.blocks_dir / BLOCK_INDEX_SNAPSHOT_FILENAME, id, m_block_tree_db->HashLastBlockFile(), sorted_by_height)) {
+        return false;
+    }
+    if (!m_block_tree_db->WriteBlockIndexSnapshotId(id)) return false;
+    LogPrintf("Wrote %d block index entries to snapshot\n", sorted_by_height.size());
+    return true;
+}
+
 bool BlockManager::LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
 {
     if (!LoadBlockIndex(snapshot_blockhash)) {
@@ -61,12 +61,40 @@ public:
     bool ReadFlag(const std::string& name, bool& fValue);
     bool LoadBlockIndexGuts(const Consensus::Params& consensusParams, std::function<CBlockIndex*(const uint256&)> insertBlockIndex, const util::SignalInterrupt& interrupt)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+    /** Id of the block index snapshot that matches the block index entries, if they did not change since it was written */
+    bool ReadBlockIndexSnapshotId(uint256& id);
+    bool WriteBlockIndexSnapshotId(const uint256& id);
+    bool EraseBlockIndexSnapshotId();
+    bool ReadBlockIndex(const uint256& hash, CDiskBlockIndex& index);
+    /** Hash of the info of the last block file, which changes whenever a block is stored */
+    uint256 HashLastBlockFile();
 };
 } // namespace kernel
 
 namespace node {
 using kernel::BlockTreeDB;
 
+/** Name of the block index snapshot file in the blocks directory */
+static const fs::path BLOCK_INDEX_SNAPSHOT_FILENAME{"blockindex.dat"};
+
+/**
+ * Write block index entries, which must be sorted by height, to a snapshot
+ * file tagged with the given id and BlockTreeDB::HashLastBlockFile(). Loading
+ * the snapshot avoids reading and hashing each entry in the block tree
+ * database.
+ */
+bool WriteBlockIndexSnapshot(const fs::path& path, const uint256& id, const uint256& block_files_hash, const std::vector<CBlockIndex*>& sorted_by_height)
+    EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+/**
+ * Read a block index snapshot written with the given id and block files hash.
+ * The number of entries is passed to reserve first, then the entries are
+ * created through insert_block_index and returned in height order. Returns
+ * nullopt if the file does not exist, does not match, fails its checksum or
+ * is malformed, in which case entries may already have been created.
+ */
+std::optional<std::vector<CBlockIndex*>> ReadBlockIndexSnapshot(const fs::path& path, const uint256& id, const uint256& block_files_hash, const std::function<void(size_t)>& reserve, const std::function<CBlockIndex*(const uint256&)>& insert_block_index)
+    EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
 /** The pre-allocation chunk size for blk?????.dat files (since 0.8) */
 static const unsigned int BLOCKFILE_CHUNK_SIZE = 0x1000000; // 16 MiB
 /** The pre-allocation chunk size for rev?????.dat files (since 0.8) */
@@ -308,6 +336,13 @@ public:
     bool LoadBlockIndexDB(const std::optional<uint256>& snapshot_blockhash)
         EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
 
+    /**
+     * Write the block index to a snapshot file, which is loaded instead of the
+     * block tree database on the next start if no entry changed in between.
+     * Meant to be called on shutdown, after the block index was flushed.
+     */
+    bool WriteBlockIndexSnapshot() EXCLUSIVE_LOCKS_REQUIRED(::cs_main);
+
     /**
      * Remove any pruned block & undo files that are still on disk.
      * This could happen on some systems if the file was still being read while unlinked,
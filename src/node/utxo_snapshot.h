@@ -32,7 +32,8 @@ namespace node {
 //! before being used. Thus, new fields should be added only if needed.
 class SnapshotMetadata
 {
-    inline static const uint16_t VERSION{2};
+    //! Version 3 adds the name database section after the coins.
+    inline static const uint16_t VERSION{3};
     const std::set<uint16_t> m_supported_versions{VERSION};
     const MessageStartChars m_network_magic;
 public:
@@ -45,16 +46,23 @@ public:
     //! during snapshot load to estimate progress of UTXO set reconstruction.
     uint64_t m_coins_count = 0;
 
+    //! The number of name database entries following the coins. These are
+    //! not trusted as such, but checked against the name outputs in the
+    //! (hash-committed) UTXO set when the snapshot is loaded.
+    uint64_t m_names_count = 0;
+
     SnapshotMetadata(
         const MessageStartChars network_magic) :
             m_network_magic(network_magic) { }
     SnapshotMetadata(
         const MessageStartChars network_magic,
         const uint256& base_blockhash,
-        uint64_t coins_count) :
+        uint64_t coins_count,
+        uint64_t names_count = 0) :
             m_network_magic(network_magic),
             m_base_blockhash(base_blockhash),
-            m_coins_count(coins_count) { }
+            m_coins_count(coins_count),
+            m_names_count(names_count) { }
 
     template <typename Stream>
     inline void Serialize(Stream& s) const {
@@ -63,6 +71,7 @@ public:
         s << m_network_magic;
         s << m_base_blockhash;
         s << m_coins_count;
+        s << m_names_count;
     }
 
     template <typename Stream>
@@ -98,6 +107,7 @@ public:
 
         s >> m_base_blockhash;
         s >> m_coins_count;
+        s >> m_names_count;
     }
 };
 
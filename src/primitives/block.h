@@ -69,9 +69,21 @@ public:
         *(static_cast<CBlockHeader*>(this)) = header;
     }
 
-    SERIALIZE_METHODS(CBlock, obj)
+    template <typename Stream>
+    void Serialize(Stream& s) const
     {
-        READWRITE(AsBase<CBlockHeader>(obj), obj.vtx);
+        s << AsBase<CBlockHeader>(*this) << vtx;
+    }
+
+    template <typename Stream>
+    void Unserialize(Stream& s)
+    {
+        s >> AsBase<CBlockHeader>(*this);
+        // Read all transactions before converting them, so that their
+        // hashes are computed in one batch.
+        std::vector<CMutableTransaction> txs;
+        s >> txs;
+        vtx = MakeTransactionRefs(std::move(txs));
     }
 
     void SetNull()
@@ -7,17 +7,25 @@
 
 #include <consensus/amount.h>
 #include <crypto/hex_base.h>
+#include <crypto/sha256.h>
 #include <hash.h>
 #include <script/names.h>
 #include <script/script.h>
 #include <serialize.h>
+#include <streams.h>
+#include <sync.h>
 #include <tinyformat.h>
 #include <uint256.h>
+#include <util/threadnames.h>
 #include <util/transaction_identifier.h>
 
 #include <algorithm>
 #include <cassert>
+#include <condition_variable>
+#include <deque>
+#include <span>
 #include <stdexcept>
+#include <thread>
 
 std::string COutPoint::ToString() const
 {
@@ -103,6 +111,189 @@ uint256 CTransaction::GetBareHash() const
 
 CTransaction::CTransaction(const CMutableTransaction& tx) : vin(tx.vin), vout(tx.vout), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
 CTransaction::CTransaction(CMutableTransaction&& tx) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{ComputeHash()}, m_witness_hash{ComputeWitnessHash()} {}
+CTransaction::CTransaction(CMutableTransaction&& tx, const Txid& txid, const Wtxid& wtxid) : vin(std::move(tx.vin)), vout(std::move(tx.vout)), version{tx.version}, nLockTime{tx.nLockTime}, m_has_witness{ComputeHasWitness()}, hash{txid}, m_witness_hash{wtxid} {}
+
+namespace {
+
+/** SHA256DMulti work for one call to MakeTransactionRefs, split into chunks
+ *  that are hashed independently by the calling thread and the workers. */
+struct HashBatch
+{
+    std::span<const std::span<const unsigned char>> messages;
+    unsigned char* output;
+    //! Chunk i covers the messages [bounds[i], bounds[i + 1]).
+    std::vector<size_t> bounds;
+    //! Guarded by TxHashWorkers::m_mutex.
+    size_t next_chunk{0};
+    size_t chunks_done{0};
+
+    size_t Chunks() const { return bounds.size() - 1; }
+
+    void Hash(size_t chunk) const
+    {
+        SHA256DMulti(output + CSHA256::OUTPUT_SIZE * bounds[chunk],
+                     messages.subspan(bounds[chunk], bounds[chunk + 1] - bounds[chunk]));
+    }
+};
+
+/** Worker threads that help MakeTransactionRefs hash large batches.
+ *
+ *  The calling thread hashes chunks of its own batch as well, and finishes
+ *  any that no worker has picked up yet.  So a batch never waits for workers
+ *  that are busy with other batches, and it is always safe to stop them. */
+class TxHashWorkers
+{
+private:
+    //! Batches smaller than this are not worth the hand-off.
+    static constexpr size_t MIN_PARALLEL_BYTES{32 << 10};
+    //! Minimum size of a chunk.
+    static constexpr size_t MIN_CHUNK_BYTES{16 << 10};
+
+    Mutex m_mutex;
+    //! Signalled when batches are queued or the workers should stop.
+    std::condition_variable m_work_cond;
+    //! Signalled when a chunk is done.
+    std::condition_variable m_done_cond;
+    //! Batches with chunks that have not been claimed yet.
+    std::deque<HashBatch*> m_queue GUARDED_BY(m_mutex);
+    std::vector<std::thread> m_threads GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+
+    void Loop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_work_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_queue.empty(); });
+            if (m_stop) return;
+            HashBatch& batch{*m_queue.front()};
+            const size_t chunk{batch.next_chunk++};
+            if (batch.next_chunk == batch.Chunks()) m_queue.pop_front();
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                batch.Hash(chunk);
+            }
+            if (++batch.chunks_done == batch.Chunks()) m_done_cond.notify_all();
+        }
+    }
+
+public:
+    ~TxHashWorkers() { Stop(); }
+
+    void Start(int threads) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        Stop();
+        LOCK(m_mutex);
+        for (int n = 0; n < threads; ++n) {
+            m_threads.emplace_back([this, n]() {
+                util::ThreadRename(strprintf("txhash.%i", n));
+                Loop();
+            });
+        }
+    }
+
+    void Stop() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<std::thread> threads;
+        {
+            LOCK(m_mutex);
+            m_stop = true;
+            threads.swap(m_threads);
+        }
+        m_work_cond.notify_all();
+        for (auto& thread : threads) thread.join();
+        LOCK(m_mutex);
+        m_stop = false;
+    }
+
+    /** Hash the messages like SHA256DMulti, using the workers if that is
+     *  worthwhile.  Returns false (without hashing) otherwise. */
+    bool Hash(unsigned char* output, std::span<const std::span<const unsigned char>> messages, size_t total_bytes) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        if (total_bytes < MIN_PARALLEL_BYTES) return false;
+        WAIT_LOCK(m_mutex, lock);
+        if (m_threads.empty()) return false;
+
+        HashBatch batch{.messages = messages, .output = output, .bounds = {0}};
+        const size_t chunk_bytes{std::max(MIN_CHUNK_BYTES, total_bytes / (2 * (m_threads.size() + 1)))};
+        size_t bytes{0};
+        for (size_t i = 0; i < messages.size(); ++i) {
+            bytes += messages[i].size();
+            if (bytes >= chunk_bytes && i + 1 < messages.size()) {
+                batch.bounds.push_back(i + 1);
+                bytes = 0;
+            }
+        }
+        batch.bounds.push_back(messages.size());
+
+        m_queue.push_back(&batch);
+        m_work_cond.notify_all();
+        while (batch.next_chunk < batch.Chunks()) {
+            const size_t chunk{batch.next_chunk++};
+            if (batch.next_chunk == batch.Chunks()) std::erase(m_queue, &batch);
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                batch.Hash(chunk);
+            }
+            ++batch.chunks_done;
+        }
+        m_done_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return batch.chunks_done == batch.Chunks(); });
+        return true;
+    }
+};
+
+TxHashWorkers g_tx_hash_workers;
+
+} // namespace
+
+void StartTransactionHashThreads(int threads)
+{
+    g_tx_hash_workers.Start(threads);
+}
+
+void StopTransactionHashThreads()
+{
+    g_tx_hash_workers.Stop();
+}
+
+std::vector<CTransactionRef> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs)
+{
+    // Serialize the txid (and for witness transactions also the wtxid)
+    // preimages of all transactions into one buffer.  first_message[i] is
+    // the index of the txid preimage of txs[i]; the wtxid preimage, if any,
+    // follows it directly.
+    std::vector<unsigned char> buffer;
+    std::vector<size_t> offsets{0};
+    std::vector<size_t> first_message;
+    first_message.reserve(txs.size());
+    for (const auto& tx : txs) {
+        first_message.push_back(offsets.size() - 1);
+        VectorWriter{buffer, buffer.size(), TX_NO_WITNESS(tx)};
+        offsets.push_back(buffer.size());
+        if (tx.HasWitness()) {
+            VectorWriter{buffer, buffer.size(), TX_WITH_WITNESS(tx)};
+            offsets.push_back(buffer.size());
+        }
+    }
+
+    std::vector<std::span<const unsigned char>> messages;
+    messages.reserve(offsets.size() - 1);
+    for (size_t i = 0; i + 1 < offsets.size(); ++i) {
+        messages.emplace_back(buffer.data() + offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    std::vector<uint256> hashes(messages.size());
+    if (!hashes.empty() && !g_tx_hash_workers.Hash(hashes[0].begin(), messages, buffer.size())) {
+        SHA256DMulti(hashes[0].begin(), messages);
+    }
+
+    std::vector<CTransactionRef> ret;
+    ret.reserve(txs.size());
+    for (size_t i = 0; i < txs.size(); ++i) {
+        const uint256& txid = hashes[first_message[i]];
+        const uint256& wtxid = txs[i].HasWitness() ? hashes[first_message[i] + 1] : txid;
+        ret.push_back(std::make_shared<const CTransaction>(std::move(txs[i]), Txid::FromUint256(txid), Wtxid::FromUint256(wtxid)));
+    }
+    return ret;
+}
 
 CAmount CTransaction::GetValueOut(bool fExcludeNames) const
 {
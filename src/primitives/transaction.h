@@ -324,6 +324,9 @@ public:
     /** Convert a CMutableTransaction into a CTransaction. */
     explicit CTransaction(const CMutableTransaction& tx);
     explicit CTransaction(CMutableTransaction&& tx);
+    /** Convert a CMutableTransaction whose txid and wtxid have already been
+     *  computed (see MakeTransactionRefs).  The hashes are not verified. */
+    CTransaction(CMutableTransaction&& tx, const Txid& txid, const Wtxid& wtxid);
 
     template <typename Stream>
     inline void Serialize(Stream& s) const {
@@ -433,6 +436,19 @@ struct CMutableTransaction
 typedef std::shared_ptr<const CTransaction> CTransactionRef;
 template <typename Tx> static inline CTransactionRef MakeTransactionRef(Tx&& txIn) { return std::make_shared<const CTransaction>(std::forward<Tx>(txIn)); }
 
+/** Convert many CMutableTransactions at once.  This is equivalent to calling
+ *  MakeTransactionRef on each of them, but computes all txids and wtxids in
+ *  one batch with SHA256DMulti, which is considerably faster for e.g. the
+ *  transactions of a full block. */
+std::vector<CTransactionRef> MakeTransactionRefs(std::vector<CMutableTransaction>&& txs);
+
+/** Start worker threads that help MakeTransactionRefs hash large batches,
+ *  such as the transactions of a block, in parallel.  Without them (the
+ *  default), all hashing happens on the calling thread. */
+void StartTransactionHashThreads(int threads);
+/** Stop the threads started by StartTransactionHashThreads. */
+void StopTransactionHashThreads();
+
 /** A generic txid reference (txid or wtxid). */
 class GenTxid
 {
@@ -10,6 +10,7 @@
 #include <secp256k1_ellswift.h>
 #include <secp256k1_extrakeys.h>
 #include <secp256k1_recovery.h>
+#include <schnorrsig_batch/schnorrsig_batch.h>
 #include <secp256k1_schnorrsig.h>
 #include <span.h>
 #include <uint256.h>
@@ -235,6 +236,19 @@ bool XOnlyPubKey::VerifySchnorr(const uint256& msg, std::span<const unsigned cha
     return secp256k1_schnorrsig_verify(secp256k1_context_static, sigbytes.data(), msg.begin(), 32, &pubkey);
 }
 
+bool VerifySchnorrBatch(std::span<const SchnorrSignatureCheck> checks)
+{
+    std::vector<const unsigned char*> pubkeys(checks.size());
+    std::vector<const unsigned char*> sigs(checks.size());
+    std::vector<const unsigned char*> msgs(checks.size());
+    for (size_t i = 0; i < checks.size(); ++i) {
+        pubkeys[i] = checks[i].pubkey.data();
+        sigs[i] = checks[i].sig.data();
+        msgs[i] = checks[i].msg.begin();
+    }
+    return schnorrsig_verify_batch(sigs.data(), msgs.data(), pubkeys.data(), checks.size());
+}
+
 static const HashWriter HASHER_TAPTWEAK{TaggedHash("TapTweak")};
 
 uint256 XOnlyPubKey::ComputeTapTweakHash(const uint256* merkle_root) const
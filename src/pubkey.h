@@ -305,6 +305,19 @@ public:
     SERIALIZE_METHODS(XOnlyPubKey, obj) { READWRITE(obj.m_keydata); }
 };
 
+/** A Schnorr signature, the message it signs and the key to check it against. */
+struct SchnorrSignatureCheck
+{
+    XOnlyPubKey pubkey;
+    uint256 msg;
+    std::array<unsigned char, 64> sig;
+};
+
+/** Verify many Schnorr signatures at once.  This is equivalent to (but for
+ *  large batches faster than) calling XOnlyPubKey::VerifySchnorr on each of
+ *  them, except that it only tells whether all of them are valid. */
+bool VerifySchnorrBatch(std::span<const SchnorrSignatureCheck> checks);
+
 /** An ElligatorSwift-encoded public key. */
 struct EllSwiftPubKey
 {
@@ -58,13 +58,16 @@
 #include <validationinterface.h>
 #include <versionbits.h>
 
+#include <algorithm>
 #include <cstdint>
 
 #include <condition_variable>
+#include <exception>
 #include <iterator>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <thread>
 #include <vector>
 
 using kernel::CCoinsStats;
@@ -77,7 +80,12 @@ using node::NodeContext;
 using node::SnapshotMetadata;
 using util::MakeUnorderedList;
 
-std::tuple<std::unique_ptr<CCoinsViewCursor>, CCoinsStats, const CBlockIndex*>
+//! Number of UTXO set ranges that are serialized independently for a snapshot
+static constexpr size_t SNAPSHOT_WRITE_RANGES{256};
+//! Maximum number of threads serializing the coins of a snapshot
+static constexpr unsigned int MAX_SNAPSHOT_WRITE_THREADS{8};
+
+std::tuple<std::vector<std::unique_ptr<CCoinsViewCursor>>, std::unique_ptr<CNameIterator>, CCoinsStats, const CBlockIndex*>
 PrepareUTXOSnapshot(
     Chainstate& chainstate,
     const std::function<void()>& interruption_point = {})
@@ -85,7 +93,8 @@ PrepareUTXOSnapshot(
 
 UniValue WriteUTXOSnapshot(
     Chainstate& chainstate,
-    CCoinsViewCursor* pcursor,
+    const std::vector<std::unique_ptr<CCoinsViewCursor>>& cursors,
+    CNameIterator* pnames,
     CCoinsStats* maybe_stats,
     const CBlockIndex* tip,
     AutoFile& afile,
@@ -250,13 +259,44 @@ UniValue blockheaderToJSON(const BlockManager& blockman, const CBlockIndex& tip,
     return result;
 }
 
-UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity)
+/** Converts a block's header and size information to JSON.  */
+static UniValue blockInfoToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex)
 {
     UniValue result = blockheaderToJSON(blockman, tip, blockindex);
 
     result.pushKV("strippedsize", (int)::GetSerializeSize(TX_NO_WITNESS(block)));
     result.pushKV("size", (int)::GetSerializeSize(TX_WITH_WITNESS(block)));
     result.pushKV("weight", (int)::GetBlockWeight(block));
+
+    return result;
+}
+
+/** Reads the undo data of a block for showing prevouts, if it is available.
+ * Returns false if the block has no undo data.  */
+static bool ReadBlockUndoForJSON(BlockManager& blockman, const CBlockIndex& blockindex, CBlockUndo& blockUndo)
+{
+    const bool is_not_pruned{WITH_LOCK(::cs_main, return !blockman.IsBlockPruned(blockindex))};
+    bool have_undo{is_not_pruned && WITH_LOCK(::cs_main, return blockindex.nStatus & BLOCK_HAVE_UNDO)};
+    if (have_undo && !blockman.ReadBlockUndo(blockUndo, blockindex)) {
+        throw JSONRPCError(RPC_INTERNAL_ERROR, "Undo data expected but can't be read. This could be due to disk corruption or a conflict with a pruning event.");
+    }
+    return have_undo;
+}
+
+/** Converts the i-th transaction of a block to JSON, with details.  */
+static UniValue blockTxToJSON(const CBlock& block, size_t i, const CBlockUndo* blockUndo, TxVerbosity verbosity)
+{
+    const CTransactionRef& tx = block.vtx.at(i);
+    // coinbase transaction (i.e. i == 0) doesn't have undo data
+    const CTxUndo* txundo = (blockUndo && i > 0) ? &blockUndo->vtxundo.at(i - 1) : nullptr;
+    UniValue objTx(UniValue::VOBJ);
+    TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true, txundo, verbosity);
+    return objTx;
+}
+
+UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity)
+{
+    UniValue result = blockInfoToJSON(blockman, block, tip, blockindex);
     UniValue txs(UniValue::VARR);
 
     switch (verbosity) {
@@ -269,18 +309,9 @@ UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIn
         case TxVerbosity::SHOW_DETAILS:
         case TxVerbosity::SHOW_DETAILS_AND_PREVOUT:
             CBlockUndo blockUndo;
-            const bool is_not_pruned{WITH_LOCK(::cs_main, return !blockman.IsBlockPruned(blockindex))};
-            bool have_undo{is_not_pruned && WITH_LOCK(::cs_main, return blockindex.nStatus & BLOCK_HAVE_UNDO)};
-            if (have_undo && !blockman.ReadBlockUndo(blockUndo, blockindex)) {
-                throw JSONRPCError(RPC_INTERNAL_ERROR, "Undo data expected but can't be read. This could be due to disk corruption or a conflict with a pruning event.");
-            }
+            const bool have_undo{ReadBlockUndoForJSON(blockman, blockindex, blockUndo)};
             for (size_t i = 0; i < block.vtx.size(); ++i) {
-                const CTransactionRef& tx = block.vtx.at(i);
-                // coinbase transaction (i.e. i == 0) doesn't have undo data
-                const CTxUndo* txundo = (have_undo && i > 0) ? &blockUndo.vtxundo.at(i - 1) : nullptr;
-                UniValue objTx(UniValue::VOBJ);
-                TxToUniv(*tx, /*block_hash=*/uint256(), /*entry=*/objTx, /*include_hex=*/true, txundo, verbosity);
-                txs.push_back(std::move(objTx));
+                txs.push_back(blockTxToJSON(block, i, have_undo ? &blockUndo : nullptr, verbosity));
             }
             break;
     }
@@ -292,6 +323,31 @@ UniValue blockToJSON(BlockManager& blockman, const CBlock& block, const CBlockIn
     return result;
 }
 
+/** Sends the same result as blockToJSON with transaction details (plus the
+ * given powdata) to a result stream, converting one transaction at a time.  */
+static void streamBlockToJSON(JSONRPCResultStream& stream, BlockManager& blockman, const CBlock& block, const CBlockIndex& tip, const CBlockIndex& blockindex, TxVerbosity verbosity, const UniValue& powdata)
+{
+    const UniValue info = blockInfoToJSON(blockman, block, tip, blockindex);
+    CBlockUndo blockUndo;
+    const bool have_undo{ReadBlockUndoForJSON(blockman, blockindex, blockUndo)};
+
+    // Errors after this point can no longer be reported to the client.
+    JSONStreamWriter& writer = stream.Start();
+    writer.BeginObject();
+    for (size_t i = 0; i < info.size(); ++i) {
+        writer.KeyValue(info.getKeys()[i], info.getValues()[i]);
+    }
+    writer.Key("tx");
+    writer.BeginArray();
+    for (size_t i = 0; i < block.vtx.size(); ++i) {
+        writer.Value(blockTxToJSON(block, i, have_undo ? &blockUndo : nullptr, verbosity));
+    }
+    writer.EndArray();
+    writer.KeyValue("rngseed", block.GetRngSeed().GetHex());
+    writer.KeyValue("powdata", powdata);
+    writer.EndObject();
+}
+
 UniValue AuxpowToJSON(const CAuxPow& auxpow, const bool verbose, Chainstate& active_chainstate)
 {
     UniValue result(UniValue::VOBJ);
@@ -986,8 +1042,15 @@ static RPCHelpMan getblock()
         tx_verbosity = TxVerbosity::SHOW_DETAILS_AND_PREVOUT;
     }
 
+    UniValue powdata = PowDataToJSON(block.pow, verbosity >= 1, chainman.ActiveChainstate(), powLimitForAlgo (block.pow.getCoreAlgo(), chainman.GetParams().GetConsensus()));
+
+    if (tx_verbosity != TxVerbosity::SHOW_TXID && request.m_result_stream) {
+        streamBlockToJSON(*request.m_result_stream, chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity, powdata);
+        return NullUniValue;
+    }
+
     auto result = blockToJSON(chainman.m_blockman, block, *tip, *pblockindex, tx_verbosity);
-    result.pushKV("powdata", PowDataToJSON(block.pow, verbosity >= 1, chainman.ActiveChainstate(), powLimitForAlgo (block.pow.getCoreAlgo(), chainman.GetParams().GetConsensus())));
+    result.pushKV("powdata", std::move(powdata));
 
     return result;
 },
@@ -3167,6 +3230,7 @@ static RPCHelpMan dumptxoutset()
             RPCResult::Type::OBJ, "", "",
                 {
                     {RPCResult::Type::NUM, "coins_written", "the number of coins written in the snapshot"},
+                    {RPCResult::Type::NUM, "names_written", "the number of name database entries written in the snapshot"},
                     {RPCResult::Type::STR_HEX, "base_hash", "the hash of the base of the snapshot"},
                     {RPCResult::Type::NUM, "base_height", "the height of the base of the snapshot"},
                     {RPCResult::Type::STR, "path", "the absolute path that the snapshot was written to"},
@@ -3259,13 +3323,14 @@ static RPCHelpMan dumptxoutset()
     }
 
     Chainstate* chainstate;
-    std::unique_ptr<CCoinsViewCursor> cursor;
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    std::unique_ptr<CNameIterator> names;
     CCoinsStats stats;
     {
         // Lock the chainstate before calling PrepareUtxoSnapshot, to be able
         // to get a UTXO database cursor while the chain is pointing at the
         // target block. After that, release the lock while calling
-        // WriteUTXOSnapshot. The cursor will remain valid and be used by
+        // WriteUTXOSnapshot. The cursors will remain valid and be used by
         // WriteUTXOSnapshot to write a consistent snapshot even if the
         // chainstate changes.
         LOCK(node.chainman->GetMutex());
@@ -3280,11 +3345,11 @@ static RPCHelpMan dumptxoutset()
             LogWarning("dumptxoutset failed to roll back to requested height, reverting to tip.\n");
             throw JSONRPCError(RPC_MISC_ERROR, "Could not roll back to requested height.");
         } else {
-            std::tie(cursor, stats, tip) = PrepareUTXOSnapshot(*chainstate, node.rpc_interruption_point);
+            std::tie(cursors, names, stats, tip) = PrepareUTXOSnapshot(*chainstate, node.rpc_interruption_point);
         }
     }
 
-    UniValue result = WriteUTXOSnapshot(*chainstate, cursor.get(), &stats, tip, afile, path, temppath, node.rpc_interruption_point);
+    UniValue result = WriteUTXOSnapshot(*chainstate, cursors, names.get(), &stats, tip, afile, path, temppath, node.rpc_interruption_point);
     fs::rename(temppath, path);
 
     result.pushKV("path", path.utf8string());
@@ -3293,23 +3358,24 @@ static RPCHelpMan dumptxoutset()
     };
 }
 
-std::tuple<std::unique_ptr<CCoinsViewCursor>, CCoinsStats, const CBlockIndex*>
+std::tuple<std::vector<std::unique_ptr<CCoinsViewCursor>>, std::unique_ptr<CNameIterator>, CCoinsStats, const CBlockIndex*>
 PrepareUTXOSnapshot(
     Chainstate& chainstate,
     const std::function<void()>& interruption_point)
 {
-    std::unique_ptr<CCoinsViewCursor> pcursor;
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    std::unique_ptr<CNameIterator> pnames;
     std::optional<CCoinsStats> maybe_stats;
     const CBlockIndex* tip;
 
     {
         // We need to lock cs_main to ensure that the coinsdb isn't written to
         // between (i) flushing coins cache to disk (coinsdb), (ii) getting stats
-        // based upon the coinsdb, and (iii) constructing a cursor to the
-        // coinsdb for use in WriteUTXOSnapshot.
+        // based upon the coinsdb, and (iii) constructing cursors to the
+        // coins and names in the coinsdb for use in WriteUTXOSnapshot.
         //
         // Cursors returned by leveldb iterate over snapshots, so the contents
-        // of the pcursor will not be affected by simultaneous writes during
+        // of the cursors will not be affected by simultaneous writes during
         // use below this block.
         //
         // See discussion here:
@@ -3324,16 +3390,18 @@ PrepareUTXOSnapshot(
             throw JSONRPCError(RPC_INTERNAL_ERROR, "Unable to read UTXO set");
         }
 
-        pcursor = chainstate.CoinsDB().Cursor();
+        cursors = chainstate.CoinsDB().RangeCursors(SNAPSHOT_WRITE_RANGES);
+        pnames.reset(chainstate.CoinsDB().IterateNames());
         tip = CHECK_NONFATAL(chainstate.m_blockman.LookupBlockIndex(maybe_stats->hashBlock));
     }
 
-    return {std::move(pcursor), *CHECK_NONFATAL(maybe_stats), tip};
+    return {std::move(cursors), std::move(pnames), *CHECK_NONFATAL(maybe_stats), tip};
 }
 
 UniValue WriteUTXOSnapshot(
     Chainstate& chainstate,
-    CCoinsViewCursor* pcursor,
+    const std::vector<std::unique_ptr<CCoinsViewCursor>>& cursors,
+    CNameIterator* pnames,
     CCoinsStats* maybe_stats,
     const CBlockIndex* tip,
     AutoFile& afile,
@@ -3345,60 +3413,142 @@ UniValue WriteUTXOSnapshot(
         tip->nHeight, tip->GetBlockHash().ToString(),
         fs::PathToString(path), fs::PathToString(temppath)));
 
-    SnapshotMetadata metadata{chainstate.m_chainman.GetParams().MessageStart(), tip->GetBlockHash(), maybe_stats->coins_count};
+    // The name entries follow the coins, but their count is part of the metadata
+    valtype name;
+    CNameData name_data;
+    uint64_t names_count{0};
+    while (pnames->next(name, name_data)) {
+        if (++names_count % 5000 == 0) interruption_point();
+    }
+    pnames->seek(valtype());
 
-    afile << metadata;
+    SnapshotMetadata metadata{chainstate.m_chainman.GetParams().MessageStart(), tip->GetBlockHash(), maybe_stats->coins_count, names_count};
 
-    COutPoint key;
-    Txid last_hash;
-    Coin coin;
-    unsigned int iter{0};
-    size_t written_coins_count{0};
-    std::vector<std::pair<uint32_t, Coin>> coins;
+    afile << metadata;
 
     // To reduce space the serialization format of the snapshot avoids
     // duplication of tx hashes. The code takes advantage of the guarantee by
     // leveldb that keys are lexicographically sorted.
     // In the coins vector we collect all coins that belong to a certain tx hash
     // (key.hash) and when we have them all (key.hash != last_hash) we write
-    // them to file using the below lambda function.
+    // them to the buffer using the below lambda function.
     // See also https://github.com/bitcoin/bitcoin/issues/25675
-    auto write_coins_to_file = [&](AutoFile& afile, const Txid& last_hash, const std::vector<std::pair<uint32_t, Coin>>& coins, size_t& written_coins_count) {
-        afile << last_hash;
-        WriteCompactSize(afile, coins.size());
+    auto write_coins_to_buffer = [&](DataStream& buffer, const Txid& last_hash, const std::vector<std::pair<uint32_t, Coin>>& coins, size_t& written_coins_count) {
+        buffer << last_hash;
+        WriteCompactSize(buffer, coins.size());
         for (const auto& [n, coin] : coins) {
-            WriteCompactSize(afile, n);
-            afile << coin;
+            WriteCompactSize(buffer, n);
+            buffer << coin;
             ++written_coins_count;
         }
     };
 
-    pcursor->GetKey(key);
-    last_hash = key.hash;
-    while (pcursor->Valid()) {
-        if (iter % 5000 == 0) interruption_point();
-        ++iter;
-        if (pcursor->GetKey(key) && pcursor->GetValue(coin)) {
-            if (key.hash != last_hash) {
-                write_coins_to_file(afile, last_hash, coins, written_coins_count);
+    // Serializes the coins of one cursor range, which never splits the
+    // outputs of a transaction.
+    auto serialize_range = [&](CCoinsViewCursor& cursor, DataStream& buffer, size_t& written_coins_count) {
+        COutPoint key;
+        Txid last_hash;
+        Coin coin;
+        unsigned int iter{0};
+        std::vector<std::pair<uint32_t, Coin>> coins;
+
+        while (cursor.Valid()) {
+            if (iter % 5000 == 0) interruption_point();
+            ++iter;
+            if (cursor.GetKey(key) && cursor.GetValue(coin)) {
+                if (!coins.empty() && key.hash != last_hash) {
+                    write_coins_to_buffer(buffer, last_hash, coins, written_coins_count);
+                    coins.clear();
+                }
                 last_hash = key.hash;
-                coins.clear();
+                coins.emplace_back(key.n, coin);
             }
-            coins.emplace_back(key.n, coin);
+            cursor.Next();
+        }
+
+        if (!coins.empty()) {
+            write_coins_to_buffer(buffer, last_hash, coins, written_coins_count);
         }
-        pcursor->Next();
+    };
+
+    // The ranges are serialized into memory by worker threads and written to
+    // the file in order. Only a few ranges per thread are buffered at a time.
+    struct RangeBuffer {
+        DataStream data;
+        size_t coins_count{0};
+        bool done{false};
+    };
+    std::vector<RangeBuffer> buffers(cursors.size());
+    const unsigned int num_threads{std::clamp(std::thread::hardware_concurrency(), 1U, MAX_SNAPSHOT_WRITE_THREADS)};
+    const size_t max_buffered{2 * size_t{num_threads}};
+    Mutex buffers_mutex;
+    std::condition_variable buffers_cv;
+    size_t next_range{0};
+    size_t next_write{0};
+    bool stop{false};
+    std::exception_ptr exception;
+
+    auto serialize_ranges = [&] {
+        WAIT_LOCK(buffers_mutex, lock);
+        while (true) {
+            buffers_cv.wait(lock, [&] { return stop || next_range >= buffers.size() || next_range < next_write + max_buffered; });
+            if (stop || next_range >= buffers.size()) return;
+            RangeBuffer& buffer{buffers[next_range]};
+            CCoinsViewCursor& cursor{*cursors[next_range]};
+            ++next_range;
+            try {
+                REVERSE_LOCK(lock, buffers_mutex);
+                serialize_range(cursor, buffer.data, buffer.coins_count);
+            } catch (...) {
+                if (!exception) exception = std::current_exception();
+                stop = true;
+            }
+            buffer.done = true;
+            buffers_cv.notify_all();
+        }
+    };
+
+    std::vector<std::thread> threads;
+    for (unsigned int n = 0; n < std::min<size_t>(num_threads, buffers.size()); ++n) {
+        threads.emplace_back(serialize_ranges);
     }
 
-    if (!coins.empty()) {
-        write_coins_to_file(afile, last_hash, coins, written_coins_count);
+    size_t written_coins_count{0};
+    try {
+        for (size_t r = 0; r < buffers.size(); ++r) {
+            {
+                WAIT_LOCK(buffers_mutex, lock);
+                buffers_cv.wait(lock, [&] { return stop || buffers[r].done; });
+                if (stop) break;
+            }
+            afile.write(MakeByteSpan(buffers[r].data));
+            written_coins_count += buffers[r].coins_count;
+            buffers[r].data = DataStream{};
+            WITH_LOCK(buffers_mutex, next_write = r + 1);
+            buffers_cv.notify_all();
+        }
+    } catch (...) {
+        WITH_LOCK(buffers_mutex, if (!exception) exception = std::current_exception(); stop = true);
+        buffers_cv.notify_all();
     }
+    for (auto& thread : threads) thread.join();
+    if (exception) std::rethrow_exception(exception);
 
     CHECK_NONFATAL(written_coins_count == maybe_stats->coins_count);
 
+    size_t written_names_count{0};
+    while (pnames->next(name, name_data)) {
+        if (written_names_count % 5000 == 0) interruption_point();
+        afile << name << name_data;
+        ++written_names_count;
+    }
+    CHECK_NONFATAL(written_names_count == names_count);
+
     afile.fclose();
 
     UniValue result(UniValue::VOBJ);
     result.pushKV("coins_written", written_coins_count);
+    result.pushKV("names_written", written_names_count);
     result.pushKV("base_hash", tip->GetBlockHash().ToString());
     result.pushKV("base_height", tip->nHeight);
     result.pushKV("path", path.utf8string());
@@ -3414,8 +3564,8 @@ UniValue CreateUTXOSnapshot(
     const fs::path& path,
     const fs::path& tmppath)
 {
-    auto [cursor, stats, tip]{WITH_LOCK(::cs_main, return PrepareUTXOSnapshot(chainstate, node.rpc_interruption_point))};
-    return WriteUTXOSnapshot(chainstate, cursor.get(), &stats, tip, afile, path, tmppath, node.rpc_interruption_point);
+    auto [cursors, names, stats, tip]{WITH_LOCK(::cs_main, return PrepareUTXOSnapshot(chainstate, node.rpc_interruption_point))};
+    return WriteUTXOSnapshot(chainstate, cursors, names.get(), &stats, tip, afile, path, tmppath, node.rpc_interruption_point);
 }
 
 static RPCHelpMan loadtxoutset()
@@ -3446,6 +3596,7 @@ static RPCHelpMan loadtxoutset()
             RPCResult::Type::OBJ, "", "",
                 {
                     {RPCResult::Type::NUM, "coins_loaded", "the number of coins loaded from the snapshot"},
+                    {RPCResult::Type::NUM, "names_loaded", "the number of name database entries loaded from the snapshot"},
                     {RPCResult::Type::STR_HEX, "tip_hash", "the hash of the base of the snapshot"},
                     {RPCResult::Type::NUM, "base_height", "the height of the base of the snapshot"},
                     {RPCResult::Type::STR, "path", "the absolute path that the snapshot was loaded from"},
@@ -3491,6 +3642,7 @@ static RPCHelpMan loadtxoutset()
 
     UniValue result(UniValue::VOBJ);
     result.pushKV("coins_loaded", metadata.m_coins_count);
+    result.pushKV("names_loaded", metadata.m_names_count);
     result.pushKV("tip_hash", snapshot_index.GetBlockHash().ToString());
     result.pushKV("base_height", snapshot_index.nHeight);
     result.pushKV("path", fs::PathToString(path));
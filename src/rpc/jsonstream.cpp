@@ -0,0 +1,116 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <rpc/jsonstream.h>
+
+#include <univalue.h>
+#include <univalue_escapes.h>
+#include <util/check.h>
+
+#include <algorithm>
+#include <utility>
+
+JSONStreamWriter::JSONStreamWriter(Sink sink, size_t chunk_size)
+    : m_sink{std::move(sink)}, m_chunk_size{std::max<size_t>(chunk_size, 1)}
+{
+    m_buffer.reserve(m_chunk_size);
+}
+
+void JSONStreamWriter::BeginValue()
+{
+    if (m_after_key) {
+        m_after_key = false;
+        return;
+    }
+    if (m_empty.empty()) return;
+    if (!m_empty.back()) m_buffer += ',';
+    m_empty.back() = false;
+}
+
+void JSONStreamWriter::BeginObject()
+{
+    BeginValue();
+    m_buffer += '{';
+    m_empty.push_back(true);
+}
+
+void JSONStreamWriter::EndObject()
+{
+    Assume(!m_empty.empty() && !m_after_key);
+    m_empty.pop_back();
+    m_buffer += '}';
+    MaybeFlush();
+}
+
+void JSONStreamWriter::BeginArray()
+{
+    BeginValue();
+    m_buffer += '[';
+    m_empty.push_back(true);
+}
+
+void JSONStreamWriter::EndArray()
+{
+    Assume(!m_empty.empty() && !m_after_key);
+    m_empty.pop_back();
+    m_buffer += ']';
+    MaybeFlush();
+}
+
+void JSONStreamWriter::Key(std::string_view key)
+{
+    Assume(!m_empty.empty() && !m_after_key);
+    BeginValue();
+    m_buffer += '"';
+    for (const char c : key) {
+        const char* esc{escapes[static_cast<unsigned char>(c)]};
+        if (esc) {
+            m_buffer += esc;
+        } else {
+            m_buffer += c;
+        }
+    }
+    m_buffer += "\":";
+    m_after_key = true;
+}
+
+void JSONStreamWriter::Value(const UniValue& val)
+{
+    BeginValue();
+    m_buffer += val.write();
+    MaybeFlush();
+}
+
+void JSONStreamWriter::RawValue(std::string_view json)
+{
+    BeginValue();
+    if (m_buffer.size() + json.size() < m_chunk_size) {
+        m_buffer += json;
+        return;
+    }
+
+    // Pass large values on in chunks, without copying them to the buffer
+    Flush();
+    while (json.size() >= m_chunk_size) {
+        m_sink(json.substr(0, m_chunk_size));
+        json.remove_prefix(m_chunk_size);
+    }
+    m_buffer += json;
+}
+
+void JSONStreamWriter::MaybeFlush()
+{
+    if (m_buffer.size() >= m_chunk_size) Flush();
+}
+
+void JSONStreamWriter::Flush()
+{
+    std::string_view data{m_buffer};
+    while (!data.empty()) {
+        const auto chunk{data.substr(0, m_chunk_size)};
+        m_sink(chunk);
+        data.remove_prefix(chunk.size());
+    }
+    m_buffer.clear();
+}
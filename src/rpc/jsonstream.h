@@ -0,0 +1,71 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_RPC_JSONSTREAM_H
+#define BITCOIN_RPC_JSONSTREAM_H
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class UniValue;
+
+/**
+ * Writes compact JSON incrementally, producing exactly the same output as
+ * UniValue::write() would for the equivalent value.  Output is buffered
+ * and passed on to a sink in chunks of at most the chunk size, so that
+ * large values never have to exist in memory as a whole.
+ *
+ * The sink may throw to abort writing, e.g. when the receiver is gone.
+ */
+class JSONStreamWriter
+{
+public:
+    using Sink = std::function<void(std::string_view)>;
+
+    static constexpr size_t DEFAULT_CHUNK_SIZE{64 << 10};
+
+    explicit JSONStreamWriter(Sink sink, size_t chunk_size = DEFAULT_CHUNK_SIZE);
+
+    void BeginObject();
+    void EndObject();
+    void BeginArray();
+    void EndArray();
+
+    /** Write the key of the next member in the current object. */
+    void Key(std::string_view key);
+
+    /** Write a complete value as object member or array element. */
+    void Value(const UniValue& val);
+
+    void KeyValue(std::string_view key, const UniValue& val)
+    {
+        Key(key);
+        Value(val);
+    }
+
+    /** Write an already serialized, compact JSON value. */
+    void RawValue(std::string_view json);
+
+    /** Pass all buffered output to the sink. */
+    void Flush();
+
+private:
+    /** Write the separator before a new value, if needed. */
+    void BeginValue();
+    void MaybeFlush();
+
+    const Sink m_sink;
+    const size_t m_chunk_size;
+    std::string m_buffer;
+
+    /** For each open object or array, whether it has no elements yet. */
+    std::vector<bool> m_empty;
+    /** Whether a key was written, so the next value is its member value. */
+    bool m_after_key{false};
+};
+
+#endif // BITCOIN_RPC_JSONSTREAM_H
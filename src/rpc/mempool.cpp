@@ -343,23 +343,25 @@ static void entryToJSON(const CTxMemPool& pool, UniValue& info, const CTxMemPool
     info.pushKV("unbroadcast", pool.IsUnbroadcastTx(tx.GetHash()));
 }
 
-UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempool_sequence)
+UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose, bool include_mempool_sequence, JSONRPCResultStream* stream)
 {
     if (verbose) {
         if (include_mempool_sequence) {
             throw JSONRPCError(RPC_INVALID_PARAMETER, "Verbose results cannot contain mempool sequence values.");
         }
-        LOCK(pool.cs);
-        UniValue o(UniValue::VOBJ);
-        for (const CTxMemPoolEntry& e : pool.entryAll()) {
-            UniValue info(UniValue::VOBJ);
-            entryToJSON(pool, info, e);
-            // Mempool has unique entries so there is no advantage in using
-            // UniValue::pushKV, which checks if the key already exists in O(N).
-            // UniValue::pushKVEnd is used instead which currently is O(1).
-            o.pushKVEnd(e.GetTx().GetHash().ToString(), std::move(info));
+        RPCStreamedResult o{stream, UniValue::VOBJ};
+        {
+            LOCK(pool.cs);
+            for (const CTxMemPoolEntry& e : pool.entryAll()) {
+                UniValue info(UniValue::VOBJ);
+                entryToJSON(pool, info, e);
+                // Mempool has unique entries so there is no advantage in using
+                // UniValue::pushKV, which checks if the key already exists in O(N).
+                // UniValue::pushKVEnd is used instead which currently is O(1).
+                o.pushKVEnd(e.GetTx().GetHash().ToString(), std::move(info));
+            }
         }
-        return o;
+        return o.Finish();
     } else {
         UniValue a(UniValue::VARR);
         uint64_t mempool_sequence;
@@ -427,7 +429,7 @@ static RPCHelpMan getrawmempool()
         include_mempool_sequence = request.params[1].get_bool();
     }
 
-    return MempoolToJSON(EnsureAnyMemPool(request.context), fVerbose, include_mempool_sequence);
+    return MempoolToJSON(EnsureAnyMemPool(request.context), fVerbose, include_mempool_sequence, request.m_result_stream);
 },
     };
 }
@@ -6,12 +6,16 @@
 #define BITCOIN_RPC_MEMPOOL_H
 
 class CTxMemPool;
+class JSONRPCResultStream;
 class UniValue;
 
 /** Mempool information to JSON */
 UniValue MempoolInfoToJSON(const CTxMemPool& pool);
 
-/** Mempool to JSON */
-UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose = false, bool include_mempool_sequence = false);
+/**
+ * Mempool to JSON.  If a result stream is given, the verbose result is
+ * serialized directly and sent to it, and null is returned instead.
+ */
+UniValue MempoolToJSON(const CTxMemPool& pool, bool verbose = false, bool include_mempool_sequence = false, JSONRPCResultStream* stream = nullptr);
 
 #endif // BITCOIN_RPC_MEMPOOL_H
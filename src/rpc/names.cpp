@@ -605,15 +605,17 @@ name_history ()
       assert (history.empty ());
   }
 
-  MaybeWalletForRequest wallet(request);
-  LOCK2 (wallet.getLock (), cs_main);
+  RPCStreamedResult res(request.m_result_stream, UniValue::VARR);
+  {
+    MaybeWalletForRequest wallet(request);
+    LOCK2 (wallet.getLock (), cs_main);
 
-  UniValue res(UniValue::VARR);
-  for (const auto& entry : history.getData ())
-    res.push_back (getNameInfo (chainman, options, name, entry, wallet));
-  res.push_back (getNameInfo (chainman, options, name, data, wallet));
+    for (const auto& entry : history.getData ())
+      res.push_back (getNameInfo (chainman, options, name, entry, wallet));
+    res.push_back (getNameInfo (chainman, options, name, data, wallet));
+  }
 
-  return res;
+  return res.Finish ();
 }
   );
 }
@@ -714,55 +716,57 @@ name_scan ()
     }
 
   /* Iterate over names and produce the result.  */
-  UniValue res(UniValue::VARR);
   if (count <= 0)
-    return res;
+    return UniValue (UniValue::VARR);
 
-  MaybeWalletForRequest wallet(request);
-  LOCK2 (wallet.getLock (), cs_main);
+  RPCStreamedResult res(request.m_result_stream, UniValue::VARR);
+  {
+    MaybeWalletForRequest wallet(request);
+    LOCK2 (wallet.getLock (), cs_main);
 
-  const int maxHeight = chainman.ActiveHeight () - minConf + 1;
-  int minHeight = -1;
-  if (maxConf >= 0)
-    minHeight = chainman.ActiveHeight () - maxConf + 1;
+    const int maxHeight = chainman.ActiveHeight () - minConf + 1;
+    int minHeight = -1;
+    if (maxConf >= 0)
+      minHeight = chainman.ActiveHeight () - maxConf + 1;
 
-  valtype name;
-  CNameData data;
-  const auto& coinsTip = chainman.ActiveChainstate ().CoinsTip ();
-  std::unique_ptr<CNameIterator> iter(coinsTip.IterateNames ());
-  for (iter->seek (start); count > 0 && iter->next (name, data); )
-    {
-      const int height = data.getHeight ();
-      if (height > maxHeight)
-        continue;
-      if (minHeight >= 0 && height < minHeight)
-        continue;
-
-      if (name.size () < prefix.size ())
-        continue;
-      if (!std::equal (prefix.begin (), prefix.end (), name.begin ()))
-        continue;
-
-      if (haveRegexp)
-        {
-          try
-            {
-              const std::string nameStr = EncodeName (name, NameEncoding::UTF8);
-              boost::xpressive::smatch matches;
-              if (!boost::xpressive::regex_search (nameStr, matches, regexp))
+    valtype name;
+    CNameData data;
+    const auto& coinsTip = chainman.ActiveChainstate ().CoinsTip ();
+    std::unique_ptr<CNameIterator> iter(coinsTip.IterateNames ());
+    for (iter->seek (start); count > 0 && iter->next (name, data); )
+      {
+        const int height = data.getHeight ();
+        if (height > maxHeight)
+          continue;
+        if (minHeight >= 0 && height < minHeight)
+          continue;
+
+        if (name.size () < prefix.size ())
+          continue;
+        if (!std::equal (prefix.begin (), prefix.end (), name.begin ()))
+          continue;
+
+        if (haveRegexp)
+          {
+            try
+              {
+                const std::string nameStr = EncodeName (name, NameEncoding::UTF8);
+                boost::xpressive::smatch matches;
+                if (!boost::xpressive::regex_search (nameStr, matches, regexp))
+                  continue;
+              }
+            catch (const InvalidNameString& exc)
+              {
                 continue;
-            }
-          catch (const InvalidNameString& exc)
-            {
-              continue;
-            }
-        }
+              }
+          }
 
-      res.push_back (getNameInfo (chainman, options, name, data, wallet));
-      --count;
-    }
+        res.push_back (getNameInfo (chainman, options, name, data, wallet));
+        --count;
+      }
+  }
 
-  return res;
+  return res.Finish ();
 }
   );
 }
@@ -819,10 +823,15 @@ name_pending ()
       for (size_t n = 0; n < tx.vout.size (); ++n)
         {
           const auto& txOut = tx.vout[n];
-          const CNameScript op(txOut.scriptPubKey);
-          if (!op.isNameOp () || !op.isAnyUpdate ())
+          const NameScriptView view(txOut.scriptPubKey);
+          if (!view.isNameOp ())
+            continue;
+          if (hasNameFilter
+                && !std::ranges::equal (view.getOpName (), nameFilter))
             continue;
-          if (hasNameFilter && op.getOpName () != nameFilter)
+
+          const CNameScript op(view);
+          if (!op.isAnyUpdate ())
             continue;
 
           UniValue obj = getNameInfo (options,
@@ -22,10 +22,13 @@
 #include <rpc/server_util.h>
 #include <rpc/util.h>
 #include <scheduler.h>
+#include <script/sigcache.h>
 #include <univalue.h>
 #include <util/any.h>
 #include <util/check.h>
 #include <util/time.h>
+#include <validation.h>
+#include <validationinterface.h>
 
 #include <cstdint>
 #ifdef HAVE_MALLOC_INFO
@@ -408,12 +411,106 @@ static RPCHelpMan getindexinfo()
     };
 }
 
+static RPCHelpMan getvalidationqueueinfo()
+{
+    return RPCHelpMan{
+        "getvalidationqueueinfo",
+        "Returns the state of the queues through which validation notifies its subscribers (wallets, indexes, ZMQ, ...).\n"
+        "Subscribers on the main queue are notified one after the other, while other queues are processed by their own thread.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::ARR, "", "",
+            {
+                {RPCResult::Type::OBJ, "", "",
+                {
+                    {RPCResult::Type::STR, "name", "The name of the queue"},
+                    {RPCResult::Type::NUM, "subscribers", "The number of subscribers notified through the queue"},
+                    {RPCResult::Type::NUM, "pending", "The number of queued callbacks that have not run yet"},
+                    {RPCResult::Type::NUM, "processed", "The number of callbacks that have run"},
+                    {RPCResult::Type::NUM, "latency_avg_us", "The average time in microseconds from queueing a callback until it has run"},
+                    {RPCResult::Type::NUM, "latency_max_us", "The maximum time in microseconds from queueing a callback until it has run"},
+                }},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("getvalidationqueueinfo", "")
+          + HelpExampleRpc("getvalidationqueueinfo", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    NodeContext& node = EnsureAnyNodeContext(request.context);
+    UniValue result(UniValue::VARR);
+    for (const auto& stats : CHECK_NONFATAL(node.validation_signals)->GetQueueStats()) {
+        UniValue entry(UniValue::VOBJ);
+        entry.pushKV("name", stats.name);
+        entry.pushKV("subscribers", stats.subscribers);
+        entry.pushKV("pending", stats.pending);
+        entry.pushKV("processed", stats.processed);
+        entry.pushKV("latency_avg_us", count_microseconds(stats.latency_avg));
+        entry.pushKV("latency_max_us", count_microseconds(stats.latency_max));
+        result.push_back(std::move(entry));
+    }
+    return result;
+},
+    };
+}
+
+static const std::vector<RPCResult> RPCHelpForCuckooCache{
+    {RPCResult::Type::NUM, "hits", "The number of lookups that found their entry"},
+    {RPCResult::Type::NUM, "misses", "The number of lookups that did not find their entry"},
+    {RPCResult::Type::NUM, "inserts", "The number of entries added"},
+    {RPCResult::Type::NUM, "max_entries", "The maximum number of entries the cache can hold"},
+    {RPCResult::Type::NUM, "shards", "The number of independently locked parts the cache is split into"},
+};
+
+static UniValue CuckooCacheStatsToJSON(const CuckooCacheStats& stats)
+{
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("hits", stats.hits);
+    obj.pushKV("misses", stats.misses);
+    obj.pushKV("inserts", stats.inserts);
+    obj.pushKV("max_entries", stats.max_entries);
+    obj.pushKV("shards", ShardedCuckooCache::NUM_SHARDS);
+    return obj;
+}
+
+static RPCHelpMan getvalidationcacheinfo()
+{
+    return RPCHelpMan{
+        "getvalidationcacheinfo",
+        "Returns usage statistics of the signature and script execution caches since startup.\n",
+        {},
+        RPCResult{
+            RPCResult::Type::OBJ, "", "", {
+                {RPCResult::Type::OBJ, "signature_cache", "The cache of valid signatures", RPCHelpForCuckooCache},
+                {RPCResult::Type::OBJ, "script_execution_cache", "The cache of transactions whose scripts are valid", RPCHelpForCuckooCache},
+            }
+        },
+        RPCExamples{
+            HelpExampleCli("getvalidationcacheinfo", "")
+          + HelpExampleRpc("getvalidationcacheinfo", "")
+        },
+        [&](const RPCHelpMan& self, const JSONRPCRequest& request) -> UniValue
+{
+    ChainstateManager& chainman = EnsureAnyChainman(request.context);
+    const ValidationCache& validation_cache = chainman.m_validation_cache;
+
+    UniValue obj(UniValue::VOBJ);
+    obj.pushKV("signature_cache", CuckooCacheStatsToJSON(validation_cache.m_signature_cache.GetStats()));
+    obj.pushKV("script_execution_cache", CuckooCacheStatsToJSON(validation_cache.m_script_execution_cache.GetStats()));
+    return obj;
+}
+    };
+}
+
 void RegisterNodeRPCCommands(CRPCTable& t)
 {
     static const CRPCCommand commands[]{
         {"control", &getmemoryinfo},
         {"control", &logging},
         {"util", &getindexinfo},
+        {"control", &getvalidationqueueinfo},
+        {"control", &getvalidationcacheinfo},
         {"hidden", &setmocktime},
         {"hidden", &mockscheduler},
         {"hidden", &echo},
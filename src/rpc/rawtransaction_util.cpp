@@ -332,7 +332,8 @@ void SignTransactionResultToJSON(CMutableTransaction& mtx, bool complete, const
     result.pushKV("complete", complete);
     if (!vErrors.empty()) {
         if (result.exists("errors")) {
-            vErrors.push_backV(result["errors"].getValues());
+            const auto& errors{result["errors"].getValues()};
+            vErrors.push_backV(errors.begin(), errors.end());
         }
         result.pushKV("errors", std::move(vErrors));
     }
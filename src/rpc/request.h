@@ -13,6 +13,8 @@
 #include <univalue.h>
 #include <util/fs.h>
 
+class JSONStreamWriter;
+
 enum class JSONRPCVersion {
     V1_LEGACY,
     V2
@@ -49,6 +51,28 @@ void DeleteAuthCookie();
 /** Parse JSON-RPC batch reply into a vector */
 std::vector<UniValue> JSONRPCProcessBatchReply(const UniValue& in);
 
+/**
+ * Lets RPC methods with large results write them incrementally, instead of
+ * returning them as one UniValue.  This is offered for single requests
+ * over HTTP, where the result is sent to the client as it is written.
+ */
+class JSONRPCResultStream
+{
+public:
+    virtual ~JSONRPCResultStream() = default;
+
+    /**
+     * Start the reply and return the writer for the result.  The method
+     * must then write exactly one JSON value as its result and return
+     * NullUniValue.  Errors can no longer be reported to the client after
+     * this; if the method throws, the reply is aborted.
+     */
+    virtual JSONStreamWriter& Start() = 0;
+
+    /** Whether Start() has been called. */
+    virtual bool Started() const = 0;
+};
+
 class JSONRPCRequest
 {
 public:
@@ -62,6 +86,8 @@ public:
     std::any context;
     std::any context2;
     JSONRPCVersion m_json_version = JSONRPCVersion::V1_LEGACY;
+    //! Where the result can be streamed to, if the transport supports it
+    JSONRPCResultStream* m_result_stream{nullptr};
 
     void parse(const UniValue& valRequest);
     [[nodiscard]] bool IsNotification() const { return !id.has_value() && m_json_version == JSONRPCVersion::V2; };
@@ -377,8 +377,8 @@ static inline JSONRPCRequest transformNamedArguments(const JSONRPCRequest& in, c
     out.params = UniValue(UniValue::VARR);
     // Build a map of parameters, and remove ones that have been processed, so that we can throw a focused error if
     // there is an unknown one.
-    const std::vector<std::string>& keys = in.params.getKeys();
-    const std::vector<UniValue>& values = in.params.getValues();
+    const UniValue::Keys& keys = in.params.getKeys();
+    const UniValue::Values& values = in.params.getValues();
     std::unordered_map<std::string, const UniValue*> argsIn;
     for (size_t i=0; i<keys.size(); ++i) {
         auto [_, inserted] = argsIn.emplace(keys[i], &values[i]);
@@ -636,6 +636,75 @@ std::string RPCExamples::ToDescriptionString() const
     return m_examples.empty() ? m_examples : "\nExamples:\n" + m_examples;
 }
 
+namespace {
+
+/**
+ * Result stream used with -rpcdoccheck.  It collects the streamed result, so
+ * that it can be checked against the documentation before it is passed on
+ * to the client's stream.
+ */
+class DocCheckResultStream final : public JSONRPCResultStream
+{
+public:
+    explicit DocCheckResultStream(JSONRPCResultStream& stream) : m_stream{stream} {}
+
+    JSONStreamWriter& Start() override
+    {
+        CHECK_NONFATAL(!m_writer);
+        m_writer.emplace([this](std::string_view chunk) { m_json += chunk; });
+        return *m_writer;
+    }
+
+    bool Started() const override { return m_writer.has_value(); }
+
+    /** Return the result streamed so far, parsed as UniValue. */
+    UniValue Parse()
+    {
+        m_writer->Flush();
+        UniValue val;
+        CHECK_NONFATAL(val.read(m_json));
+        return val;
+    }
+
+    /** Pass the collected result on to the client. */
+    void Forward()
+    {
+        m_stream.Start().RawValue(m_json);
+        m_json.clear();
+    }
+
+private:
+    JSONRPCResultStream& m_stream;
+    std::string m_json;
+    std::optional<JSONStreamWriter> m_writer;
+};
+
+} // namespace
+
+void RPCHelpMan::CheckResult(const UniValue& ret) const
+{
+    UniValue mismatch{UniValue::VARR};
+    for (const auto& res : m_results.m_results) {
+        UniValue match{res.MatchesType(ret)};
+        if (match.isTrue()) {
+            mismatch.setNull();
+            break;
+        }
+        mismatch.push_back(std::move(match));
+    }
+    if (!mismatch.isNull()) {
+        std::string explain{
+            mismatch.empty() ? "no possible results defined" :
+            mismatch.size() == 1 ? mismatch[0].write(4) :
+            mismatch.write(4)};
+        throw std::runtime_error{
+            strprintf("Internal bug detected: RPC call \"%s\" returned incorrect type:\n%s\n%s %s\nPlease report this issue here: %s\n",
+                      m_name, explain,
+                      CLIENT_NAME, FormatFullVersion(),
+                      CLIENT_BUGREPORT)};
+    }
+}
+
 UniValue RPCHelpMan::HandleRequest(const JSONRPCRequest& request) const
 {
     if (request.mode == JSONRPCRequest::GET_ARGS) {
@@ -659,32 +728,31 @@ UniValue RPCHelpMan::HandleRequest(const JSONRPCRequest& request) const
     if (!arg_mismatch.empty()) {
         throw JSONRPCError(RPC_TYPE_ERROR, strprintf("Wrong type passed:\n%s", arg_mismatch.write(4)));
     }
+    const bool doc_check{gArgs.GetBoolArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK)};
+    // With -rpcdoccheck, a streamed result is collected and checked before
+    // it is sent to the client.
+    std::optional<DocCheckResultStream> checked_stream;
+    std::optional<JSONRPCRequest> checked_request;
+    if (doc_check && request.m_result_stream) {
+        checked_stream.emplace(*request.m_result_stream);
+        checked_request.emplace(request);
+        checked_request->m_result_stream = &*checked_stream;
+    }
+    const JSONRPCRequest& req{checked_request ? *checked_request : request};
     CHECK_NONFATAL(m_req == nullptr);
-    m_req = &request;
-    UniValue ret = m_fun(*this, request);
+    m_req = &req;
+    UniValue ret = m_fun(*this, req);
     m_req = nullptr;
-    if (gArgs.GetBoolArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK)) {
-        UniValue mismatch{UniValue::VARR};
-        for (const auto& res : m_results.m_results) {
-            UniValue match{res.MatchesType(ret)};
-            if (match.isTrue()) {
-                mismatch.setNull();
-                break;
-            }
-            mismatch.push_back(std::move(match));
-        }
-        if (!mismatch.isNull()) {
-            std::string explain{
-                mismatch.empty() ? "no possible results defined" :
-                mismatch.size() == 1 ? mismatch[0].write(4) :
-                mismatch.write(4)};
-            throw std::runtime_error{
-                strprintf("Internal bug detected: RPC call \"%s\" returned incorrect type:\n%s\n%s %s\nPlease report this issue here: %s\n",
-                          m_name, explain,
-                          CLIENT_NAME, FormatFullVersion(),
-                          CLIENT_BUGREPORT)};
-        }
+    if (checked_stream && checked_stream->Started()) {
+        CheckResult(checked_stream->Parse());
+        checked_stream->Forward();
+        return ret;
     }
+    if (request.m_result_stream && request.m_result_stream->Started()) {
+        // The result was already sent to the client
+        return ret;
+    }
+    if (doc_check) CheckResult(ret);
     return ret;
 }
 
@@ -1384,6 +1452,54 @@ std::vector<CScript> EvalDescriptorStringOrObject(const UniValue& scanobject, Fl
     return result;
 }
 
+RPCStreamedResult::RPCStreamedResult(JSONRPCResultStream* stream, UniValue::VType type)
+    : m_stream{stream}, m_result{type}
+{
+    CHECK_NONFATAL(type == UniValue::VARR || type == UniValue::VOBJ);
+    if (!m_stream) return;
+    m_writer.emplace([this](std::string_view chunk) { m_json += chunk; });
+    if (type == UniValue::VARR) {
+        m_writer->BeginArray();
+    } else {
+        m_writer->BeginObject();
+    }
+}
+
+void RPCStreamedResult::push_back(UniValue val)
+{
+    CHECK_NONFATAL(m_result.isArray());
+    if (m_writer) {
+        m_writer->Value(val);
+    } else {
+        m_result.push_back(std::move(val));
+    }
+}
+
+void RPCStreamedResult::pushKVEnd(std::string key, UniValue val)
+{
+    CHECK_NONFATAL(m_result.isObject());
+    if (m_writer) {
+        m_writer->KeyValue(key, val);
+    } else {
+        m_result.pushKVEnd(std::move(key), std::move(val));
+    }
+}
+
+UniValue RPCStreamedResult::Finish()
+{
+    if (!m_writer) return std::move(m_result);
+
+    if (m_result.isArray()) {
+        m_writer->EndArray();
+    } else {
+        m_writer->EndObject();
+    }
+    m_writer->Flush();
+    m_stream->Start().RawValue(m_json);
+    m_json.clear();
+    return NullUniValue;
+}
+
 void PushWarnings(const UniValue& warnings, UniValue& obj)
 {
     if (warnings.empty()) return;
@@ -11,6 +11,7 @@
 #include <outputtype.h>
 #include <powdata.h>
 #include <pubkey.h>
+#include <rpc/jsonstream.h>
 #include <rpc/protocol.h>
 #include <rpc/request.h>
 #include <script/script.h>
@@ -501,10 +502,43 @@ private:
     mutable const JSONRPCRequest* m_req{nullptr}; // A pointer to the request for the duration of m_fun()
     template <typename R>
     R ArgValue(size_t i) const;
+    //! Throw if the result does not match any of the documented results (-rpcdoccheck).
+    void CheckResult(const UniValue& ret) const;
     //! Return positional index of a parameter using its name as key.
     size_t GetParamIndex(std::string_view key) const;
 };
 
+/**
+ * Collects the elements of a large array or object result.  If the result
+ * can be streamed to the client, each element is serialized right away
+ * instead of being kept as UniValue, which is many times larger.  The
+ * serialized result is sent to the client by Finish(), which should be
+ * called without holding any locks, as it waits for the client.
+ */
+class RPCStreamedResult
+{
+public:
+    RPCStreamedResult(JSONRPCResultStream* stream, UniValue::VType type);
+
+    RPCStreamedResult(const RPCStreamedResult&) = delete;
+    RPCStreamedResult& operator=(const RPCStreamedResult&) = delete;
+
+    /** Add an element to an array result. */
+    void push_back(UniValue val);
+    /** Add a member with a key not used before to an object result. */
+    void pushKVEnd(std::string key, UniValue val);
+
+    /** Return the value that the RPC method should return. */
+    UniValue Finish();
+
+private:
+    JSONRPCResultStream* const m_stream;
+    UniValue m_result;
+    //! Serialized result if streaming
+    std::string m_json;
+    std::optional<JSONStreamWriter> m_writer;
+};
+
 /**
  * Push warning messages to an RPC "warnings" field as a JSON array of strings.
  *
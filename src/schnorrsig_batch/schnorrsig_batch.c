@@ -0,0 +1,159 @@
+/* Copyright (c) 2025 The Xaya developers
+ * Distributed under the MIT software license, see the accompanying
+ * file COPYING or http://www.opensource.org/licenses/mit-license.php. */
+
+#include "schnorrsig_batch.h"
+
+/* The multi-scalar multiplication of the secp256k1 subtree is not part of
+ * its public API, so its implementation headers are compiled into this
+ * translation unit.  The build uses the same configuration as the subtree,
+ * so that the precomputed tables of the library match. */
+#include "../secp256k1/src/util.h"
+#include "../secp256k1/src/field_impl.h"
+#include "../secp256k1/src/scalar_impl.h"
+#include "../secp256k1/src/group_impl.h"
+#include "../secp256k1/src/ecmult_impl.h"
+#include "../secp256k1/src/hash_impl.h"
+#include "../secp256k1/src/int128_impl.h"
+#include "../secp256k1/src/scratch_impl.h"
+
+#include <stdint.h>
+#include <stdlib.h>
+
+/* Maximum number of points to size the scratch space for. Larger batches are
+ * split into several multi-multiplications by secp256k1_ecmult_multi_var. */
+#define SCHNORRSIG_BATCH_MAX_SCRATCH_POINTS 8192
+
+typedef struct {
+    secp256k1_ge r;
+    secp256k1_ge pk;
+    secp256k1_scalar a;
+    secp256k1_scalar ae;
+} schnorrsig_batch_entry;
+
+/* Point 2i is R_i with factor a_i, point 2i + 1 is P_i with factor a_i * e_i. */
+static int schnorrsig_batch_ecmult_callback(secp256k1_scalar *sc, secp256k1_ge *pt, size_t idx, void *data) {
+    const schnorrsig_batch_entry *entries = (const schnorrsig_batch_entry *) data;
+    const schnorrsig_batch_entry *entry = &entries[idx / 2];
+    if (idx % 2 == 0) {
+        *sc = entry->a;
+        *pt = entry->r;
+    } else {
+        *sc = entry->ae;
+        *pt = entry->pk;
+    }
+    return 1;
+}
+
+/* e = tagged_hash("BIP0340/challenge", r.x || pk.x || msg) mod n */
+static void schnorrsig_batch_challenge(secp256k1_scalar *e, const unsigned char *r32, const unsigned char *msg32, const unsigned char *pubkey32) {
+    static const unsigned char tag[] = {'B', 'I', 'P', '0', '3', '4', '0', '/', 'c', 'h', 'a', 'l', 'l', 'e', 'n', 'g', 'e'};
+    secp256k1_sha256 sha;
+    unsigned char buf[32];
+    secp256k1_sha256_initialize_tagged(&sha, tag, sizeof(tag));
+    secp256k1_sha256_write(&sha, r32, 32);
+    secp256k1_sha256_write(&sha, pubkey32, 32);
+    secp256k1_sha256_write(&sha, msg32, 32);
+    secp256k1_sha256_finalize(&sha, buf);
+    secp256k1_scalar_set_b32(e, buf, NULL);
+}
+
+int schnorrsig_verify_batch(const unsigned char* const* sigs64, const unsigned char* const* msgs32, const unsigned char* const* pubkeys32, size_t n) {
+    static const unsigned char batch_tag[] = {'B', 'I', 'P', '0', '3', '4', '0', '/', 'b', 'a', 't', 'c', 'h'};
+    schnorrsig_batch_entry *entries;
+    secp256k1_scratch *scratch;
+    secp256k1_sha256 sha;
+    unsigned char seed[32];
+    secp256k1_scalar g_sc;
+    secp256k1_gej res;
+    size_t i, n_points, scratch_size;
+    int ret = 1;
+
+    if (n == 0) {
+        return 1;
+    }
+    if (n > SIZE_MAX / 2 / sizeof(schnorrsig_batch_entry)) {
+        return 0;
+    }
+    entries = (schnorrsig_batch_entry *) checked_malloc(&default_error_callback, n * sizeof(schnorrsig_batch_entry));
+    if (entries == NULL) {
+        return 0;
+    }
+
+    /* Parse all inputs, and derive the randomizer seed from all of them. */
+    secp256k1_sha256_initialize_tagged(&sha, batch_tag, sizeof(batch_tag));
+    for (i = 0; i < n; i++) {
+        secp256k1_fe x;
+        int overflow;
+
+        if (!secp256k1_fe_set_b32_limit(&x, &sigs64[i][0]) ||
+            !secp256k1_ge_set_xo_var(&entries[i].r, &x, 0)) {
+            ret = 0;
+            break;
+        }
+        /* s_i is kept in entries[i].a until the randomizers are known. */
+        secp256k1_scalar_set_b32(&entries[i].a, &sigs64[i][32], &overflow);
+        if (overflow ||
+            !secp256k1_fe_set_b32_limit(&x, pubkeys32[i]) ||
+            !secp256k1_ge_set_xo_var(&entries[i].pk, &x, 0)) {
+            ret = 0;
+            break;
+        }
+        schnorrsig_batch_challenge(&entries[i].ae, &sigs64[i][0], msgs32[i], pubkeys32[i]);
+
+        secp256k1_sha256_write(&sha, sigs64[i], 64);
+        secp256k1_sha256_write(&sha, msgs32[i], 32);
+        secp256k1_sha256_write(&sha, pubkeys32[i], 32);
+    }
+    if (!ret) {
+        free(entries);
+        return 0;
+    }
+    secp256k1_sha256_finalize(&sha, seed);
+
+    /* With randomizers a_i (a_0 = 1), all signatures are valid (except with
+     * negligible probability) iff
+     *   -(sum a_i*s_i)*G + sum a_i*R_i + sum (a_i*e_i)*P_i = infinity. */
+    g_sc = secp256k1_scalar_zero;
+    for (i = 0; i < n; i++) {
+        secp256k1_scalar s = entries[i].a;
+        if (i == 0) {
+            secp256k1_scalar_set_int(&entries[i].a, 1);
+        } else {
+            unsigned char buf[32];
+            unsigned char idx[8];
+            secp256k1_write_be64(idx, i);
+            secp256k1_sha256_initialize(&sha);
+            secp256k1_sha256_write(&sha, seed, sizeof(seed));
+            secp256k1_sha256_write(&sha, idx, sizeof(idx));
+            secp256k1_sha256_finalize(&sha, buf);
+            secp256k1_scalar_set_b32(&entries[i].a, buf, NULL);
+            secp256k1_scalar_mul(&s, &s, &entries[i].a);
+            secp256k1_scalar_mul(&entries[i].ae, &entries[i].ae, &entries[i].a);
+        }
+        secp256k1_scalar_add(&g_sc, &g_sc, &s);
+    }
+    secp256k1_scalar_negate(&g_sc, &g_sc);
+
+    n_points = 2 * n;
+    if (n_points > SCHNORRSIG_BATCH_MAX_SCRATCH_POINTS) {
+        n_points = SCHNORRSIG_BATCH_MAX_SCRATCH_POINTS;
+    }
+    if (n_points >= ECMULT_PIPPENGER_THRESHOLD) {
+        scratch_size = secp256k1_pippenger_scratch_size(n_points, secp256k1_pippenger_bucket_window(n_points)) + PIPPENGER_SCRATCH_OBJECTS * ALIGNMENT;
+    } else {
+        scratch_size = secp256k1_strauss_scratch_size(n_points) + STRAUSS_SCRATCH_OBJECTS * ALIGNMENT;
+    }
+    scratch = secp256k1_scratch_create(&default_error_callback, scratch_size);
+    if (scratch == NULL) {
+        free(entries);
+        return 0;
+    }
+
+    ret = secp256k1_ecmult_multi_var(&default_error_callback, scratch, &res, &g_sc, schnorrsig_batch_ecmult_callback, entries, 2 * n) &&
+          secp256k1_gej_is_infinity(&res);
+
+    secp256k1_scratch_destroy(&default_error_callback, scratch);
+    free(entries);
+    return ret;
+}
@@ -0,0 +1,34 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_SCHNORRSIG_BATCH_SCHNORRSIG_BATCH_H
+#define BITCOIN_SCHNORRSIG_BATCH_SCHNORRSIG_BATCH_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** Verify a batch of BIP340 Schnorr signatures over 32-byte messages.
+ *
+ *  The n signatures are checked with a single multi-scalar multiplication
+ *  of 2n points, using randomizers derived from a hash of the whole batch.
+ *  This is built on the internals of the secp256k1 subtree, but kept out of
+ *  it until an equivalent module is available upstream.
+ *
+ *  Returns 1 if all signatures are valid (or n is 0), and 0 if at least one
+ *  of them (or one of the public keys) is invalid.
+ *
+ *  sigs64:    array of n pointers to 64-byte signatures.
+ *  msgs32:    array of n pointers to the 32-byte messages.
+ *  pubkeys32: array of n pointers to the 32-byte x-only public keys.
+ */
+int schnorrsig_verify_batch(const unsigned char* const* sigs64, const unsigned char* const* msgs32, const unsigned char* const* pubkeys32, size_t n);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // BITCOIN_SCHNORRSIG_BATCH_SCHNORRSIG_BATCH_H
@@ -6,27 +6,60 @@
 
 #include <uint256.h>
 
-CNameScript::CNameScript (const CScript& script)
-  : op(OP_NOP), address(script)
+namespace
+{
+
+/**
+ * Returns the data pushed by an opcode, which started at start and ended
+ * at the iterator returned from GetOp.
+ */
+std::span<const unsigned char>
+GetPushData (const CScript::const_iterator start,
+             const CScript::const_iterator end, const opcodetype opcode)
+{
+  size_t header = 1;
+  if (opcode == OP_PUSHDATA1)
+    header = 2;
+  else if (opcode == OP_PUSHDATA2)
+    header = 3;
+  else if (opcode == OP_PUSHDATA4)
+    header = 5;
+
+  return std::span<const unsigned char> (&*start + header, end - start - header);
+}
+
+} // anonymous namespace
+
+NameScriptView::NameScriptView (const CScript& script)
+  : address(script.data (), script.size ())
 {
-  opcodetype nameOp;
-  CScript::const_iterator pc = script.begin ();
-  if (!script.GetOp (pc, nameOp))
+  /* Only scripts starting with one of the name opcodes can be valid
+     name operations.  This is the common case, so return before parsing
+     any further.  */
+  if (script.empty ())
     return;
+  const opcodetype nameOp = static_cast<opcodetype> (script[0]);
+  if (nameOp != OP_NAME_REGISTER && nameOp != OP_NAME_UPDATE)
+    return;
+  CScript::const_iterator pc = script.begin () + 1;
 
+  std::span<const unsigned char> args[2];
+  size_t numArgs = 0;
   opcodetype opcode;
   while (true)
     {
-      valtype vch;
-
-      if (!script.GetOp (pc, opcode, vch))
+      const CScript::const_iterator start = pc;
+      if (!script.GetOp (pc, opcode))
         return;
       if (opcode == OP_DROP || opcode == OP_2DROP || opcode == OP_NOP)
         break;
       if (!(opcode >= 0 && opcode <= OP_PUSHDATA4))
         return;
 
-      args.push_back (vch);
+      /* Both name operations need exactly two arguments.  */
+      if (numArgs == 2)
+        return;
+      args[numArgs++] = GetPushData (start, pc, opcode);
     }
 
   // Move the pc to after any DROP or NOP.
@@ -35,23 +68,30 @@ CNameScript::CNameScript (const CScript& script)
       break;
   pc--;
 
-  /* Now, we have the args and the operation.  Check if we have indeed
-     a valid name operation and valid argument counts.  Only now set the
-     op and address members, if everything is valid.  */
-  switch (nameOp)
-    {
-    case OP_NAME_REGISTER:
-    case OP_NAME_UPDATE:
-      if (args.size () != 2)
-        return;
-      break;
-
-    default:
-      return;
-    }
+  if (numArgs != 2)
+    return;
 
   op = nameOp;
-  address = CScript (pc, script.end ());
+  name = args[0];
+  value = args[1];
+  address = std::span<const unsigned char> (&*pc, script.end () - pc);
+}
+
+CNameScript::CNameScript (const CScript& script)
+  : CNameScript(NameScriptView (script))
+{}
+
+CNameScript::CNameScript (const NameScriptView& view)
+  : op(view.isNameOp () ? view.getNameOp () : OP_NOP),
+    address(view.getAddressScript ())
+{
+  if (!isNameOp ())
+    return;
+
+  const auto name = view.getOpName ();
+  const auto value = view.getOpValue ();
+  args.emplace_back (name.begin (), name.end ());
+  args.emplace_back (value.begin (), value.end ());
 }
 
 CScript
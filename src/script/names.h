@@ -7,8 +7,122 @@
 
 #include <script/script.h>
 
+#include <span>
+
 class uint160;
 
+/**
+ * A script parsed for name operations without copying any of it.  This
+ * follows exactly the same rules as CNameScript, but the name, value and
+ * address are returned as spans into the parsed script.  The script must
+ * thus outlive the view and not be modified while it is in use.
+ *
+ * Most scripts are not name operations, which the view determines from
+ * their first opcode alone.  Where owned data is needed, the view can be
+ * turned into a CNameScript.
+ */
+class NameScriptView
+{
+
+private:
+
+  /** The type of operation.  OP_NOP if no (valid) name op.  */
+  opcodetype op = OP_NOP;
+
+  /** The non-name part, i. e., the address.  */
+  std::span<const unsigned char> address;
+
+  /** The name argument, if this is a name op.  */
+  std::span<const unsigned char> name;
+
+  /** The value argument, if this is a name op.  */
+  std::span<const unsigned char> value;
+
+public:
+
+  NameScriptView () = default;
+
+  /**
+   * Parse a script and determine whether it is a valid name script.
+   * @param script The ordinary script to parse.
+   */
+  explicit NameScriptView (const CScript& script);
+
+  /**
+   * Return whether this is a (valid) name script.
+   * @return True iff this is a name operation.
+   */
+  inline bool
+  isNameOp () const
+  {
+    return op != OP_NOP;
+  }
+
+  /**
+   * Return the non-name part of the script.  This is the full script
+   * if it is not a name operation.
+   */
+  inline std::span<const unsigned char>
+  getAddress () const
+  {
+    return address;
+  }
+
+  /**
+   * Return the address part as owned script.  Prefer getAddress if no
+   * CScript is needed.
+   */
+  inline CScript
+  getAddressScript () const
+  {
+    return CScript (address.begin (), address.end ());
+  }
+
+  /**
+   * Return the name operation.  Do not call if this is not a name script.
+   * @return The name operation opcode.
+   */
+  inline opcodetype
+  getNameOp () const
+  {
+    assert (isNameOp ());
+    return op;
+  }
+
+  /**
+   * Return the name operation's name.  Do not call if this is not
+   * a name script.
+   */
+  inline std::span<const unsigned char>
+  getOpName () const
+  {
+    assert (isNameOp ());
+    return name;
+  }
+
+  /**
+   * Return the name operation's value.  Do not call if this is not
+   * a name script.
+   */
+  inline std::span<const unsigned char>
+  getOpValue () const
+  {
+    assert (isNameOp ());
+    return value;
+  }
+
+  /**
+   * Check if the given script is a name script, without copying any
+   * of its data.
+   */
+  static inline bool
+  isNameScript (const CScript& script)
+  {
+    return NameScriptView (script).isNameOp ();
+  }
+
+};
+
 /**
  * A script parsed for name operations.  This can be initialised
  * from a "standard" script, and will then determine if this is
@@ -45,6 +159,13 @@ public:
    */
   explicit CNameScript (const CScript& script);
 
+  /**
+   * Copy the parts of a name script that was parsed before into owned
+   * data.
+   * @param view The parsed script.
+   */
+  explicit CNameScript (const NameScriptView& view);
+
   /**
    * Return whether this is a (valid) name script.
    * @return True iff this is a name operation.
@@ -160,8 +281,7 @@ public:
   static inline bool
   isNameScript (const CScript& script)
   {
-    const CNameScript op(script);
-    return op.isNameOp ();
+    return NameScriptView::isNameScript (script);
   }
 
   /**
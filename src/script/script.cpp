@@ -232,8 +232,10 @@ bool CScript::IsPayToScriptHash(bool allowNames) const
                 (*this)[22] == OP_EQUAL);
 
     // Strip off a name prefix if present.
-    const CNameScript nameOp(*this);
-    return nameOp.getAddress().IsPayToScriptHash(false);
+    const NameScriptView nameOp(*this);
+    if (!nameOp.isNameOp())
+        return IsPayToScriptHash(false);
+    return nameOp.getAddressScript().IsPayToScriptHash(false);
 }
 
 bool CScript::IsPayToWitnessScriptHash(bool allowNames) const
@@ -245,8 +247,10 @@ bool CScript::IsPayToWitnessScriptHash(bool allowNames) const
                 (*this)[1] == 0x20);
 
     // Strip off a name prefix if present.
-    const CNameScript nameOp(*this);
-    return nameOp.getAddress().IsPayToWitnessScriptHash(false);
+    const NameScriptView nameOp(*this);
+    if (!nameOp.isNameOp())
+        return IsPayToWitnessScriptHash(false);
+    return nameOp.getAddressScript().IsPayToWitnessScriptHash(false);
 }
 
 bool CScript::IsPayToTaproot() const
@@ -263,8 +267,10 @@ bool CScript::IsWitnessProgram(const bool allowNames, int& version, std::vector<
     // Strip off a name prefix if present.
     if (allowNames)
       {
-        const CNameScript nameOp(*this);
-        return nameOp.getAddress().IsWitnessProgram(false, version, program);
+        const NameScriptView nameOp(*this);
+        if (!nameOp.isNameOp())
+            return IsWitnessProgram(false, version, program);
+        return nameOp.getAddressScript().IsWitnessProgram(false, version, program);
       }
 
     // Handle the case without name prefix.
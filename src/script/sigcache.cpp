@@ -13,10 +13,64 @@
 #include <span.h>
 #include <uint256.h>
 
+#include <algorithm>
+#include <cassert>
 #include <mutex>
 #include <shared_mutex>
 #include <vector>
 
+ShardedCuckooCache::Shard& ShardedCuckooCache::GetShard(const uint256& entry)
+{
+    return m_shards[SignatureCacheHasher{}.operator()<0>(entry) % NUM_SHARDS];
+}
+
+std::pair<size_t, size_t> ShardedCuckooCache::Setup(const size_t max_size_bytes)
+{
+    size_t num_elems{0}, approx_size_bytes{0};
+    for (Shard& shard : m_shards) {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        const auto [shard_elems, shard_bytes] = shard.set.setup_bytes(max_size_bytes / NUM_SHARDS);
+        num_elems += shard_elems;
+        approx_size_bytes += shard_bytes;
+    }
+    m_max_entries = num_elems;
+    return {num_elems, approx_size_bytes};
+}
+
+bool ShardedCuckooCache::Contains(const uint256& entry, const bool erase)
+{
+    Shard& shard = GetShard(entry);
+    bool found;
+    {
+        std::shared_lock<std::shared_mutex> lock(shard.mutex);
+        found = shard.set.contains(entry, erase);
+    }
+    (found ? shard.hits : shard.misses).fetch_add(1, std::memory_order_relaxed);
+    return found;
+}
+
+void ShardedCuckooCache::Insert(const uint256& entry)
+{
+    Shard& shard = GetShard(entry);
+    {
+        std::unique_lock<std::shared_mutex> lock(shard.mutex);
+        shard.set.insert(entry);
+    }
+    shard.inserts.fetch_add(1, std::memory_order_relaxed);
+}
+
+CuckooCacheStats ShardedCuckooCache::GetStats() const
+{
+    CuckooCacheStats stats;
+    for (const Shard& shard : m_shards) {
+        stats.hits += shard.hits.load(std::memory_order_relaxed);
+        stats.misses += shard.misses.load(std::memory_order_relaxed);
+        stats.inserts += shard.inserts.load(std::memory_order_relaxed);
+    }
+    stats.max_entries = m_max_entries;
+    return stats;
+}
+
 SignatureCache::SignatureCache(const size_t max_size_bytes)
 {
     uint256 nonce = GetRandHash();
@@ -31,7 +85,7 @@ SignatureCache::SignatureCache(const size_t max_size_bytes)
     m_salted_hasher_schnorr.Write(nonce.begin(), 32);
     m_salted_hasher_schnorr.Write(PADDING_SCHNORR, 32);
 
-    const auto [num_elems, approx_size_bytes] = setValid.setup_bytes(max_size_bytes);
+    const auto [num_elems, approx_size_bytes] = setValid.Setup(max_size_bytes);
     LogPrintf("Using %zu MiB out of %zu MiB requested for signature cache, able to store %zu elements\n",
               approx_size_bytes >> 20, max_size_bytes >> 20, num_elems);
 }
@@ -50,14 +104,12 @@ void SignatureCache::ComputeEntrySchnorr(uint256& entry, const uint256& hash, st
 
 bool SignatureCache::Get(const uint256& entry, const bool erase)
 {
-    std::shared_lock<std::shared_mutex> lock(cs_sigcache);
-    return setValid.contains(entry, erase);
+    return setValid.Contains(entry, erase);
 }
 
 void SignatureCache::Set(const uint256& entry)
 {
-    std::unique_lock<std::shared_mutex> lock(cs_sigcache);
-    setValid.insert(entry);
+    setValid.Insert(entry);
 }
 
 bool CachingTransactionSignatureChecker::VerifyECDSASignature(const std::vector<unsigned char>& vchSig, const CPubKey& pubkey, const uint256& sighash) const
@@ -82,3 +134,38 @@ bool CachingTransactionSignatureChecker::VerifySchnorrSignature(std::span<const
     if (store) m_signature_cache.Set(entry);
     return true;
 }
+
+void SchnorrBatch::Add(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash, SignatureCache* cache, const uint256& entry)
+{
+    assert(sig.size() == 64);
+    auto& check = m_checks.emplace_back(pubkey, sighash);
+    std::copy(sig.begin(), sig.end(), check.sig.begin());
+    if (cache) m_cache_entries.emplace_back(cache, entry);
+}
+
+bool SchnorrBatch::Verify()
+{
+    bool ret;
+    if (m_checks.size() < MIN_BATCH_SIZE) {
+        ret = std::all_of(m_checks.begin(), m_checks.end(), [](const SchnorrSignatureCheck& check) {
+            return check.pubkey.VerifySchnorr(check.msg, check.sig);
+        });
+    } else {
+        ret = VerifySchnorrBatch(m_checks);
+    }
+    if (ret) {
+        for (const auto& [cache, entry] : m_cache_entries) cache->Set(entry);
+    }
+    m_checks.clear();
+    m_cache_entries.clear();
+    return ret;
+}
+
+bool BatchingTransactionSignatureChecker::VerifySchnorrSignature(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash) const
+{
+    uint256 entry;
+    m_signature_cache.ComputeEntrySchnorr(entry, sighash, sig, pubkey);
+    if (m_signature_cache.Get(entry, !store)) return true;
+    m_batch.Add(sig, pubkey, sighash, store ? &m_signature_cache : nullptr, entry);
+    return true;
+}
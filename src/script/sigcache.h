@@ -9,18 +9,21 @@
 #include <consensus/amount.h>
 #include <crypto/sha256.h>
 #include <cuckoocache.h>
+#include <pubkey.h>
 #include <script/interpreter.h>
 #include <span.h>
 #include <uint256.h>
 #include <util/hasher.h>
 
+#include <array>
+#include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <shared_mutex>
+#include <utility>
 #include <vector>
 
-class CPubKey;
 class CTransaction;
-class XOnlyPubKey;
 
 // DoS prevention: limit cache size to 32MiB (over 1000000 entries on 64-bit
 // systems). Due to how we count cache size, actual memory usage is slightly
@@ -30,6 +33,52 @@ static constexpr size_t DEFAULT_SIGNATURE_CACHE_BYTES{DEFAULT_VALIDATION_CACHE_B
 static constexpr size_t DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES{DEFAULT_VALIDATION_CACHE_BYTES / 2};
 static_assert(DEFAULT_VALIDATION_CACHE_BYTES == DEFAULT_SIGNATURE_CACHE_BYTES + DEFAULT_SCRIPT_EXECUTION_CACHE_BYTES);
 
+//! Usage counters of a ShardedCuckooCache.
+struct CuckooCacheStats {
+    uint64_t hits{0};
+    uint64_t misses{0};
+    uint64_t inserts{0};
+    size_t max_entries{0};
+};
+
+/**
+ * A set of salted hashes split into independently locked CuckooCache shards.
+ *
+ * Entries are assigned to a shard by the low bits of their first word.
+ * SignatureCacheHasher maps the high bits of each word to a bucket, so
+ * sharding does not bias where entries end up within a shard.  Threads that
+ * insert into different shards do not contend for the same lock.
+ */
+class ShardedCuckooCache
+{
+public:
+    static constexpr size_t NUM_SHARDS{16};
+
+private:
+    struct alignas(64) Shard {
+        std::shared_mutex mutex;
+        CuckooCache::cache<uint256, SignatureCacheHasher> set;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+        std::atomic<uint64_t> inserts{0};
+    };
+    std::array<Shard, NUM_SHARDS> m_shards;
+    size_t m_max_entries{0};
+
+    Shard& GetShard(const uint256& entry);
+
+public:
+    /** Split max_size_bytes evenly between the shards.  Returns the total
+     *  number of entries and the approximate memory usage in bytes. */
+    std::pair<size_t, size_t> Setup(size_t max_size_bytes);
+
+    bool Contains(const uint256& entry, bool erase);
+
+    void Insert(const uint256& entry);
+
+    CuckooCacheStats GetStats() const;
+};
+
 /**
  * Valid signature cache, to avoid doing expensive ECDSA signature checking
  * twice for every transaction (once when accepted into memory pool, and
@@ -41,9 +90,7 @@ private:
     //! Entries are SHA256(nonce || 'E' or 'S' || 31 zero bytes || signature hash || public key || signature):
     CSHA256 m_salted_hasher_ecdsa;
     CSHA256 m_salted_hasher_schnorr;
-    typedef CuckooCache::cache<uint256, SignatureCacheHasher> map_type;
-    map_type setValid;
-    std::shared_mutex cs_sigcache;
+    ShardedCuckooCache setValid;
 
 public:
     SignatureCache(size_t max_size_bytes);
@@ -58,11 +105,13 @@ public:
     bool Get(const uint256& entry, const bool erase);
 
     void Set(const uint256& entry);
+
+    CuckooCacheStats GetStats() const { return setValid.GetStats(); }
 };
 
 class CachingTransactionSignatureChecker : public TransactionSignatureChecker
 {
-private:
+protected:
     bool store;
     SignatureCache& m_signature_cache;
 
@@ -73,4 +122,49 @@ public:
     bool VerifySchnorrSignature(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash) const override;
 };
 
+/**
+ * Schnorr signatures whose verification was deferred by a
+ * BatchingTransactionSignatureChecker, so that they can be verified together.
+ */
+class SchnorrBatch
+{
+private:
+    //! Below this size, verifying the signatures one by one is faster.
+    static constexpr size_t MIN_BATCH_SIZE{32};
+
+    std::vector<SchnorrSignatureCheck> m_checks;
+    //! Signature cache entries to add once the signatures are verified.
+    std::vector<std::pair<SignatureCache*, uint256>> m_cache_entries;
+
+public:
+    /** Defer the verification of a Schnorr signature.  If cache is not
+     *  nullptr, entry is added to it once the batch is verified. */
+    void Add(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash, SignatureCache* cache, const uint256& entry);
+
+    /** Verify all deferred signatures and clear the batch.  Returns whether
+     *  all of them are valid (which is true for an empty batch). */
+    bool Verify();
+
+    size_t size() const { return m_checks.size(); }
+};
+
+/**
+ * A CachingTransactionSignatureChecker that defers the verification of
+ * Schnorr signatures which are not in the signature cache to a SchnorrBatch.
+ *
+ * Deferred signatures count as valid.  This is safe because a Schnorr
+ * signature that fails to verify always makes the script fail: if a script
+ * passes with this checker, it is valid iff the batch verifies.
+ */
+class BatchingTransactionSignatureChecker : public CachingTransactionSignatureChecker
+{
+private:
+    SchnorrBatch& m_batch;
+
+public:
+    BatchingTransactionSignatureChecker(const CTransaction* txToIn, unsigned int nInIn, const CAmount& amountIn, bool storeIn, SignatureCache& signature_cache, PrecomputedTransactionData& txdataIn, SchnorrBatch& batch) : CachingTransactionSignatureChecker(txToIn, nInIn, amountIn, storeIn, signature_cache, txdataIn), m_batch(batch) {}
+
+    bool VerifySchnorrSignature(std::span<const unsigned char> sig, const XOnlyPubKey& pubkey, const uint256& sighash) const override;
+};
+
 #endif // BITCOIN_SCRIPT_SIGCACHE_H
@@ -158,8 +158,11 @@ TxoutType Solver(const CScript& scriptPubKey, std::vector<std::vector<unsigned c
     vSolutionsRet.clear();
 
     // If we have a name script, strip the prefix
-    const CNameScript nameOp(scriptPubKey);
-    const CScript& script = nameOp.getAddress();
+    const NameScriptView nameOp(scriptPubKey);
+    CScript stripped;
+    if (nameOp.isNameOp())
+        stripped = nameOp.getAddressScript();
+    const CScript& script = nameOp.isNameOp() ? stripped : scriptPubKey;
 
     // Shortcut for pay-to-script-hash, which are more constrained than the other types:
     // it is always OP_HASH160 20 [20 byte hash] OP_EQUAL
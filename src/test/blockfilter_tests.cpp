@@ -41,6 +41,29 @@ BOOST_AUTO_TEST_CASE(gcsfilter_test)
     }
 }
 
+BOOST_AUTO_TEST_CASE(gcsfilter_large_set)
+{
+    // Large enough for the hashed elements to be radix sorted
+    GCSFilter::ElementSet elements;
+    for (int i = 0; i < 5000; ++i) {
+        GCSFilter::Element element(32);
+        element[0] = static_cast<unsigned char>(i);
+        element[1] = static_cast<unsigned char>(i >> 8);
+        elements.insert(std::move(element));
+    }
+
+    const GCSFilter filter({1, 2, BASIC_FILTER_P, BASIC_FILTER_M}, elements);
+    BOOST_CHECK_EQUAL(filter.GetN(), elements.size());
+    for (const auto& element : elements) {
+        BOOST_CHECK(filter.Match(element));
+    }
+    BOOST_CHECK(filter.MatchAny(elements));
+
+    // The encoding round-trips
+    const GCSFilter decoded({1, 2, BASIC_FILTER_P, BASIC_FILTER_M}, filter.GetEncoded(), /*skip_decode_check=*/false);
+    BOOST_CHECK_EQUAL(decoded.GetN(), elements.size());
+}
+
 BOOST_AUTO_TEST_CASE(gcsfilter_default_constructor)
 {
     GCSFilter filter;
@@ -17,6 +17,8 @@
 #include <test/util/logging.h>
 #include <test/util/setup_common.h>
 
+#include <fstream>
+
 using node::STORAGE_HEADER_BYTES;
 using node::BlockManager;
 using node::KernelNotifications;
@@ -220,4 +222,148 @@ BOOST_AUTO_TEST_CASE(blockmanager_flush_block_file)
     BOOST_CHECK_EQUAL(read_block.nVersion, 2);
 }
 
+BOOST_FIXTURE_TEST_CASE(blockmanager_block_index_snapshot, TestChain100Setup)
+{
+    LOCK(cs_main);
+    BlockManager& blockman{m_node.chainman->m_blockman};
+    std::vector<CBlockIndex*> sorted_by_height;
+    for (const CBlockIndex* pindex{m_node.chainman->ActiveChain().Tip()}; pindex; pindex = pindex->pprev) {
+        sorted_by_height.insert(sorted_by_height.begin(), blockman.LookupBlockIndex(pindex->GetBlockHash()));
+    }
+
+    const fs::path path{m_args.GetDataDirNet() / "blockindex_test.dat"};
+    const uint256 id{m_rng.rand256()};
+    const uint256 block_files_hash{m_rng.rand256()};
+    BOOST_REQUIRE(node::WriteBlockIndexSnapshot(path, id, block_files_hash, sorted_by_height));
+
+    node::BlockMap loaded;
+    const auto insert{[&](const uint256& hash) -> CBlockIndex* {
+        if (hash.IsNull()) return nullptr;
+        const auto [it, inserted]{loaded.try_emplace(hash)};
+        if (inserted) it->second.phashBlock = &it->first;
+        return &it->second;
+    }};
+    const auto entries{node::ReadBlockIndexSnapshot(path, id, block_files_hash, [&](size_t count) { loaded.reserve(count); }, insert)};
+    BOOST_REQUIRE(entries);
+    BOOST_REQUIRE_EQUAL(entries->size(), sorted_by_height.size());
+    for (size_t i = 0; i < entries->size(); ++i) {
+        const CBlockIndex& expected{*sorted_by_height[i]};
+        const CBlockIndex& actual{*(*entries)[i]};
+        BOOST_CHECK_EQUAL(actual.GetBlockHash(), expected.GetBlockHash());
+        BOOST_CHECK_EQUAL(actual.pprev ? actual.pprev->GetBlockHash() : uint256{}, expected.pprev ? expected.pprev->GetBlockHash() : uint256{});
+        BOOST_CHECK_EQUAL(actual.nHeight, expected.nHeight);
+        BOOST_CHECK_EQUAL(actual.nFile, expected.nFile);
+        BOOST_CHECK_EQUAL(actual.nDataPos, expected.nDataPos);
+        BOOST_CHECK_EQUAL(actual.nUndoPos, expected.nUndoPos);
+        BOOST_CHECK_EQUAL(actual.hashMerkleRoot, expected.hashMerkleRoot);
+        BOOST_CHECK_EQUAL(actual.nTime, expected.nTime);
+        BOOST_CHECK_EQUAL(actual.nBits, expected.nBits);
+        BOOST_CHECK_EQUAL(actual.nNonce, expected.nNonce);
+        BOOST_CHECK_EQUAL(actual.nStatus, expected.nStatus);
+        BOOST_CHECK(actual.algo == expected.algo);
+        BOOST_CHECK_EQUAL(actual.nTx, expected.nTx);
+    }
+
+    // A snapshot that does not belong to the block tree database is ignored
+    loaded.clear();
+    BOOST_CHECK(!node::ReadBlockIndexSnapshot(path, m_rng.rand256(), block_files_hash, [&](size_t count) { loaded.reserve(count); }, insert));
+    BOOST_CHECK(loaded.empty());
+    BOOST_CHECK(!node::ReadBlockIndexSnapshot(path, id, m_rng.rand256(), [&](size_t count) { loaded.reserve(count); }, insert));
+    BOOST_CHECK(loaded.empty());
+    BOOST_CHECK(!node::ReadBlockIndexSnapshot(m_args.GetDataDirNet() / "missing.dat", id, block_files_hash, [&](size_t count) { loaded.reserve(count); }, insert));
+
+    // A corrupted entry fails the checksum
+    {
+        std::fstream file{path, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekg(-100, std::ios::end);
+        const char byte{static_cast<char>(file.get() ^ 0x01)};
+        file.seekp(-100, std::ios::end);
+        file.put(byte);
+    }
+    BOOST_CHECK(!node::ReadBlockIndexSnapshot(path, id, block_files_hash, [&](size_t count) { loaded.reserve(count); }, insert));
+}
+
+BOOST_FIXTURE_TEST_CASE(blockmanager_load_block_index_snapshot, TestChain100Setup)
+{
+    LOCK(cs_main);
+    KernelNotifications notifications{Assert(m_node.shutdown_request), m_node.exit_status, *Assert(m_node.warnings)};
+    const fs::path blocks_dir{m_args.GetDataDirNet() / "snapshot_blocks"};
+    fs::create_directories(blocks_dir);
+    const BlockManager::Options blockman_opts{
+        .chainparams = m_node.chainman->GetParams(),
+        .blocks_dir = blocks_dir,
+        .notifications = notifications,
+        .block_tree_db_params = DBParams{
+            .path = blocks_dir / "index",
+            .cache_bytes = 0,
+        },
+    };
+    const auto make_blockman{[&] { return std::make_unique<BlockManager>(*Assert(m_node.shutdown_signal), blockman_opts); }};
+
+    // Store the headers of the active chain in an on-disk block tree database,
+    // and write the snapshot as on shutdown
+    const CBlockIndex& tip{*m_node.chainman->ActiveChain().Tip()};
+    {
+        auto blockman{make_blockman()};
+        CBlockIndex* best_header{nullptr};
+        for (int height{0}; height <= tip.nHeight; ++height) {
+            CBlock block;
+            BOOST_REQUIRE(m_node.chainman->m_blockman.ReadBlock(block, *m_node.chainman->ActiveChain()[height]));
+            blockman->AddToBlockIndex(block, best_header);
+        }
+        BOOST_REQUIRE(blockman->WriteBlockIndexDB());
+        BOOST_REQUIRE(blockman->WriteBlockIndexSnapshot());
+    }
+
+    // The snapshot is loaded once, and its id erased
+    uint256 id;
+    {
+        auto blockman{make_blockman()};
+        BOOST_REQUIRE(blockman->m_block_tree_db->ReadBlockIndexSnapshotId(id));
+        ASSERT_DEBUG_LOG("Loaded 101 block index entries from snapshot");
+        BOOST_REQUIRE(blockman->LoadBlockIndexDB(std::nullopt));
+        BOOST_CHECK(!blockman->m_block_tree_db->ReadBlockIndexSnapshotId(id));
+        BOOST_CHECK_EQUAL(blockman->m_block_index.size(), 101U);
+        CBlockIndex* loaded_tip{blockman->LookupBlockIndex(tip.GetBlockHash())};
+        BOOST_REQUIRE(loaded_tip);
+        BOOST_CHECK_EQUAL(loaded_tip->nHeight, tip.nHeight);
+        BOOST_CHECK_EQUAL(loaded_tip->nChainWork, tip.nChainWork);
+        BOOST_CHECK_EQUAL(loaded_tip->pprev->GetBlockHash(), tip.pprev->GetBlockHash());
+
+        // Write a new snapshot, then change the tip entry in the database
+        // without erasing the id, like a version without snapshots would
+        BOOST_REQUIRE(blockman->WriteBlockIndexSnapshot());
+        BOOST_REQUIRE(blockman->m_block_tree_db->ReadBlockIndexSnapshotId(id));
+        loaded_tip->nStatus |= BLOCK_FAILED_VALID;
+        BOOST_REQUIRE(blockman->m_block_tree_db->WriteBatchSync({}, 0, {loaded_tip}));
+        BOOST_REQUIRE(blockman->m_block_tree_db->WriteBlockIndexSnapshotId(id));
+    }
+
+    // A snapshot that does not match the tip in the database is ignored
+    {
+        auto blockman{make_blockman()};
+        ASSERT_DEBUG_LOG("Block index snapshot does not match the block tree database");
+        BOOST_REQUIRE(blockman->LoadBlockIndexDB(std::nullopt));
+        BOOST_CHECK_EQUAL(blockman->m_block_index.size(), 101U);
+        BOOST_CHECK(blockman->LookupBlockIndex(tip.GetBlockHash())->nStatus & BLOCK_FAILED_VALID);
+        BOOST_REQUIRE(blockman->WriteBlockIndexSnapshot());
+    }
+
+    // A corrupted snapshot is ignored
+    {
+        std::fstream file{blocks_dir / node::BLOCK_INDEX_SNAPSHOT_FILENAME, std::ios::in | std::ios::out | std::ios::binary};
+        file.seekg(-100, std::ios::end);
+        const char byte{static_cast<char>(file.get() ^ 0x01)};
+        file.seekp(-100, std::ios::end);
+        file.put(byte);
+    }
+    {
+        auto blockman{make_blockman()};
+        ASSERT_DEBUG_LOG("is corrupted, ignoring it");
+        BOOST_REQUIRE(blockman->LoadBlockIndexDB(std::nullopt));
+        BOOST_CHECK_EQUAL(blockman->m_block_index.size(), 101U);
+        BOOST_CHECK(!blockman->m_block_tree_db->ReadBlockIndexSnapshotId(id));
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
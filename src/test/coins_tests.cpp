@@ -1042,6 +1042,58 @@ BOOST_FIXTURE_TEST_CASE(ccoins_flush_behavior, FlushTest)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(ccoins_range_cursors, BasicTestingSetup)
+{
+    CCoinsViewDB base{{.path = "test", .cache_bytes = 1 << 23, .memory_only = true}, {}};
+    {
+        CCoinsViewCache cache{&base};
+        for (int i = 0; i < 500; ++i) {
+            const Txid txid{Txid::FromUint256(m_rng.rand256())};
+            const uint32_t num_outputs(1 + m_rng.randrange(4));
+            for (uint32_t n = 0; n < num_outputs; ++n) {
+                cache.AddCoin(COutPoint{txid, n}, Coin{CTxOut{1 + i, CScript{} << OP_TRUE}, 1, false}, /*possible_overwrite=*/false);
+            }
+        }
+        cache.SetBestBlock(m_rng.rand256());
+        BOOST_CHECK(cache.Flush());
+    }
+
+    const auto read_cursor{[](CCoinsViewCursor& cursor, std::vector<COutPoint>& outpoints) {
+        for (; cursor.Valid(); cursor.Next()) {
+            COutPoint key;
+            BOOST_REQUIRE(cursor.GetKey(key));
+            outpoints.push_back(key);
+        }
+    }};
+    std::vector<COutPoint> expected;
+    read_cursor(*base.Cursor(), expected);
+    BOOST_CHECK(expected.size() >= 500);
+
+    // The ranges are consecutive and together cover the whole set
+    for (const size_t max_ranges : {1, 3, 16, 256, 1000}) {
+        const auto cursors{base.RangeCursors(max_ranges)};
+        BOOST_CHECK_EQUAL(cursors.size(), std::min<size_t>(max_ranges, 256));
+        std::vector<COutPoint> outpoints;
+        for (const auto& cursor : cursors) {
+            BOOST_CHECK(cursor->GetBestBlock() == base.GetBestBlock());
+            read_cursor(*cursor, outpoints);
+        }
+        BOOST_CHECK(outpoints == expected);
+    }
+
+    // The cursors keep reading the state from when they were created
+    const auto cursors{base.RangeCursors(4)};
+    {
+        CCoinsViewCache cache{&base};
+        cache.AddCoin(COutPoint{Txid::FromUint256(m_rng.rand256()), 0}, Coin{CTxOut{1, CScript{} << OP_TRUE}, 1, false}, /*possible_overwrite=*/false);
+        cache.SetBestBlock(m_rng.rand256());
+        BOOST_CHECK(cache.Flush());
+    }
+    std::vector<COutPoint> outpoints;
+    for (const auto& cursor : cursors) read_cursor(*cursor, outpoints);
+    BOOST_CHECK(outpoints == expected);
+}
+
 BOOST_AUTO_TEST_CASE(coins_resource_is_used)
 {
     CCoinsMapMemoryResource resource;
@@ -114,4 +114,50 @@ BOOST_FIXTURE_TEST_CASE(coinstatsindex_unclean_shutdown, TestChain100Setup)
     }
 }
 
+// Sync with set hash changes prepared on worker threads, and check the result
+// against the UTXO set hash computed from the coins, also after a reorg that
+// the index rewinds through CustomRemove.
+BOOST_FIXTURE_TEST_CASE(coinstatsindex_prepared_muhash, TestChain100Setup)
+{
+    Chainstate& chainstate = Assert(m_node.chainman)->ActiveChainstate();
+    const auto check_muhash{[&](const CoinStatsIndex& index) {
+        chainstate.ForceFlushStateToDisk();
+        LOCK(cs_main);
+        const auto expected{kernel::ComputeUTXOStats(kernel::CoinStatsHashType::MUHASH, &chainstate.CoinsDB(), chainstate.m_blockman)};
+        const auto stats{index.LookUpStats(*chainstate.m_chain.Tip())};
+        BOOST_REQUIRE(expected);
+        BOOST_REQUIRE(stats);
+        BOOST_CHECK_EQUAL(stats->hashSerialized, expected->hashSerialized);
+    }};
+
+    // Make the first coinbase spendable after the reorg below
+    mineBlocks(3);
+    {
+        CoinStatsIndex index{interfaces::MakeChain(m_node), 1 << 20, /*f_memory=*/false, /*f_wipe=*/true};
+        BOOST_REQUIRE(index.Init());
+        index.Sync();
+        check_muhash(index);
+        index.Stop();
+    }
+
+    // Replace the last blocks with a longer branch that also spends a coin
+    for (int i = 0; i < 3; ++i) {
+        BlockValidationState state;
+        chainstate.InvalidateBlock(state, WITH_LOCK(cs_main, return chainstate.m_chain.Tip()));
+    }
+    const CScript script_pub_key{CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG};
+    const auto tx{CreateValidMempoolTransaction(m_coinbase_txns[0], 0, 0, coinbaseKey, script_pub_key, CAmount(1 * COIN), /*submit=*/false)};
+    CreateAndProcessBlock({tx}, script_pub_key);
+    for (int i = 0; i < 4; ++i) CreateAndProcessBlock({}, script_pub_key);
+    BOOST_REQUIRE_EQUAL(WITH_LOCK(cs_main, return chainstate.m_chain.Height()), 105);
+
+    {
+        CoinStatsIndex index{interfaces::MakeChain(m_node), 1 << 20};
+        BOOST_REQUIRE(index.Init());
+        index.Sync();
+        check_muhash(index);
+        index.Stop();
+    }
+}
+
 BOOST_AUTO_TEST_SUITE_END()
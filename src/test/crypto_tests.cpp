@@ -848,6 +848,85 @@ BOOST_AUTO_TEST_CASE(chacha20_midblock)
     BOOST_CHECK(std::ranges::equal(std::span{block}.last(52), b3));
 }
 
+BOOST_AUTO_TEST_CASE(chacha20_implementations)
+{
+    // Compare the vectorized implementations against the standard one, for
+    // lengths around the 4 and 8 block group sizes and block counters that
+    // carry into the nonce word.
+    struct Case {
+        std::vector<std::byte> key, input;
+        ChaCha20::Nonce96 nonce;
+        uint32_t counter;
+        std::vector<std::byte> keystream, ciphertext;
+    };
+    std::vector<Case> cases;
+    ChaCha20AutoDetect(chacha20_implementation::STANDARD);
+    for (size_t blocks = 0; blocks <= 20; ++blocks) {
+        Case c;
+        c.key = m_rng.randbytes<std::byte>(ChaCha20::KEYLEN);
+        c.input = m_rng.randbytes<std::byte>(blocks * ChaCha20Aligned::BLOCKLEN + m_rng.randrange(ChaCha20Aligned::BLOCKLEN));
+        c.nonce = {m_rng.rand32(), m_rng.rand64()};
+        c.counter = m_rng.randbool() ? m_rng.rand32() : uint32_t(-m_rng.randrange(10));
+        c.keystream.resize(c.input.size());
+        c.ciphertext.resize(c.input.size());
+        ChaCha20 chacha{c.key};
+        chacha.Seek(c.nonce, c.counter);
+        chacha.Keystream(c.keystream);
+        chacha.Seek(c.nonce, c.counter);
+        chacha.Crypt(c.input, c.ciphertext);
+        cases.push_back(std::move(c));
+    }
+
+    for (const auto impl : {chacha20_implementation::STANDARD, chacha20_implementation::USE_SSE2, chacha20_implementation::USE_ALL}) {
+        BOOST_TEST_MESSAGE("Testing the '" << ChaCha20AutoDetect(impl) << "' ChaCha20 implementation");
+        for (const auto& c : cases) {
+            std::vector<std::byte> out(c.input.size());
+            ChaCha20 chacha{c.key};
+            chacha.Seek(c.nonce, c.counter);
+            chacha.Keystream(out);
+            BOOST_CHECK(out == c.keystream);
+            chacha.Seek(c.nonce, c.counter);
+            chacha.Crypt(c.input, out);
+            BOOST_CHECK(out == c.ciphertext);
+        }
+    }
+    ChaCha20AutoDetect();
+}
+
+BOOST_AUTO_TEST_CASE(poly1305_implementations)
+{
+    // Compare the vectorized implementation against the standard one, writing
+    // the messages in one go and in random pieces.
+    std::vector<std::vector<std::byte>> keys, msgs, tags;
+    Poly1305AutoDetect(poly1305_implementation::STANDARD);
+    for (size_t len = 0; len < 1200; len += 1 + m_rng.randrange(40)) {
+        keys.push_back(m_rng.randbytes<std::byte>(Poly1305::KEYLEN));
+        msgs.push_back(m_rng.randbytes<std::byte>(len));
+        tags.emplace_back(Poly1305::TAGLEN);
+        Poly1305{keys.back()}.Update(msgs.back()).Finalize(tags.back());
+    }
+
+    for (const auto impl : {poly1305_implementation::STANDARD, poly1305_implementation::USE_ALL}) {
+        BOOST_TEST_MESSAGE("Testing the '" << Poly1305AutoDetect(impl) << "' Poly1305 implementation");
+        for (size_t i = 0; i < msgs.size(); ++i) {
+            std::vector<std::byte> tag(Poly1305::TAGLEN);
+            Poly1305{keys[i]}.Update(msgs[i]).Finalize(tag);
+            BOOST_CHECK(tag == tags[i]);
+
+            Poly1305 poly{keys[i]};
+            std::span<const std::byte> rest{msgs[i]};
+            while (!rest.empty()) {
+                const size_t piece{m_rng.randrange(rest.size()) + 1};
+                poly.Update(rest.first(piece));
+                rest = rest.subspan(piece);
+            }
+            poly.Finalize(tag);
+            BOOST_CHECK(tag == tags[i]);
+        }
+    }
+    Poly1305AutoDetect();
+}
+
 BOOST_AUTO_TEST_CASE(poly1305_testvector)
 {
     // RFC 7539, section 2.5.2.
@@ -1086,6 +1165,26 @@ BOOST_AUTO_TEST_CASE(sha256d64)
     }
 }
 
+BOOST_AUTO_TEST_CASE(sha256d_multi)
+{
+    for (int n = 0; n <= 40; ++n) {
+        // Mix lengths around the padding boundaries with some longer messages,
+        // so that lanes finish at different times.
+        std::vector<std::vector<unsigned char>> msgs(n);
+        for (auto& msg : msgs) {
+            const size_t len = m_rng.randbool() ? m_rng.randrange(130) : m_rng.randrange(2000);
+            msg = m_rng.randbytes(len);
+        }
+        const std::vector<std::span<const unsigned char>> inputs(msgs.begin(), msgs.end());
+        std::vector<unsigned char> out1(32 * n), out2(32 * n);
+        for (int j = 0; j < n; ++j) {
+            CHash256().Write(msgs[j]).Finalize({out1.data() + 32 * j, 32});
+        }
+        SHA256DMulti(out2.data(), inputs);
+        BOOST_CHECK(out1 == out2);
+    }
+}
+
 void CryptoTest::TestSHA3_256(const std::string& input, const std::string& output)
 {
     const auto in_bytes = ParseHex(input);
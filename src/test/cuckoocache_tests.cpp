@@ -10,6 +10,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <deque>
 #include <mutex>
 #include <shared_mutex>
@@ -121,6 +122,65 @@ BOOST_FIXTURE_TEST_CASE(cuckoocache_hit_rate_ok, HitRateTest)
     }
 }
 
+/** Check that sharding keeps the hit rate of an unsharded cache of the same
+ * total size, and that the usage counters add up. */
+BOOST_AUTO_TEST_CASE(sharded_cuckoocache_hit_rate_ok)
+{
+    SeedRandomForTest(SeedRand::ZEROS);
+    const size_t bytes = 4 << 20;
+    for (double load = 0.1; load < 2; load *= 2) {
+        ShardedCuckooCache set{};
+        set.Setup(bytes);
+        const uint32_t n_insert = static_cast<uint32_t>(load * (bytes / sizeof(uint256)));
+        std::vector<uint256> hashes(n_insert);
+        for (uint256& h : hashes) h = m_rng.rand256();
+        for (const uint256& h : hashes) set.Insert(h);
+        uint32_t count = 0;
+        for (const uint256& h : hashes) count += set.Contains(h, false);
+        const double hit_rate = double(count) / double(n_insert);
+        BOOST_CHECK(hit_rate * std::max(load, 1.0) > 0.98);
+
+        const CuckooCacheStats stats = set.GetStats();
+        BOOST_CHECK_EQUAL(stats.inserts, n_insert);
+        BOOST_CHECK_EQUAL(stats.hits, count);
+        BOOST_CHECK_EQUAL(stats.misses, n_insert - count);
+        BOOST_CHECK_EQUAL(stats.max_entries, bytes / sizeof(uint256));
+    }
+}
+
+/** Insert into and look up in a sharded cache from several threads. */
+BOOST_AUTO_TEST_CASE(sharded_cuckoocache_parallel)
+{
+    SeedRandomForTest(SeedRand::ZEROS);
+    constexpr size_t N_THREADS{4};
+    constexpr size_t N_PER_THREAD{20000};
+    ShardedCuckooCache set{};
+    set.Setup(4 << 20);
+    std::vector<std::vector<uint256>> hashes(N_THREADS);
+    for (auto& thread_hashes : hashes) {
+        thread_hashes.resize(N_PER_THREAD);
+        for (uint256& h : thread_hashes) h = m_rng.rand256();
+    }
+
+    std::vector<std::thread> threads;
+    for (const auto& thread_hashes : hashes) {
+        threads.emplace_back([&set, &thread_hashes] {
+            for (const uint256& h : thread_hashes) {
+                if (!set.Contains(h, false)) set.Insert(h);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+
+    for (const auto& thread_hashes : hashes) {
+        for (const uint256& h : thread_hashes) BOOST_CHECK(set.Contains(h, false));
+    }
+    const CuckooCacheStats stats = set.GetStats();
+    BOOST_CHECK_EQUAL(stats.inserts, N_THREADS * N_PER_THREAD);
+    BOOST_CHECK_EQUAL(stats.misses, N_THREADS * N_PER_THREAD);
+    BOOST_CHECK_EQUAL(stats.hits, N_THREADS * N_PER_THREAD);
+}
+
 
 struct EraseTest : BasicTestingSetup {
 /** This helper checks that erased elements are preferentially inserted onto and
@@ -152,6 +152,8 @@ const std::vector<std::string> RPC_COMMANDS_SAFE_FOR_FUZZING{
     "gettxout",
     "gettxoutsetinfo",
     "gettxspendingprevout",
+    "getvalidationcacheinfo",
+    "getvalidationqueueinfo",
     "help",
     "invalidateblock",
     "joinpsbts",
@@ -0,0 +1,26 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#include <test/fuzz/fuzz.h>
+
+#include <univalue.h>
+
+#include <cassert>
+#include <string>
+
+FUZZ_TARGET(univalue_validate)
+{
+    const std::string str(buffer.begin(), buffer.end());
+
+    UniValue val;
+    const bool read_ok{val.read(str)};
+
+    UniValue::VType type;
+    bool minimal;
+    assert(UniValue::validate(str, &type, &minimal) == read_ok);
+    if (!read_ok) return;
+
+    assert(type == val.getType());
+    assert(minimal == (val.write(0, 0) == str));
+}
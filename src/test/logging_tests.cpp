@@ -11,6 +11,7 @@
 #include <chrono>
 #include <fstream>
 #include <iostream>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -276,4 +277,49 @@ BOOST_FIXTURE_TEST_CASE(logging_Conf, LogSetup)
     }
 }
 
+BOOST_AUTO_TEST_CASE(logging_async)
+{
+    BCLog::Logger logger;
+    logger.m_file_path = m_args.GetDataDirBase() / "async_debug.log";
+    logger.m_print_to_file = true;
+    logger.m_log_timestamps = false;
+    logger.m_async = true;
+    BOOST_REQUIRE(logger.StartLogging());
+
+    // More messages than fit into a queue, so that the threads have to wait
+    // for the writer.
+    constexpr int NUM_THREADS{4};
+    constexpr int MESSAGES_PER_THREAD{3 * BCLog::ASYNC_LOG_QUEUE_SIZE};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < NUM_THREADS; ++t) {
+        threads.emplace_back([&logger, t] {
+            for (int i = 0; i < MESSAGES_PER_THREAD; ++i) {
+                logger.LogPrintStr(strprintf("%d %d", t, i), "fn", "src", 1, BCLog::LogFlags::ALL, BCLog::Level::Info);
+            }
+        });
+    }
+    for (auto& thread : threads) thread.join();
+    logger.StopAsyncLogging();
+
+    // Messages logged after stopping are written directly
+    logger.LogPrintStr("sync", "fn", "src", 1, BCLog::LogFlags::ALL, BCLog::Level::Info);
+    logger.DisconnectTestLogger();
+
+    std::ifstream file{logger.m_file_path};
+    std::vector<int> next_message(NUM_THREADS, 0);
+    std::string last_line;
+    for (std::string line; std::getline(file, line);) {
+        if (line.empty()) continue;
+        last_line = line;
+        if (line == "sync") break;
+        const auto parts{SplitString(line, ' ')};
+        BOOST_REQUIRE_EQUAL(parts.size(), 2U);
+        const int t{std::stoi(parts[0])};
+        BOOST_REQUIRE(t >= 0 && t < NUM_THREADS);
+        BOOST_CHECK_EQUAL(std::stoi(parts[1]), next_message[t]++);
+    }
+    BOOST_CHECK_EQUAL(last_line, "sync");
+    for (const int count : next_message) BOOST_CHECK_EQUAL(count, MESSAGES_PER_THREAD);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
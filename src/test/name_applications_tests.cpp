@@ -58,6 +58,12 @@ BOOST_AUTO_TEST_CASE( minimal_json )
     BOOST_CHECK_EQUAL(IsMinimalJSONOrEmptyString(""), true);
 
     BOOST_CHECK_EQUAL(IsMinimalJSONOrEmptyString("{\"bar\":[1, 2, 3]}"), false);
+
+    BOOST_CHECK_EQUAL(IsMinimalJSONOrEmptyString("{\"bar\":\"a\\n\\\"b\"}"), true);
+
+    BOOST_CHECK_EQUAL(IsMinimalJSONOrEmptyString("{\"bar\":\"\\u0061\"}"), false);
+
+    BOOST_CHECK_EQUAL(IsMinimalJSONOrEmptyString("{\"bar\":1} "), false);
 }
 
 BOOST_AUTO_TEST_SUITE_END()
@@ -22,6 +22,7 @@
 
 #include <boost/test/unit_test.hpp>
 
+#include <algorithm>
 #include <cassert>
 #include <list>
 #include <memory>
@@ -134,6 +135,50 @@ BOOST_AUTO_TEST_CASE (name_scripts)
   BOOST_CHECK (opUpdate.getOpValue () == value);
 }
 
+BOOST_AUTO_TEST_CASE (name_script_view)
+{
+  const CScript addr = getTestAddress ();
+  const NameScriptView viewNone(addr);
+  BOOST_CHECK (!viewNone.isNameOp ());
+  BOOST_CHECK (viewNone.getAddressScript () == addr);
+  BOOST_CHECK (!CNameScript (viewNone).isNameOp ());
+
+  const valtype name = DecodeName ("x/my-cool-name", NameEncoding::ASCII);
+  const valtype value(1'000, 'x');
+
+  const CScript script = CNameScript::buildNameUpdate (addr, name, value);
+  const NameScriptView view(script);
+  BOOST_CHECK (view.isNameOp ());
+  BOOST_CHECK (view.getNameOp () == OP_NAME_UPDATE);
+  BOOST_CHECK (std::ranges::equal (view.getOpName (), name));
+  BOOST_CHECK (std::ranges::equal (view.getOpValue (), value));
+  BOOST_CHECK (view.getAddressScript () == addr);
+
+  /* The view refers to the script's data.  */
+  BOOST_CHECK (view.getOpValue ().data () > script.data ());
+  BOOST_CHECK (view.getAddress ().data () + addr.size ()
+                  == script.data () + script.size ());
+
+  const CNameScript owned(view);
+  BOOST_CHECK (owned.getNameOp () == OP_NAME_UPDATE);
+  BOOST_CHECK (owned.getOpName () == name);
+  BOOST_CHECK (owned.getOpValue () == value);
+  BOOST_CHECK (owned.getAddress () == addr);
+
+  /* Scripts that are not quite name operations, including ones that start
+     with a name opcode.  */
+  const CScript wrongArgs = CScript () << OP_NAME_UPDATE << name
+                                       << OP_2DROP << OP_DROP;
+  const CScript noDrop = CScript () << OP_NAME_UPDATE << name << value;
+  const CScript taproot = CScript () << OP_1 << valtype (32, 0x01);
+  for (const auto& s : {wrongArgs, noDrop, taproot})
+    {
+      BOOST_CHECK (!NameScriptView (s).isNameOp ());
+      BOOST_CHECK (!CNameScript (s).isNameOp ());
+      BOOST_CHECK (NameScriptView (s).getAddressScript () == s);
+    }
+}
+
 /* ************************************************************************** */
 
 BOOST_AUTO_TEST_CASE (name_database)
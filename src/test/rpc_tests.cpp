@@ -2,11 +2,13 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <common/args.h>
 #include <core_io.h>
 #include <interfaces/chain.h>
 #include <node/context.h>
 #include <rpc/blockchain.h>
 #include <rpc/client.h>
+#include <rpc/jsonstream.h>
 #include <rpc/server.h>
 #include <rpc/util.h>
 #include <test/util/setup_common.h>
@@ -639,4 +641,109 @@ BOOST_AUTO_TEST_CASE(rpc_arg_helper)
     CheckRpc(params, UniValue{JSON(R"([5, "hello", 4, "test", true, 1.23, "world"])")}, check_positional);
 }
 
+BOOST_AUTO_TEST_CASE(rpc_json_stream_writer)
+{
+    const UniValue value{JSON(R"({"a\"b": [1, "x\ny", {}, [], null, true], "": {"c": -1.5, "d": []}})")};
+
+    // Writing the value piece by piece gives the same as UniValue::write,
+    // whatever the chunk size.
+    for (const size_t chunk_size : {1, 3, 1000}) {
+        std::string out;
+        size_t max_chunk{0};
+        JSONStreamWriter writer{[&](std::string_view chunk) {
+            BOOST_CHECK(!chunk.empty());
+            max_chunk = std::max(max_chunk, chunk.size());
+            out += chunk;
+        }, chunk_size};
+        writer.BeginObject();
+        writer.Key("a\"b");
+        writer.BeginArray();
+        for (const auto& elem : value["a\"b"].getValues()) {
+            writer.Value(elem);
+        }
+        writer.EndArray();
+        writer.Key("");
+        writer.RawValue(value[""].write());
+        writer.EndObject();
+        writer.Flush();
+        BOOST_CHECK_EQUAL(out, value.write());
+        BOOST_CHECK_LE(max_chunk, chunk_size);
+    }
+}
+
+class TestResultStream : public JSONRPCResultStream
+{
+public:
+    std::string out;
+    JSONStreamWriter writer{[this](std::string_view chunk) { out += chunk; }};
+    bool started{false};
+
+    JSONStreamWriter& Start() override
+    {
+        started = true;
+        return writer;
+    }
+    bool Started() const override { return started; }
+};
+
+BOOST_AUTO_TEST_CASE(rpc_streamed_result)
+{
+    const UniValue expected{JSON(R"([{"x": 1}, "y", []])")};
+
+    // Without a stream, the result is returned as usual.
+    RPCStreamedResult plain{nullptr, UniValue::VARR};
+    for (const auto& elem : expected.getValues()) plain.push_back(elem);
+    BOOST_CHECK_EQUAL(plain.Finish().write(), expected.write());
+
+    // With a stream, it is only sent once Finish is called.
+    TestResultStream stream;
+    RPCStreamedResult streamed{&stream, UniValue::VARR};
+    for (const auto& elem : expected.getValues()) streamed.push_back(elem);
+    BOOST_CHECK(!stream.Started());
+    BOOST_CHECK(streamed.Finish().isNull());
+    BOOST_CHECK(stream.Started());
+    stream.writer.Flush();
+    BOOST_CHECK_EQUAL(stream.out, expected.write());
+
+    TestResultStream obj_stream;
+    RPCStreamedResult obj{&obj_stream, UniValue::VOBJ};
+    obj.pushKVEnd("k", 42);
+    obj.pushKVEnd("l", "v");
+    obj.Finish();
+    obj_stream.writer.Flush();
+    BOOST_CHECK_EQUAL(obj_stream.out, R"({"k":42,"l":"v"})");
+}
+
+BOOST_AUTO_TEST_CASE(rpc_streamed_result_doccheck)
+{
+    const auto make_rpc{[](UniValue elem) {
+        return RPCHelpMan{"dummy", "dummy description", {},
+            RPCResult{RPCResult::Type::ARR, "", "", {{RPCResult::Type::NUM, "", "a number"}}},
+            RPCExamples{""},
+            [elem](const RPCHelpMan&, const JSONRPCRequest& request) -> UniValue {
+                RPCStreamedResult res{request.m_result_stream, UniValue::VARR};
+                res.push_back(1);
+                res.push_back(elem);
+                return res.Finish();
+            }};
+    }};
+    gArgs.ForceSetArg("-rpcdoccheck", "1");
+
+    // A streamed result matching the documentation is passed on.
+    TestResultStream stream;
+    JSONRPCRequest req;
+    req.m_result_stream = &stream;
+    BOOST_CHECK(make_rpc(2).HandleRequest(req).isNull());
+    stream.writer.Flush();
+    BOOST_CHECK_EQUAL(stream.out, "[1,2]");
+
+    // A mismatch is reported before anything is sent to the client.
+    TestResultStream bad_stream;
+    req.m_result_stream = &bad_stream;
+    BOOST_CHECK_EXCEPTION(make_rpc("x").HandleRequest(req), std::runtime_error, HasReason{"returned incorrect type"});
+    BOOST_CHECK(!bad_stream.Started());
+
+    gArgs.ForceSetArg("-rpcdoccheck", DEFAULT_RPC_DOC_CHECK ? "1" : "0");
+}
+
 BOOST_AUTO_TEST_SUITE_END()
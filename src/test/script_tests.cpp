@@ -8,6 +8,7 @@
 #include <common/system.h>
 #include <core_io.h>
 #include <key.h>
+#include <pubkey.h>
 #include <rpc/util.h>
 #include <script/script.h>
 #include <script/script_error.h>
@@ -23,6 +24,7 @@
 #include <util/fs.h>
 #include <util/strencodings.h>
 
+#include <algorithm>
 #include <cstdint>
 #include <fstream>
 #include <string>
@@ -1745,4 +1747,55 @@ BOOST_AUTO_TEST_CASE(compute_tapleaf)
     BOOST_CHECK_EQUAL(ComputeTapleafHash(0xc2, std::span(script)), tlc2);
 }
 
+BOOST_AUTO_TEST_CASE(schnorr_batch_verify)
+{
+    // Sizes below and above the threshold for a real batch.
+    for (const size_t n : {1, 5, 31, 32, 100}) {
+        std::vector<SchnorrSignatureCheck> checks;
+        for (size_t i = 0; i < n; ++i) {
+            const CKey key = GenerateRandomKey();
+            SchnorrSignatureCheck check{XOnlyPubKey{key.GetPubKey()}, m_rng.rand256(), {}};
+            BOOST_REQUIRE(key.SignSchnorr(check.msg, check.sig, nullptr, m_rng.rand256()));
+            checks.push_back(check);
+        }
+        BOOST_CHECK(VerifySchnorrBatch(checks));
+
+        SignatureCache cache{DEFAULT_SIGNATURE_CACHE_BYTES};
+        SchnorrBatch batch;
+        std::vector<uint256> entries;
+        for (const auto& check : checks) {
+            cache.ComputeEntrySchnorr(entries.emplace_back(), check.msg, check.sig, check.pubkey);
+            batch.Add(check.sig, check.pubkey, check.msg, &cache, entries.back());
+        }
+        BOOST_CHECK_EQUAL(batch.size(), n);
+        BOOST_CHECK(batch.Verify());
+        BOOST_CHECK_EQUAL(batch.size(), 0U);
+        for (const auto& entry : entries) BOOST_CHECK(cache.Get(entry, /*erase=*/false));
+
+        // A single invalid signature anywhere fails the whole batch, and
+        // nothing is added to the cache.
+        auto& bad = checks[m_rng.randrange(n)];
+        switch (m_rng.randrange(4)) {
+        case 0: bad.sig[m_rng.randrange(64)] ^= 1 << m_rng.randrange(8); break;
+        case 1: bad.msg = m_rng.rand256(); break;
+        case 2: bad.pubkey = XOnlyPubKey{GenerateRandomKey().GetPubKey()}; break;
+        case 3: std::fill(bad.sig.begin() + 32, bad.sig.end(), 0xff); break;
+        }
+        BOOST_CHECK(!VerifySchnorrBatch(checks));
+
+        SignatureCache empty_cache{DEFAULT_SIGNATURE_CACHE_BYTES};
+        entries.clear();
+        for (const auto& check : checks) {
+            empty_cache.ComputeEntrySchnorr(entries.emplace_back(), check.msg, check.sig, check.pubkey);
+            batch.Add(check.sig, check.pubkey, check.msg, &empty_cache, entries.back());
+        }
+        BOOST_CHECK(!batch.Verify());
+        BOOST_CHECK_EQUAL(batch.size(), 0U);
+        for (const auto& entry : entries) BOOST_CHECK(!empty_cache.Get(entry, /*erase=*/false));
+    }
+
+    BOOST_CHECK(VerifySchnorrBatch({}));
+    BOOST_CHECK(SchnorrBatch{}.Verify());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -1038,4 +1038,51 @@ BOOST_AUTO_TEST_CASE(test_IsStandard)
     CheckIsNotStandard(t, "dust");
 }
 
+static std::vector<CMutableTransaction> RandomTransactions(FastRandomContext& rng, size_t count)
+{
+    std::vector<CMutableTransaction> txs(count);
+    for (size_t i = 0; i < txs.size(); ++i) {
+        auto& tx = txs[i];
+        tx.vin.resize(1 + i % 3);
+        for (auto& in : tx.vin) {
+            in.prevout = COutPoint(Txid::FromUint256(rng.rand256()), i);
+            in.scriptSig = CScript() << rng.randbytes(i % 20 * 10);
+            if (i % 2) in.scriptWitness.stack = {rng.randbytes(72), rng.randbytes(33)};
+        }
+        tx.vout.resize(1 + i % 2);
+        for (auto& out : tx.vout) {
+            out.nValue = i;
+            out.scriptPubKey = CScript() << OP_TRUE;
+        }
+    }
+    return txs;
+}
+
+static void CheckTransactionRefs(const std::vector<CMutableTransaction>& txs)
+{
+    const auto refs = MakeTransactionRefs(std::vector<CMutableTransaction>(txs));
+    BOOST_REQUIRE_EQUAL(refs.size(), txs.size());
+    for (size_t i = 0; i < txs.size(); ++i) {
+        const CTransaction expected(txs[i]);
+        BOOST_CHECK_EQUAL(refs[i]->HasWitness(), expected.HasWitness());
+        BOOST_CHECK_EQUAL(refs[i]->GetHash(), expected.GetHash());
+        BOOST_CHECK_EQUAL(refs[i]->GetWitnessHash(), expected.GetWitnessHash());
+        BOOST_CHECK(*refs[i] == expected);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(make_transaction_refs)
+{
+    CheckTransactionRefs(RandomTransactions(m_rng, 20));
+    BOOST_CHECK(MakeTransactionRefs({}).empty());
+
+    // Large enough to be split between the hashing threads.
+    const auto txs{RandomTransactions(m_rng, 2000)};
+    CheckTransactionRefs(txs);
+    StartTransactionHashThreads(3);
+    CheckTransactionRefs(txs);
+    CheckTransactionRefs(RandomTransactions(m_rng, 20));
+    StopTransactionHashThreads();
+}
+
 BOOST_AUTO_TEST_SUITE_END()
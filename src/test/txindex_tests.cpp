@@ -4,13 +4,19 @@
 
 #include <addresstype.h>
 #include <chainparams.h>
+#include <index/synccoordinator.h>
 #include <index/txindex.h>
 #include <interfaces/chain.h>
 #include <test/util/setup_common.h>
+#include <undo.h>
+#include <util/time.h>
 #include <validation.h>
 
 #include <boost/test/unit_test.hpp>
 
+#include <atomic>
+#include <thread>
+
 BOOST_AUTO_TEST_SUITE(txindex_tests)
 
 BOOST_FIXTURE_TEST_CASE(txindex_initial_sync, TestChain100Setup)
@@ -73,4 +79,177 @@ BOOST_FIXTURE_TEST_CASE(txindex_initial_sync, TestChain100Setup)
     txindex.Stop();
 }
 
+BOOST_FIXTURE_TEST_CASE(txindex_compact, TestChain100Setup)
+{
+    const auto check_txs = [&](const TxIndex& txindex, bool expect_found) {
+        for (const auto& txn : m_coinbase_txns) {
+            CTransactionRef tx_disk;
+            uint256 block_hash;
+            BOOST_CHECK_EQUAL(txindex.FindTx(txn->GetHash(), block_hash, tx_disk), expect_found);
+            if (expect_found && tx_disk) BOOST_CHECK_EQUAL(tx_disk->GetHash(), txn->GetHash());
+        }
+    };
+
+    // Build the index in the full format
+    {
+        TxIndex txindex(interfaces::MakeChain(m_node), 1 << 20, /*f_memory=*/false, /*f_wipe=*/true);
+        BOOST_REQUIRE(txindex.Init());
+        txindex.Sync();
+        check_txs(txindex, true);
+    }
+
+    // Enabling the compact format converts the existing entries on the sync
+    // thread, and they can be looked up while that has not happened yet
+    {
+        TxIndex txindex(interfaces::MakeChain(m_node), 1 << 20, /*f_memory=*/false, /*f_wipe=*/false, /*compact=*/true);
+        BOOST_REQUIRE(txindex.Init());
+        BOOST_CHECK(txindex.GetSummary().synced);
+        check_txs(txindex, true);
+    }
+    {
+        TxIndex txindex(interfaces::MakeChain(m_node), 1 << 20, /*f_memory=*/false, /*f_wipe=*/false, /*compact=*/true);
+        BOOST_REQUIRE(txindex.Init());
+        check_txs(txindex, true);
+        txindex.Sync();
+        check_txs(txindex, true);
+
+        // New blocks are indexed in the compact format
+        const CBlock& block = CreateAndProcessBlock({}, GetScriptForDestination(PKHash(coinbaseKey.GetPubKey())));
+        BOOST_CHECK(txindex.BlockUntilSyncedToCurrentChain());
+        CTransactionRef tx_disk;
+        uint256 block_hash;
+        BOOST_CHECK(txindex.FindTx(block.vtx[0]->GetHash(), block_hash, tx_disk));
+        BOOST_CHECK_EQUAL(block_hash, block.GetHash());
+        BOOST_CHECK(!txindex.FindTx(uint256::ONE, block_hash, tx_disk));
+
+        // Replacing the block at the same height erases the entries of the
+        // disconnected block
+        {
+            BlockValidationState state;
+            BOOST_REQUIRE(m_node.chainman->ActiveChainstate().InvalidateBlock(state, WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain().Tip())));
+        }
+        const CBlock& replacement = CreateAndProcessBlock({}, CScript() << OP_TRUE);
+        BOOST_CHECK(txindex.BlockUntilSyncedToCurrentChain());
+        BOOST_CHECK(!txindex.FindTx(block.vtx[0]->GetHash(), block_hash, tx_disk));
+        BOOST_CHECK(txindex.FindTx(replacement.vtx[0]->GetHash(), block_hash, tx_disk));
+        BOOST_CHECK_EQUAL(block_hash, replacement.GetHash());
+        m_node.validation_signals->SyncWithValidationInterfaceQueue();
+        txindex.Stop();
+    }
+
+    // Going back to the full format rebuilds the index
+    {
+        TxIndex txindex(interfaces::MakeChain(m_node), 1 << 20, /*f_memory=*/false, /*f_wipe=*/false, /*compact=*/false);
+        BOOST_REQUIRE(txindex.Init());
+        BOOST_CHECK(!txindex.GetSummary().synced);
+        check_txs(txindex, false);
+        txindex.Sync();
+        check_txs(txindex, true);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(index_sync_coordinator, TestChain100Setup)
+{
+    TxIndex index_a(interfaces::MakeChain(m_node), 1 << 20, true);
+    TxIndex index_b(interfaces::MakeChain(m_node), 1 << 20, true);
+    const CChain& chain{WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain())};
+    const CBlockIndex* tip{WITH_LOCK(::cs_main, return chain.Tip())};
+
+    IndexSyncCoordinator coordinator{m_node.chainman->m_blockman};
+    {
+        const auto registration_a{coordinator.Register(index_a, /*next_height=*/0, /*read_undo=*/false, nullptr)};
+        const auto registration_b{coordinator.Register(index_b, /*next_height=*/0, /*read_undo=*/true, nullptr)};
+        for (const CBlockIndex* pindex{chain.Genesis()}; pindex; pindex = WITH_LOCK(::cs_main, return chain.Next(pindex))) {
+            const IndexSyncCoordinator::Result result_a{coordinator.Next(index_a, pindex, chain)};
+            const IndexSyncCoordinator::Result result_b{coordinator.Next(index_b, pindex, chain)};
+            BOOST_REQUIRE(result_a.read_ok && result_b.read_ok);
+            BOOST_CHECK(!result_a.append_ok && !result_b.append_ok);
+            BOOST_CHECK_EQUAL(result_a.block->GetHash(), pindex->GetBlockHash());
+            // both consumers share the same deserialized block
+            BOOST_CHECK(result_a.block == result_b.block);
+            BOOST_CHECK(!result_a.undo);
+            BOOST_REQUIRE(result_b.undo);
+            BOOST_CHECK_EQUAL(result_b.undo->vtxundo.size(), pindex->nHeight > 0 ? result_b.block->vtx.size() - 1 : 0);
+        }
+    }
+    // each block was read from disk once for both indexes
+    BOOST_CHECK_EQUAL(coordinator.GetBlocksRead(), static_cast<uint64_t>(tip->nHeight + 1));
+    BOOST_CHECK_GT(coordinator.GetBytesRead(), 0U);
+}
+
+BOOST_FIXTURE_TEST_CASE(index_sync_coordinator_far_apart, TestChain100Setup)
+{
+    TxIndex index_a(interfaces::MakeChain(m_node), 1 << 20, true);
+    TxIndex index_b(interfaces::MakeChain(m_node), 1 << 20, true);
+    const CChain& chain{WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain())};
+    const int tip_height{WITH_LOCK(::cs_main, return chain.Height())};
+    const int start_b{2 * IndexSyncCoordinator::READ_AHEAD};
+    BOOST_REQUIRE_LT(start_b, tip_height);
+
+    IndexSyncCoordinator coordinator{m_node.chainman->m_blockman};
+    const auto registration_a{coordinator.Register(index_a, /*next_height=*/0, /*read_undo=*/false, nullptr)};
+    const auto registration_b{coordinator.Register(index_b, /*next_height=*/start_b, /*read_undo=*/true, nullptr)};
+
+    // The consumer ahead of the read window keeps moving, while the other
+    // one does not advance at all.
+    for (int height = start_b; height <= tip_height; ++height) {
+        const CBlockIndex* pindex{WITH_LOCK(::cs_main, return chain[height])};
+        const IndexSyncCoordinator::Result result{coordinator.Next(index_b, pindex, chain)};
+        BOOST_REQUIRE(result.read_ok);
+        BOOST_CHECK_EQUAL(result.block->GetHash(), pindex->GetBlockHash());
+        BOOST_REQUIRE(result.undo);
+        BOOST_CHECK_EQUAL(result.undo->vtxundo.size(), result.block->vtx.size() - 1);
+    }
+
+    // The consumer behind still gets its blocks from the read window
+    for (int height = 0; height < IndexSyncCoordinator::READ_AHEAD; ++height) {
+        const CBlockIndex* pindex{WITH_LOCK(::cs_main, return chain[height])};
+        const IndexSyncCoordinator::Result result{coordinator.Next(index_a, pindex, chain)};
+        BOOST_REQUIRE(result.read_ok);
+        BOOST_CHECK_EQUAL(result.block->GetHash(), pindex->GetBlockHash());
+        BOOST_CHECK(!result.undo);
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(index_sync_coordinator_different_speeds, TestChain100Setup)
+{
+    TxIndex index_fast(interfaces::MakeChain(m_node), 1 << 20, true);
+    TxIndex index_slow(interfaces::MakeChain(m_node), 1 << 20, true);
+    const CChain& chain{WITH_LOCK(::cs_main, return m_node.chainman->ActiveChain())};
+    const int tip_height{WITH_LOCK(::cs_main, return chain.Height())};
+
+    IndexSyncCoordinator coordinator{m_node.chainman->m_blockman};
+    const auto registration_fast{coordinator.Register(index_fast, /*next_height=*/0, /*read_undo=*/false, nullptr)};
+    const auto registration_slow{coordinator.Register(index_slow, /*next_height=*/0, /*read_undo=*/false, nullptr)};
+
+    // The fast consumer waits at the end of the read window instead of
+    // reading the blocks ahead of it on its own.
+    std::atomic<int> slow_height{0};
+    std::atomic<int> max_lead{0};
+    const auto sync{[&](const TxIndex& index, bool slow) {
+        bool ok{true};
+        for (int height = 0; height <= tip_height; ++height) {
+            const CBlockIndex* pindex{WITH_LOCK(::cs_main, return chain[height])};
+            const IndexSyncCoordinator::Result result{coordinator.Next(index, pindex, chain)};
+            ok &= result.read_ok && result.block->GetHash() == pindex->GetBlockHash();
+            if (slow) {
+                slow_height = height + 1;
+                UninterruptibleSleep(std::chrono::milliseconds{1});
+            } else {
+                const int lead{height - slow_height};
+                for (int max{max_lead}; lead > max && !max_lead.compare_exchange_weak(max, lead);) {}
+            }
+        }
+        return ok;
+    }};
+    bool fast_ok{false};
+    std::thread fast_thread{[&] { fast_ok = sync(index_fast, /*slow=*/false); }};
+    BOOST_CHECK(sync(index_slow, /*slow=*/true));
+    fast_thread.join();
+    BOOST_CHECK(fast_ok);
+
+    BOOST_CHECK_LE(max_lead.load(), IndexSyncCoordinator::READ_AHEAD);
+    BOOST_CHECK_EQUAL(coordinator.GetBlocksRead(), uint64_t(tip_height + 1));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
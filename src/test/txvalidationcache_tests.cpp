@@ -2,9 +2,12 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 
+#include <checkqueue.h>
 #include <consensus/validation.h>
 #include <key.h>
 #include <random.h>
+#include <script/interpreter.h>
+#include <script/script_error.h>
 #include <script/sigcache.h>
 #include <script/sign.h>
 #include <script/signingprovider.h>
@@ -20,6 +23,11 @@ struct Dersig100Setup : public TestChain100Setup {
         : TestChain100Setup{ChainType::REGTEST, {.extra_args = {"-testactivationheight=dersig@102"}}} {}
 };
 
+struct BatchSchnorrSetup : public TestChain100Setup {
+    BatchSchnorrSetup()
+        : TestChain100Setup{ChainType::REGTEST, {.batch_schnorr_verification = true}} {}
+};
+
 bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
                        const CCoinsViewCache& inputs, unsigned int flags, bool cacheSigStore,
                        bool cacheFullScriptStore, PrecomputedTransactionData& txdata,
@@ -385,4 +393,117 @@ BOOST_FIXTURE_TEST_CASE(checkinputs_test, Dersig100Setup)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(checkinputs_batch_schnorr, BatchSchnorrSetup)
+{
+    // Enough key path spends for a real batch even if the script check
+    // workers split them up
+    constexpr size_t NUM_INPUTS{200};
+    constexpr size_t BAD_INPUT{150};
+    const CScript p2pk_scriptPubKey = CScript() << ToByteVector(coinbaseKey.GetPubKey()) << OP_CHECKSIG;
+
+    const CKey key{GenerateRandomKey()};
+    const XOnlyPubKey output_key{XOnlyPubKey{key.GetPubKey()}.CreateTapTweak(nullptr)->first};
+    const CScript p2tr_scriptPubKey{GetScriptForDestination(WitnessV1Taproot{output_key})};
+
+    // Fund the key path spends from a mature coinbase
+    CMutableTransaction fund_tx;
+    fund_tx.version = 1;
+    fund_tx.vin.resize(1);
+    fund_tx.vin[0].prevout = COutPoint{m_coinbase_txns[0]->GetHash(), 0};
+    for (size_t i = 0; i < NUM_INPUTS; ++i) fund_tx.vout.emplace_back(10 * CENT, p2tr_scriptPubKey);
+    {
+        std::vector<unsigned char> vchSig;
+        const uint256 hash = SignatureHash(p2pk_scriptPubKey, fund_tx, 0, SIGHASH_ALL, 0, SigVersion::BASE);
+        BOOST_REQUIRE(coinbaseKey.Sign(hash, vchSig));
+        vchSig.push_back((unsigned char)SIGHASH_ALL);
+        fund_tx.vin[0].scriptSig << vchSig;
+    }
+    CreateAndProcessBlock({fund_tx}, p2pk_scriptPubKey);
+
+    CMutableTransaction spend_tx;
+    spend_tx.version = 2;
+    for (size_t i = 0; i < NUM_INPUTS; ++i) spend_tx.vin.emplace_back(COutPoint{fund_tx.GetHash(), static_cast<uint32_t>(i)});
+    spend_tx.vout.emplace_back(NUM_INPUTS * 10 * CENT - CENT, p2pk_scriptPubKey);
+    PrecomputedTransactionData txdata;
+    txdata.Init(spend_tx, std::vector<CTxOut>{fund_tx.vout}, /*force=*/true);
+    std::vector<uint256> sighashes;
+    for (size_t i = 0; i < NUM_INPUTS; ++i) {
+        ScriptExecutionData execdata;
+        execdata.m_annex_init = true;
+        execdata.m_annex_present = false;
+        BOOST_REQUIRE(SignatureHashSchnorr(sighashes.emplace_back(), execdata, spend_tx, i, SIGHASH_DEFAULT, SigVersion::TAPROOT, txdata, MissingDataBehavior::FAIL));
+        std::vector<unsigned char> sig(64);
+        // A null merkle root tweaks the key for a key path spend without scripts
+        BOOST_REQUIRE(key.SignSchnorr(sighashes.back(), sig, &uint256::ZERO, m_rng.rand256()));
+        spend_tx.vin[i].scriptWitness.stack = {sig};
+    }
+    CMutableTransaction bad_tx{spend_tx};
+    bad_tx.vin[BAD_INPUT].scriptWitness.stack[0][0] ^= 1;
+
+    Chainstate& chainstate{m_node.chainman->ActiveChainstate()};
+    const unsigned int flags{SCRIPT_VERIFY_P2SH | SCRIPT_VERIFY_WITNESS | SCRIPT_VERIFY_TAPROOT};
+    // The checks refer to the transaction and txdata, which must outlive them
+    const CTransaction bad{bad_tx};
+    const CTransaction spend{spend_tx};
+    const auto make_checks{[&](const CTransaction& tx, PrecomputedTransactionData& tx_txdata, ValidationCache& validation_cache) EXCLUSIVE_LOCKS_REQUIRED(cs_main) {
+        std::vector<CScriptCheck> checks;
+        TxValidationState state;
+        BOOST_REQUIRE(CheckInputScripts(tx, state, chainstate.CoinsTip(), flags, true, false, tx_txdata, validation_cache, &checks));
+        BOOST_REQUIRE_EQUAL(checks.size(), NUM_INPUTS);
+        return checks;
+    }};
+
+    {
+        LOCK(cs_main);
+
+        // The error of the bad input when the signatures are checked one by one
+        TxValidationState state;
+        PrecomputedTransactionData bad_txdata;
+        ValidationCache unbatched_cache{1 << 20, 1 << 20};
+        BOOST_CHECK(!CheckInputScripts(bad, state, chainstate.CoinsTip(), flags, true, false, bad_txdata, unbatched_cache, nullptr));
+        BOOST_CHECK_EQUAL(state.GetRejectReason(), strprintf("mandatory-script-verify-flag-failed (%s)", ScriptErrorString(SCRIPT_ERR_SCHNORR_SIG)));
+
+        // A block with the bad signature is rejected with the same error
+        const CBlock bad_block{CreateBlock({bad_tx}, p2pk_scriptPubKey, chainstate)};
+        const BlockValidationState block_state{TestBlockValidity(chainstate, bad_block, /*check_pow=*/false, /*check_bits=*/false, /*check_merkle_root=*/true)};
+        BOOST_CHECK_EQUAL(block_state.GetRejectReason(), state.GetRejectReason());
+        BOOST_CHECK_EQUAL(block_state.GetDebugMessage(), state.GetDebugMessage());
+
+        // Without script check workers, the last half of the checks makes up
+        // the first chunk, which fails as a batch and is then checked one by one
+        ValidationCache validation_cache{1 << 20, 1 << 20};
+        CCheckQueue<CScriptCheck> queue{/*batch_size=*/128, /*worker_threads_num=*/0, /*batch_verify=*/true};
+        CCheckQueueControl<CScriptCheck> control{queue};
+        PrecomputedTransactionData queue_txdata;
+        control.Add(make_checks(bad, queue_txdata, validation_cache));
+        const auto result{control.Complete()};
+        BOOST_REQUIRE(result.has_value());
+        BOOST_CHECK_EQUAL(result->first, SCRIPT_ERR_SCHNORR_SIG);
+        BOOST_CHECK_EQUAL(result->second, state.GetDebugMessage());
+
+        // Signatures are only added to the cache once their batch verified
+        for (const CTransaction* tx : {&bad, &spend}) {
+            ValidationCache batch_cache{1 << 20, 1 << 20};
+            const auto cached{[&](size_t i) {
+                uint256 entry;
+                batch_cache.m_signature_cache.ComputeEntrySchnorr(entry, sighashes[i], tx->vin[i].scriptWitness.stack[0], output_key);
+                return batch_cache.m_signature_cache.Get(entry, /*erase=*/false);
+            }};
+            PrecomputedTransactionData batch_txdata;
+            auto checks{make_checks(*tx, batch_txdata, batch_cache)};
+            SchnorrBatch batch;
+            for (auto& check : checks) BOOST_CHECK(!check(batch).has_value());
+            BOOST_CHECK_EQUAL(batch.size(), NUM_INPUTS);
+            BOOST_CHECK(!cached(0));
+            const bool valid{tx == &spend};
+            BOOST_CHECK_EQUAL(batch.Verify(), valid);
+            for (size_t i = 0; i < NUM_INPUTS; ++i) BOOST_CHECK_EQUAL(cached(i), valid);
+        }
+    }
+
+    // The valid spend is accepted in a block
+    const CBlock block{CreateAndProcessBlock({spend_tx}, p2pk_scriptPubKey)};
+    BOOST_CHECK_EQUAL(WITH_LOCK(cs_main, return chainstate.m_chain.Tip()->GetBlockHash()), block.GetHash());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -259,6 +259,7 @@ ChainTestingSetup::ChainTestingSetup(const ChainType chainType, TestOpts opts)
             .signals = m_node.validation_signals.get(),
             // Use no worker threads while fuzzing to avoid non-determinism
             .worker_threads_num = EnableFuzzDeterminism() ? 0 : 2,
+            .batch_schnorr_verification = opts.batch_schnorr_verification,
         };
         if (opts.min_validation_cache) {
             chainman_opts.script_execution_cache_bytes = 0;
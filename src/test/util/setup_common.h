@@ -57,6 +57,7 @@ struct TestOpts {
     bool setup_net{true};
     bool setup_validation_interface{true};
     bool min_validation_cache{false}; // Equivalent of -maxsigcachebytes=0
+    bool batch_schnorr_verification{true}; // Equivalent of -batchschnorrverify, which is off by default outside of tests
 };
 
 /** Basic testing setup.
@@ -4,6 +4,7 @@
 
 #include <clientversion.h>
 #include <common/signmessage.h>
+#include <crypto/hex_base.h>
 #include <hash.h>
 #include <key.h>
 #include <script/parsing.h>
@@ -269,6 +270,42 @@ BOOST_AUTO_TEST_CASE(util_HexStr)
     }
 }
 
+BOOST_AUTO_TEST_CASE(util_hex_implementations)
+{
+    // Encode and decode data of lengths around the vector block sizes with
+    // each implementation, and compare to the standard implementation.
+    std::vector<std::vector<uint8_t>> inputs;
+    std::vector<std::string> expected;
+    HexAutoDetect(hex_implementation::STANDARD);
+    for (size_t len = 0; len < 100; ++len) {
+        inputs.push_back(m_rng.randbytes(len));
+        expected.push_back(HexStr(inputs.back()));
+    }
+
+    for (const auto impl : {hex_implementation::STANDARD, hex_implementation::USE_SSE41, hex_implementation::USE_ALL}) {
+        BOOST_TEST_MESSAGE("Testing the '" << HexAutoDetect(impl) << "' hex implementation");
+        for (size_t i = 0; i < inputs.size(); ++i) {
+            BOOST_CHECK_EQUAL(HexStr(inputs[i]), expected[i]);
+
+            std::string upper{expected[i]};
+            for (char& c : upper) c = ToUpper(c);
+            BOOST_CHECK(TryParseHex<uint8_t>(expected[i]) == inputs[i]);
+            BOOST_CHECK(TryParseHex<uint8_t>(upper) == inputs[i]);
+
+            // An invalid digit anywhere stops the decoding at its byte.
+            if (inputs[i].empty()) continue;
+            std::string invalid{expected[i]};
+            const size_t pos{m_rng.randrange(invalid.size())};
+            invalid[pos] = "g /\x80"[m_rng.randrange(4)];
+            std::vector<uint8_t> out(inputs[i].size());
+            BOOST_CHECK_EQUAL(DecodeHexPairs(invalid.data(), out.size(), out.data()), pos / 2);
+            BOOST_CHECK(std::equal(out.begin(), out.begin() + pos / 2, inputs[i].begin()));
+            BOOST_CHECK(!TryParseHex(invalid).has_value());
+        }
+    }
+    HexAutoDetect();
+}
+
 BOOST_AUTO_TEST_CASE(span_write_bytes)
 {
     std::array mut_arr{uint8_t{0xaa}, uint8_t{0xbb}};
@@ -2,14 +2,20 @@
 // Distributed under the MIT software license, see the accompanying
 // file COPYING or http://www.opensource.org/licenses/mit-license.php.
 //
+#include <addresstype.h>
 #include <chainparams.h>
 #include <consensus/validation.h>
 #include <kernel/disconnected_transactions.h>
+#include <names/common.h>
+#include <names/encoding.h>
+#include <names/main.h>
 #include <node/chainstatemanager_args.h>
 #include <node/kernel_notifications.h>
 #include <node/utxo_snapshot.h>
 #include <random.h>
 #include <rpc/blockchain.h>
+#include <script/names.h>
+#include <streams.h>
 #include <sync.h>
 #include <test/util/chainstate.h>
 #include <test/util/logging.h>
@@ -24,6 +30,7 @@
 
 #include <tinyformat.h>
 
+#include <algorithm>
 #include <vector>
 
 #include <boost/test/unit_test.hpp>
@@ -161,6 +168,81 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_rebalance_caches, TestChain100Setup)
     BOOST_CHECK_CLOSE(double(c2.m_coinsdb_cache_size_bytes), max_cache * 0.95, 1);
 }
 
+//! Test that LoadExternalBlockFile() finds all blocks in a file with extra
+//! data in it, and processes them in file order.
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_load_external_block_file, TestChain100Setup)
+{
+    ChainstateManager& chainman{*m_node.chainman};
+    const CChainParams& params{chainman.GetParams()};
+    Chainstate& chainstate{chainman.ActiveChainstate()};
+
+    DataStream file_data{};
+    const auto append_block{[&](const CBlock& block) {
+        file_data << params.MessageStart() << static_cast<uint32_t>(GetSerializeSize(TX_WITH_WITNESS(block)));
+        const uint64_t pos{file_data.size()};
+        file_data << TX_WITH_WITNESS(block);
+        return pos;
+    }};
+    const auto append_garbage{[&] {
+        file_data.write(m_rng.randbytes<std::byte>(m_rng.randrange(100)));
+    }};
+
+    // Blocks on top of the tip which the node does not know yet, blocks with
+    // unknown parents (which are only tracked for -reindex), and extra data.
+    std::vector<uint256> new_blocks;
+    std::map<uint256, uint64_t> orphans;
+    append_garbage();
+    for (int i = 0; i < 20; ++i) {
+        CBlock block{CreateBlock({}, CScript() << i << OP_TRUE, chainstate)};
+        new_blocks.push_back(block.GetHash());
+        append_block(block);
+        append_garbage();
+
+        block.hashPrevBlock = m_rng.rand256();
+        orphans.emplace(block.hashPrevBlock, append_block(block));
+        append_garbage();
+    }
+    // A block with a valid header whose transactions are cut off, and a
+    // truncated block at the end of the file.
+    const CBlock& tip_block{CreateBlock({}, CScript() << OP_TRUE, chainstate)};
+    file_data << params.MessageStart() << static_cast<uint32_t>(GetSerializeSize(TX_WITH_WITNESS(tip_block)));
+    file_data << static_cast<const CBlockHeader&>(tip_block);
+    file_data.write(m_rng.randbytes<std::byte>(GetSerializeSize(TX_WITH_WITNESS(tip_block)) - GetSerializeSize(static_cast<const CBlockHeader&>(tip_block))));
+    append_block(tip_block);
+    file_data.resize(file_data.size() - 10);
+
+    const fs::path path{m_path_root / "blk.dat"};
+    {
+        AutoFile file{fsbridge::fopen(path, "wb")};
+        file.write(file_data);
+        BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+    }
+
+    // -loadblock adds the new blocks.
+    {
+        AutoFile file{fsbridge::fopen(path, "rb")};
+        chainman.LoadExternalBlockFile(file);
+    }
+    for (const uint256& hash : new_blocks) {
+        const CBlockIndex* pindex{WITH_LOCK(::cs_main, return chainman.m_blockman.LookupBlockIndex(hash))};
+        BOOST_REQUIRE(pindex);
+        BOOST_CHECK(WITH_LOCK(::cs_main, return pindex->nStatus & BLOCK_HAVE_DATA));
+    }
+
+    // -reindex tracks the positions of the blocks with unknown parents.
+    std::multimap<uint256, FlatFilePos> blocks_with_unknown_parent;
+    {
+        AutoFile file{fsbridge::fopen(path, "rb")};
+        FlatFilePos pos{0, 0};
+        chainman.LoadExternalBlockFile(file, &pos, &blocks_with_unknown_parent);
+    }
+    BOOST_CHECK_EQUAL(blocks_with_unknown_parent.size(), orphans.size());
+    for (const auto& [parent, pos] : blocks_with_unknown_parent) {
+        BOOST_REQUIRE(orphans.contains(parent));
+        BOOST_CHECK_EQUAL(pos.nPos, orphans.at(parent));
+    }
+}
+
 struct SnapshotTestSetup : TestChain100Setup {
     // Run with coinsdb on the filesystem to support, e.g., moving invalidated
     // chainstate dirs to "*_invalid".
@@ -272,6 +354,11 @@ struct SnapshotTestSetup : TestChain100Setup {
                 // Coins count is smaller than coins in file
                 metadata.m_coins_count -= 1;
         }));
+        BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
+            this, [](AutoFile& auto_infile, SnapshotMetadata& metadata) {
+                // Name entries count does not match the name outputs
+                metadata.m_names_count += 1;
+        }));
         BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
             this, [](AutoFile& auto_infile, SnapshotMetadata& metadata) {
                 // Wrong hash
@@ -434,6 +521,91 @@ BOOST_FIXTURE_TEST_CASE(chainstatemanager_activate_snapshot, SnapshotTestSetup)
     this->SetupSnapshot();
 }
 
+//! Test that the name database is carried over by a snapshot, and that a
+//! snapshot whose name entries do not match its UTXO set is refused.
+BOOST_FIXTURE_TEST_CASE(chainstatemanager_snapshot_names, SnapshotTestSetup)
+{
+    ChainstateManager& chainman = *Assert(m_node.chainman);
+    const CScript addr{GetScriptForDestination(PKHash(coinbaseKey.GetPubKey()))};
+    const valtype name_a{DecodeName("p/alice", NameEncoding::ASCII)};
+    const valtype name_b{DecodeName("p/bob", NameEncoding::ASCII)};
+    const valtype value_registered{DecodeName(R"({"snapshot":"registered"})", NameEncoding::ASCII)};
+    const valtype value_updated{DecodeName(R"({"snapshot":"updated"})", NameEncoding::ASCII)};
+
+    // Register two names at height 102, once the second coinbase has matured,
+    // and update one of them at height 103.
+    mineBlocks(1);
+    const auto register_a{CreateValidMempoolTransaction(
+        m_coinbase_txns[0], 0, 1, coinbaseKey,
+        CNameScript::buildNameRegister(addr, name_a, value_registered), NAME_LOCKED_AMOUNT, /*submit=*/false)};
+    const auto register_b{CreateValidMempoolTransaction(
+        m_coinbase_txns[1], 0, 2, coinbaseKey,
+        CNameScript::buildNameRegister(addr, name_b, value_registered), NAME_LOCKED_AMOUNT, /*submit=*/false)};
+    CreateAndProcessBlock({register_a, register_b}, addr);
+    const auto update_a{CreateValidMempoolTransaction(
+        MakeTransactionRef(register_a), 0, 102, coinbaseKey,
+        CNameScript::buildNameUpdate(addr, name_a, value_updated), NAME_LOCKED_AMOUNT, /*submit=*/false)};
+    CreateAndProcessBlock({update_a}, addr);
+
+    // Mine up to height 120, where the assumeutxo value for this chain is.
+    mineBlocks(17);
+    BOOST_REQUIRE_EQUAL(WITH_LOCK(::cs_main, return chainman.ActiveHeight()), 120);
+
+    {
+        ASSERT_DEBUG_LOG("does not match its update outpoint");
+        BOOST_REQUIRE(!CreateAndActivateUTXOSnapshot(
+            this, [&](AutoFile& auto_infile, SnapshotMetadata& metadata) {
+                BOOST_CHECK_EQUAL(metadata.m_names_count, 2U);
+
+                // Change the value of the name entry for name_a. The name
+                // section follows the coins, so the last occurrence of the
+                // value is in that entry rather than in the name output.
+                const fs::path snapshot_path{m_path_root / "test_snapshot.120.dat"};
+                std::vector<unsigned char> contents(fs::file_size(snapshot_path));
+                AutoFile file{fsbridge::fopen(snapshot_path, "r+b")};
+                file.read(MakeWritableByteSpan(contents));
+                const auto it{std::find_end(contents.begin(), contents.end(), value_updated.begin(), value_updated.end())};
+                BOOST_REQUIRE(it != contents.end());
+                it[2] = 'S';
+                file.seek(0, SEEK_SET);
+                file.write(MakeByteSpan(contents));
+                BOOST_REQUIRE_EQUAL(file.fclose(), 0);
+
+                // Drop anything read ahead before the change
+                auto_infile.seek(auto_infile.tell(), SEEK_SET);
+        }));
+    }
+    BOOST_CHECK(!chainman.IsSnapshotActive());
+
+    BOOST_REQUIRE(CreateAndActivateUTXOSnapshot(this));
+    BOOST_CHECK(chainman.IsSnapshotActive());
+
+    LOCK(::cs_main);
+    const CCoinsViewCache& snapshot_coins{chainman.ActiveChainstate().CoinsTip()};
+    const CCoinsViewCache& ibd_coins{chainman.GetAll()[0]->CoinsTip()};
+    BOOST_REQUIRE(&snapshot_coins != &ibd_coins);
+
+    CNameData data;
+    BOOST_REQUIRE(snapshot_coins.GetName(name_a, data));
+    BOOST_CHECK(data.getValue() == value_updated);
+    BOOST_CHECK_EQUAL(data.getHeight(), 103U);
+    BOOST_CHECK(data.getUpdateOutpoint() == COutPoint(update_a.GetHash(), 0));
+
+    BOOST_REQUIRE(snapshot_coins.GetName(name_b, data));
+    BOOST_CHECK(data.getValue() == value_registered);
+    BOOST_CHECK_EQUAL(data.getHeight(), 102U);
+    BOOST_CHECK(data.getUpdateOutpoint() == COutPoint(register_b.GetHash(), 0));
+
+    // The entries match those of the fully validated chainstate.
+    for (const auto& name : {name_a, name_b}) {
+        CNameData snapshot_data, ibd_data;
+        BOOST_REQUIRE(snapshot_coins.GetName(name, snapshot_data));
+        BOOST_REQUIRE(ibd_coins.GetName(name, ibd_data));
+        BOOST_CHECK(snapshot_data == ibd_data);
+    }
+    BOOST_CHECK(!snapshot_coins.GetName(DecodeName("p/carol", NameEncoding::ASCII), data));
+}
+
 //! Test LoadBlockIndex behavior when multiple chainstates are in use.
 //!
 //! - First, verify that setBlockIndexCandidates is as expected when using a single,
@@ -6,12 +6,15 @@
 #include <consensus/validation.h>
 #include <primitives/block.h>
 #include <scheduler.h>
+#include <sync.h>
 #include <test/util/setup_common.h>
 #include <util/check.h>
 #include <kernel/chain.h>
 #include <validationinterface.h>
 
 #include <atomic>
+#include <condition_variable>
+#include <vector>
 
 BOOST_FIXTURE_TEST_SUITE(validationinterface_tests, ChainTestingSetup)
 
@@ -101,4 +104,83 @@ BOOST_AUTO_TEST_CASE(unregister_all_during_call)
     BOOST_CHECK(destroyed);
 }
 
+/** Records the heights of flushed locators, optionally waiting to be released for each of them */
+class FlushRecorder final : public CValidationInterface
+{
+public:
+    explicit FlushRecorder(bool wait_for_release) : m_wait_for_release{wait_for_release} {}
+
+    void ChainStateFlushed(ChainstateRole, const CBlockLocator& locator) override
+    {
+        WAIT_LOCK(m_mutex, lock);
+        if (m_wait_for_release) m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_released; });
+        m_heights.push_back(locator.vHave.size());
+        m_cv.notify_all();
+    }
+
+    void Release()
+    {
+        WITH_LOCK(m_mutex, m_released = true);
+        m_cv.notify_all();
+    }
+
+    void WaitForCount(size_t count)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_heights.size() >= count; });
+    }
+
+    std::vector<size_t> Heights()
+    {
+        LOCK(m_mutex);
+        return m_heights;
+    }
+
+private:
+    const bool m_wait_for_release;
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    bool m_released GUARDED_BY(m_mutex){false};
+    std::vector<size_t> m_heights GUARDED_BY(m_mutex);
+};
+
+BOOST_AUTO_TEST_CASE(subscriber_queues)
+{
+    ValidationSignals& signals{*m_node.validation_signals};
+    FlushRecorder main_subscriber{/*wait_for_release=*/false};
+    FlushRecorder slow_subscriber{/*wait_for_release=*/true};
+    signals.RegisterValidationInterface(&main_subscriber);
+    signals.RegisterValidationInterface(&slow_subscriber, "slow");
+
+    // The subscriber on the main queue is notified while the slow one is still
+    // blocked in its first callback.
+    constexpr size_t NUM_EVENTS{5};
+    for (size_t i = 1; i <= NUM_EVENTS; ++i) {
+        signals.ChainStateFlushed(ChainstateRole::NORMAL, CBlockLocator{std::vector<uint256>(i)});
+    }
+    main_subscriber.WaitForCount(NUM_EVENTS);
+    BOOST_CHECK(slow_subscriber.Heights().empty());
+
+    const auto stats{signals.GetQueueStats()};
+    BOOST_REQUIRE_EQUAL(stats.size(), 2U);
+    BOOST_CHECK_EQUAL(stats[0].name, "main");
+    BOOST_CHECK_EQUAL(stats[1].name, "slow");
+    BOOST_CHECK_EQUAL(stats[1].subscribers, 1U);
+    // The first event may or may not have been taken off the queue yet
+    BOOST_CHECK(stats[1].pending >= NUM_EVENTS - 1);
+    BOOST_CHECK(signals.CallbacksPending() >= NUM_EVENTS - 1);
+
+    // Syncing with the queue waits for all subscribers, which are notified in
+    // order.
+    slow_subscriber.Release();
+    signals.SyncWithValidationInterfaceQueue();
+    const std::vector<size_t> expected{1, 2, 3, 4, 5};
+    BOOST_CHECK(main_subscriber.Heights() == expected);
+    BOOST_CHECK(slow_subscriber.Heights() == expected);
+    BOOST_CHECK_EQUAL(signals.GetQueueStats()[1].processed, NUM_EVENTS + 1);
+
+    signals.UnregisterValidationInterface(&slow_subscriber);
+    signals.UnregisterValidationInterface(&main_subscriber);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
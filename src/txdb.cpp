@@ -238,8 +238,8 @@ class CCoinsViewDBCursor: public CCoinsViewCursor
 public:
     // Prefer using CCoinsViewDB::Cursor() since we want to perform some
     // cache warmup on instantiation.
-    CCoinsViewDBCursor(CDBIterator* pcursorIn, const uint256&hashBlockIn):
-        CCoinsViewCursor(hashBlockIn), pcursor(pcursorIn) {}
+    CCoinsViewDBCursor(CDBIterator* pcursorIn, const uint256&hashBlockIn, unsigned int end_prefix = 256):
+        CCoinsViewCursor(hashBlockIn), pcursor(pcursorIn), m_end_prefix(end_prefix) {}
     ~CCoinsViewDBCursor() = default;
 
     bool GetKey(COutPoint &key) const override;
@@ -251,6 +251,11 @@ public:
 private:
     std::unique_ptr<CDBIterator> pcursor;
     std::pair<char, COutPoint> keyTmp;
+    //! The cursor ends before the first txid starting with this byte
+    const unsigned int m_end_prefix;
+
+    /** Cache the key at the current position, if it is a coin in the range. */
+    void CacheKey();
 
     friend class CCoinsViewDB;
 };
@@ -264,14 +269,39 @@ std::unique_ptr<CCoinsViewCursor> CCoinsViewDB::Cursor() const
        that restriction.  */
     i->pcursor->Seek(DB_COIN);
     // Cache key of first record
-    if (i->pcursor->Valid()) {
-        CoinEntry entry(&i->keyTmp.second);
-        i->pcursor->GetKey(entry);
-        i->keyTmp.first = entry.key;
+    i->CacheKey();
+    return i;
+}
+
+std::vector<std::unique_ptr<CCoinsViewCursor>> CCoinsViewDB::RangeCursors(size_t max_ranges) const
+{
+    // Split the coins by the first byte of their txid
+    const size_t num_ranges{std::clamp<size_t>(max_ranges, 1, 256)};
+    const uint256 best_block{GetBestBlock()};
+    std::vector<std::unique_ptr<CDBIterator>> iterators{const_cast<CDBWrapper&>(*m_db).NewIterators(num_ranges)};
+    std::vector<std::unique_ptr<CCoinsViewCursor>> cursors;
+    for (size_t r = 0; r < num_ranges; ++r) {
+        const unsigned int start_prefix(r * 256 / num_ranges);
+        auto cursor{std::make_unique<CCoinsViewDBCursor>(iterators[r].release(), best_block, (r + 1) * 256 / num_ranges)};
+        uint256 start_hash;
+        *start_hash.begin() = start_prefix;
+        const COutPoint start{Txid::FromUint256(start_hash), 0};
+        cursor->pcursor->Seek(CoinEntry(&start));
+        cursor->CacheKey();
+        cursors.push_back(std::move(cursor));
+    }
+    return cursors;
+}
+
+void CCoinsViewDBCursor::CacheKey()
+{
+    CoinEntry entry(&keyTmp.second);
+    if (!pcursor->Valid() || !pcursor->GetKey(entry) ||
+        (entry.key == DB_COIN && std::to_integer<unsigned int>(*keyTmp.second.hash.begin()) >= m_end_prefix)) {
+        keyTmp.first = 0; // Invalidate cached key after last record so that Valid() and GetKey() return false
     } else {
-        i->keyTmp.first = 0; // Make sure Valid() and GetKey() return false
+        keyTmp.first = entry.key;
     }
-    return i;
 }
 
 bool CCoinsViewDBCursor::GetKey(COutPoint &key) const
@@ -297,12 +327,7 @@ bool CCoinsViewDBCursor::Valid() const
 void CCoinsViewDBCursor::Next()
 {
     pcursor->Next();
-    CoinEntry entry(&keyTmp.second);
-    if (!pcursor->Valid() || !pcursor->GetKey(entry)) {
-        keyTmp.first = 0; // Invalidate cached key after last record so that Valid() and GetKey() return false
-    } else {
-        keyTmp.first = entry.key;
-    }
+    CacheKey();
 }
 
 bool CCoinsViewDB::ValidateNameDB(const Chainstate& chainState, const std::function<void()>& interruption_point) const
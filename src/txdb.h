@@ -52,6 +52,7 @@ public:
     CNameIterator* IterateNames() const override;
     bool BatchWrite(CoinsViewCacheCursor& cursor, const uint256 &hashBlock, const CNameCache& names) override;
     std::unique_ptr<CCoinsViewCursor> Cursor() const override;
+    std::vector<std::unique_ptr<CCoinsViewCursor>> RangeCursors(size_t max_ranges) const override;
     bool ValidateNameDB(const Chainstate& chainState, const std::function<void()>& interruption_point) const override;
 
     //! Whether an unsupported database format is used.
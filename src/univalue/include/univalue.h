@@ -28,6 +28,56 @@ public:
         using std::runtime_error::runtime_error;
     };
 
+    /**
+     * While an Arena exists, the member arrays of objects and arrays built
+     * on its thread are allocated from larger blocks owned by the arena,
+     * instead of each with its own heap allocation.  The blocks are freed
+     * together once the arena is destroyed and no value using them is left.
+     * Values may thus safely outlive the arena (and move to other threads),
+     * but then keep all of its memory alive.
+     *
+     * Arenas are meant to be scoped to building and writing one response,
+     * e.g. of an RPC call.  They may be nested, and must be destroyed on
+     * their thread in reverse order of construction.
+     */
+    class Arena
+    {
+    public:
+        struct Pool;
+
+        Arena();
+        ~Arena();
+
+        Arena(const Arena&) = delete;
+        Arena& operator=(const Arena&) = delete;
+
+    private:
+        Pool* const m_pool;
+        Pool* const m_prev;
+    };
+
+    /** Allocator for the member arrays, which uses the active Arena. */
+    template <typename T>
+    class Allocator
+    {
+    public:
+        using value_type = T;
+        using is_always_equal = std::true_type;
+
+        Allocator() = default;
+        template <typename U>
+        Allocator(const Allocator<U>&) noexcept {}
+
+        T* allocate(size_t n) { return static_cast<T*>(AllocateMembers(n * sizeof(T))); }
+        void deallocate(T* p, size_t) noexcept { DeallocateMembers(p); }
+
+        template <typename U>
+        bool operator==(const Allocator<U>&) const noexcept { return true; }
+    };
+
+    using Keys = std::vector<std::string, Allocator<std::string>>;
+    using Values = std::vector<UniValue, Allocator<UniValue>>;
+
     UniValue() { typ = VNULL; }
     UniValue(UniValue::VType type, std::string str = {}) : typ{type}, val{std::move(str)} {}
     template <typename Ref, typename T = std::remove_cv_t<std::remove_reference_t<Ref>>,
@@ -99,11 +149,24 @@ public:
 
     bool read(std::string_view raw);
 
+    /**
+     * Check whether read() accepts raw, without building the value or
+     * allocating memory.  The result is the same as for read() on a
+     * NUL-terminated copy of raw.  On success, the type of the top-level
+     * value is returned in type and whether raw is exactly what write()
+     * produces for the parsed value in minimal.
+     */
+    static bool validate(std::string_view raw, VType* type = nullptr,
+                         bool* minimal = nullptr);
+
 private:
     UniValue::VType typ;
     std::string val;                       // numbers are stored as C++ strings
-    std::vector<std::string> keys;
-    std::vector<UniValue> values;
+    Keys keys;
+    Values values;
+
+    static void* AllocateMembers(size_t size);
+    static void DeallocateMembers(void* p) noexcept;
 
     void checkType(const VType& expected) const;
     bool findKey(const std::string& key, size_t& retIdx) const;
@@ -113,8 +176,8 @@ private:
 public:
     // Strict type-specific getters, these throw std::runtime_error if the
     // value is of unexpected type
-    const std::vector<std::string>& getKeys() const;
-    const std::vector<UniValue>& getValues() const;
+    const Keys& getKeys() const;
+    const Values& getValues() const;
     template <typename Int>
     Int getInt() const;
     bool get_bool() const;
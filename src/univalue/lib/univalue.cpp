@@ -7,9 +7,12 @@
 
 #include "univalue_utffilter.h"
 
+#include <atomic>
+#include <cstring>
 #include <iomanip>
 #include <map>
 #include <memory>
+#include <new>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -17,6 +20,95 @@
 
 const UniValue NullUniValue;
 
+struct UniValue::Arena::Pool
+{
+    static constexpr size_t BLOCK_SIZE{64 << 10};
+    static constexpr size_t ALIGN{alignof(std::max_align_t)};
+
+    std::vector<std::unique_ptr<std::byte[]>> blocks;
+    std::byte* next{nullptr};
+    size_t left{0};
+
+    /** Allocations still alive, plus one while the Arena exists. */
+    std::atomic<size_t> refs{1};
+
+    void* Allocate(size_t size)
+    {
+        size = (size + ALIGN - 1) & ~(ALIGN - 1);
+        if (size > left) {
+            // Large arrays get their own block, so that the current
+            // one can still be used for small ones.
+            if (size > BLOCK_SIZE / 4) {
+                blocks.emplace_back(new std::byte[size]);
+                return blocks.back().get();
+            }
+            blocks.emplace_back(new std::byte[BLOCK_SIZE]);
+            next = blocks.back().get();
+            left = BLOCK_SIZE;
+        }
+        void* res = next;
+        next += size;
+        left -= size;
+        return res;
+    }
+
+    void Release() noexcept
+    {
+        if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) delete this;
+    }
+};
+
+namespace {
+
+thread_local UniValue::Arena::Pool* g_arena_pool{nullptr};
+
+/**
+ * Each allocation is preceded by a header with the pool it is from, or
+ * nullptr if it is from the heap, so that it can be freed on any thread.
+ */
+constexpr size_t ALLOC_HEADER{UniValue::Arena::Pool::ALIGN};
+static_assert(sizeof(UniValue::Arena::Pool*) <= ALLOC_HEADER);
+
+} // namespace
+
+UniValue::Arena::Arena()
+    : m_pool{new Pool}, m_prev{g_arena_pool}
+{
+    g_arena_pool = m_pool;
+}
+
+UniValue::Arena::~Arena()
+{
+    g_arena_pool = m_prev;
+    m_pool->Release();
+}
+
+void* UniValue::AllocateMembers(size_t size)
+{
+    Arena::Pool* pool{g_arena_pool};
+    std::byte* res;
+    if (pool) {
+        res = static_cast<std::byte*>(pool->Allocate(ALLOC_HEADER + size));
+        pool->refs.fetch_add(1, std::memory_order_relaxed);
+    } else {
+        res = static_cast<std::byte*>(::operator new(ALLOC_HEADER + size));
+    }
+    std::memcpy(res, &pool, sizeof(pool));
+    return res + ALLOC_HEADER;
+}
+
+void UniValue::DeallocateMembers(void* p) noexcept
+{
+    std::byte* const base{static_cast<std::byte*>(p) - ALLOC_HEADER};
+    Arena::Pool* pool;
+    std::memcpy(&pool, base, sizeof(pool));
+    if (pool) {
+        pool->Release();
+    } else {
+        ::operator delete(base);
+    }
+}
+
 void UniValue::clear()
 {
     typ = VNULL;
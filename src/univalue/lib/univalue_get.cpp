@@ -44,13 +44,13 @@ bool ParseDouble(const std::string& str, double *out)
 }
 }
 
-const std::vector<std::string>& UniValue::getKeys() const
+const UniValue::Keys& UniValue::getKeys() const
 {
     checkType(VOBJ);
     return keys;
 }
 
-const std::vector<UniValue>& UniValue::getValues() const
+const UniValue::Values& UniValue::getValues() const
 {
     if (typ != VOBJ && typ != VARR)
         throw std::runtime_error("JSON value is not an object or array as expected");
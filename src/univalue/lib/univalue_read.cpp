@@ -3,8 +3,10 @@
 // file COPYING or https://opensource.org/licenses/mit-license.php.
 
 #include <univalue.h>
+#include <univalue_escapes.h>
 #include <univalue_utffilter.h>
 
+#include <bitset>
 #include <cstdint>
 #include <cstdio>
 #include <cstring>
@@ -248,6 +250,278 @@ enum jtokentype getJsonToken(std::string& tokenVal, unsigned int& consumed,
     }
 }
 
+namespace {
+
+/** Length of the UTF-8 encoding that JSONUTF8StringFilter produces */
+int utf8_length(unsigned int codepoint)
+{
+    if (codepoint <= 0x7f) return 1;
+    if (codepoint <= 0x7FF) return 2;
+    if (codepoint <= 0xFFFF) return 3;
+    return 4;
+}
+
+/** Whether escStr is what write() produces for the character ch */
+bool is_write_escape(unsigned char ch, std::string_view escStr)
+{
+    return escapes[ch] != nullptr && escStr == escapes[ch];
+}
+
+/**
+ * Validate a string token the way getJsonToken and JSONUTF8StringFilter
+ * do, without decoding it.  raw points past the opening quote and is
+ * advanced past the closing quote.  minimal is cleared if write() would
+ * encode the decoded string differently.
+ */
+bool scanJsonString(const char*& raw, const char* end, bool& minimal)
+{
+    // Decoding state, as in JSONUTF8StringFilter
+    unsigned int codepoint = 0;
+    int state = 0;
+    int seqLength = 0;
+    unsigned int surpair = 0;
+
+    // Same as JSONUTF8StringFilter::push_back_u
+    const auto push_back_u = [&](unsigned int codepoint_) {
+        if (state)
+            return false;
+        if (codepoint_ >= 0xD800 && codepoint_ < 0xDC00) {
+            if (surpair)
+                return false;
+            surpair = codepoint_;
+        } else if (codepoint_ >= 0xDC00 && codepoint_ < 0xE000) {
+            if (!surpair)
+                return false;
+            surpair = 0;
+        } else if (surpair) {
+            return false;
+        }
+        return true;
+    };
+
+    // Same as JSONUTF8StringFilter::push_back
+    const auto push_back = [&](unsigned char ch) {
+        if (state == 0) {
+            if (ch < 0x80)
+                return true;
+            else if (ch < 0xc0)
+                return false;
+            else if (ch < 0xe0) {
+                codepoint = (ch & 0x1f) << 6;
+                state = 6;
+                seqLength = 2;
+            } else if (ch < 0xf0) {
+                codepoint = (ch & 0x0f) << 12;
+                state = 12;
+                seqLength = 3;
+            } else if (ch < 0xf8) {
+                codepoint = (ch & 0x07) << 18;
+                state = 18;
+                seqLength = 4;
+            } else
+                return false;
+            return true;
+        }
+
+        if ((ch & 0xc0) != 0x80)
+            return false;
+        state -= 6;
+        codepoint |= (ch & 0x3f) << state;
+        if (state != 0)
+            return true;
+
+        // write() outputs the shortest encoding and combines surrogates
+        if ((codepoint >= 0xD800 && codepoint < 0xE000) ||
+            utf8_length(codepoint) != seqLength)
+            minimal = false;
+        return push_back_u(codepoint);
+    };
+
+    while (true) {
+        if (raw >= end || (unsigned char)*raw < 0x20)
+            return false;
+
+        const char* start = raw;
+        if (*raw == '\\') {
+            raw++;                            // skip backslash
+
+            if (raw >= end)
+                return false;
+
+            unsigned char ch;
+            switch (*raw) {
+            case '"':  ch = '\"'; break;
+            case '\\': ch = '\\'; break;
+            case '/':  ch = '/'; break;
+            case 'b':  ch = '\b'; break;
+            case 'f':  ch = '\f'; break;
+            case 'n':  ch = '\n'; break;
+            case 'r':  ch = '\r'; break;
+            case 't':  ch = '\t'; break;
+
+            case 'u': {
+                unsigned int codepoint_;
+                if (raw + 1 + 4 >= end ||
+                    hatoui(raw + 1, raw + 1 + 4, codepoint_) !=
+                           raw + 1 + 4)
+                    return false;
+                raw += 1 + 4;
+                if (!push_back_u(codepoint_))
+                    return false;
+                if (codepoint_ > 0x7f ||
+                    !is_write_escape(codepoint_, std::string_view(start, raw - start)))
+                    minimal = false;
+                continue;
+                }
+            default:
+                return false;
+            }
+
+            raw++;                            // skip esc'd char
+            if (!push_back(ch))
+                return false;
+            if (!is_write_escape(ch, std::string_view(start, raw - start)))
+                minimal = false;
+        }
+
+        else if (*raw == '"') {
+            raw++;                            // skip "
+            return state == 0 && surpair == 0;
+        }
+
+        else {
+            const unsigned char ch = *raw;
+            raw++;
+            if (!push_back(ch))
+                return false;
+            if (ch < 0x80 && escapes[ch] != nullptr)
+                minimal = false;
+        }
+    }
+}
+
+/**
+ * Scan the next token like getJsonToken, but without extracting its
+ * value.  raw is advanced past the token.  minimal is cleared if the
+ * token is preceded by whitespace or is a string that write() would
+ * encode differently.
+ */
+jtokentype scanJsonToken(const char*& raw, const char* end, bool& minimal)
+{
+    const char* rawStart = raw;
+    while (raw < end && (json_isspace(*raw)))          // skip whitespace
+        raw++;
+    if (raw != rawStart)
+        minimal = false;
+
+    if (raw >= end)
+        return JTOK_NONE;
+
+    const std::string_view rest(raw, end - raw);
+    switch (*raw) {
+
+    case '{':
+        raw++;
+        return JTOK_OBJ_OPEN;
+    case '}':
+        raw++;
+        return JTOK_OBJ_CLOSE;
+    case '[':
+        raw++;
+        return JTOK_ARR_OPEN;
+    case ']':
+        raw++;
+        return JTOK_ARR_CLOSE;
+
+    case ':':
+        raw++;
+        return JTOK_COLON;
+    case ',':
+        raw++;
+        return JTOK_COMMA;
+
+    case 'n':
+    case 't':
+    case 'f':
+        if (rest.starts_with("null")) {
+            raw += 4;
+            return JTOK_KW_NULL;
+        } else if (rest.starts_with("true")) {
+            raw += 4;
+            return JTOK_KW_TRUE;
+        } else if (rest.starts_with("false")) {
+            raw += 5;
+            return JTOK_KW_FALSE;
+        } else
+            return JTOK_ERR;
+
+    case '-':
+    case '0':
+    case '1':
+    case '2':
+    case '3':
+    case '4':
+    case '5':
+    case '6':
+    case '7':
+    case '8':
+    case '9': {
+        // part 1: int
+        const char *first = raw;
+
+        const char *firstDigit = first;
+        if (!json_isdigit(*firstDigit))
+            firstDigit++;
+        if (firstDigit + 1 < end && (*firstDigit == '0') &&
+            json_isdigit(firstDigit[1]))
+            return JTOK_ERR;
+
+        raw++;
+
+        if ((*first == '-') && (raw < end) && (!json_isdigit(*raw)))
+            return JTOK_ERR;
+
+        while (raw < end && json_isdigit(*raw))
+            raw++;
+
+        // part 2: frac
+        if (raw < end && *raw == '.') {
+            raw++;
+
+            if (raw >= end || !json_isdigit(*raw))
+                return JTOK_ERR;
+            while (raw < end && json_isdigit(*raw))
+                raw++;
+        }
+
+        // part 3: exp
+        if (raw < end && (*raw == 'e' || *raw == 'E')) {
+            raw++;
+
+            if (raw < end && (*raw == '-' || *raw == '+'))
+                raw++;
+
+            if (raw >= end || !json_isdigit(*raw))
+                return JTOK_ERR;
+            while (raw < end && json_isdigit(*raw))
+                raw++;
+        }
+
+        // write() outputs numbers as they were read
+        return JTOK_NUMBER;
+        }
+
+    case '"':
+        raw++;                                // skip "
+        return scanJsonString(raw, end, minimal) ? JTOK_STRING : JTOK_ERR;
+
+    default:
+        return JTOK_ERR;
+    }
+}
+
+} // namespace
+
 enum expect_bits : unsigned {
     EXP_OBJ_NAME = (1U << 0),
     EXP_COLON = (1U << 1),
@@ -463,3 +737,154 @@ bool UniValue::read(std::string_view str_in)
     return true;
 }
 
+bool UniValue::validate(std::string_view str_in, VType* type, bool* minimal)
+{
+    uint32_t expectMask = 0;
+    // Open objects and arrays, instead of the stack of values in read()
+    size_t depth = 0;
+    std::bitset<MAX_JSON_DEPTH> isObject;
+
+    VType topType = VNULL;
+    bool isMinimal = true;
+    enum jtokentype tok = JTOK_NONE;
+    enum jtokentype last_tok = JTOK_NONE;
+    const char* raw{str_in.data()};
+    const char* end{raw + str_in.size()};
+    do {
+        last_tok = tok;
+
+        tok = scanJsonToken(raw, end, isMinimal);
+        if (tok == JTOK_NONE || tok == JTOK_ERR)
+            return false;
+
+        bool isValueOpen = jsonTokenIsValue(tok) ||
+            tok == JTOK_OBJ_OPEN || tok == JTOK_ARR_OPEN;
+
+        if (expect(VALUE)) {
+            if (!isValueOpen)
+                return false;
+            clearExpect(VALUE);
+
+        } else if (expect(ARR_VALUE)) {
+            bool isArrValue = isValueOpen || (tok == JTOK_ARR_CLOSE);
+            if (!isArrValue)
+                return false;
+
+            clearExpect(ARR_VALUE);
+
+        } else if (expect(OBJ_NAME)) {
+            bool isObjName = (tok == JTOK_OBJ_CLOSE || tok == JTOK_STRING);
+            if (!isObjName)
+                return false;
+
+        } else if (expect(COLON)) {
+            if (tok != JTOK_COLON)
+                return false;
+            clearExpect(COLON);
+
+        } else if (!expect(COLON) && (tok == JTOK_COLON)) {
+            return false;
+        }
+
+        if (expect(NOT_VALUE)) {
+            if (isValueOpen)
+                return false;
+            clearExpect(NOT_VALUE);
+        }
+
+        switch (tok) {
+
+        case JTOK_OBJ_OPEN:
+        case JTOK_ARR_OPEN: {
+            VType utyp = (tok == JTOK_OBJ_OPEN ? VOBJ : VARR);
+            if (depth == 0)
+                topType = utyp;
+
+            if (++depth > MAX_JSON_DEPTH)
+                return false;
+            isObject[depth - 1] = (utyp == VOBJ);
+
+            if (utyp == VOBJ)
+                setExpect(OBJ_NAME);
+            else
+                setExpect(ARR_VALUE);
+            break;
+            }
+
+        case JTOK_OBJ_CLOSE:
+        case JTOK_ARR_CLOSE: {
+            if (depth == 0 || (last_tok == JTOK_COMMA))
+                return false;
+
+            if ((tok == JTOK_OBJ_CLOSE) != isObject[depth - 1])
+                return false;
+
+            depth--;
+            clearExpect(OBJ_NAME);
+            setExpect(NOT_VALUE);
+            break;
+            }
+
+        case JTOK_COLON: {
+            if (depth == 0 || !isObject[depth - 1])
+                return false;
+
+            setExpect(VALUE);
+            break;
+            }
+
+        case JTOK_COMMA: {
+            if (depth == 0 ||
+                (last_tok == JTOK_COMMA) || (last_tok == JTOK_ARR_OPEN))
+                return false;
+
+            if (isObject[depth - 1])
+                setExpect(OBJ_NAME);
+            else
+                setExpect(ARR_VALUE);
+            break;
+            }
+
+        case JTOK_KW_NULL:
+        case JTOK_KW_TRUE:
+        case JTOK_KW_FALSE:
+        case JTOK_NUMBER: {
+            if (depth == 0) {
+                topType = (tok == JTOK_NUMBER ? VNUM
+                           : tok == JTOK_KW_NULL ? VNULL : VBOOL);
+                break;
+            }
+
+            setExpect(NOT_VALUE);
+            break;
+            }
+
+        case JTOK_STRING: {
+            if (expect(OBJ_NAME)) {
+                clearExpect(OBJ_NAME);
+                setExpect(COLON);
+            } else if (depth == 0) {
+                topType = VSTR;
+                break;
+            }
+
+            setExpect(NOT_VALUE);
+            break;
+            }
+
+        default:
+            return false;
+        }
+    } while (depth > 0);
+
+    /* Check that nothing follows the initial construct (parsed above).  */
+    tok = scanJsonToken(raw, end, isMinimal);
+    if (tok != JTOK_NONE)
+        return false;
+
+    if (type)
+        *type = topType;
+    if (minimal)
+        *minimal = isMinimal;
+    return true;
+}
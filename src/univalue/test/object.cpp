@@ -132,7 +132,7 @@ void univalue_typecheck()
     UniValue v5;
     BOOST_CHECK(v5.read("[true, 10]"));
     BOOST_CHECK_NO_THROW(v5.get_array());
-    std::vector<UniValue> vals = v5.getValues();
+    UniValue::Values vals = v5.getValues();
     BOOST_CHECK_THROW(vals[0].getInt<int>(), std::runtime_error);
     BOOST_CHECK_EQUAL(vals[0].get_bool(), true);
 
@@ -455,6 +455,36 @@ void univalue_readwrite()
     BOOST_CHECK(!v.read("{} 42"));
 }
 
+void univalue_arena()
+{
+    const std::string json{R"({"a":[1,2,{"b":"c"}],"d":{}})"};
+
+    UniValue escaped;
+    {
+        UniValue::Arena arena;
+        UniValue v;
+        BOOST_CHECK(v.read(json));
+        BOOST_CHECK_EQUAL(v.write(), json);
+
+        {
+            UniValue::Arena nested;
+            UniValue arr(UniValue::VARR);
+            for (int i = 0; i < 1000; ++i) arr.push_back(i);
+            v.pushKV("e", std::move(arr));
+        }
+        BOOST_CHECK_EQUAL(v["e"].size(), 1000);
+
+        escaped = v["a"];
+        v.pushKV("f", escaped);
+    }
+
+    // Values built in an arena remain valid after it is gone.
+    BOOST_CHECK_EQUAL(escaped.write(), R"([1,2,{"b":"c"}])");
+    UniValue copy{escaped};
+    copy.push_back("g");
+    BOOST_CHECK_EQUAL(copy.size(), 4);
+}
+
 int main(int argc, char* argv[])
 {
     univalue_constructor();
@@ -464,5 +494,6 @@ int main(int argc, char* argv[])
     univalue_array();
     univalue_object();
     univalue_readwrite();
+    univalue_arena();
     return 0;
 }
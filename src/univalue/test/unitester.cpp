@@ -90,6 +90,14 @@ static void runtest(std::string filename, const std::string& jdata)
         assert(testResult == false);
     }
 
+    UniValue::VType type;
+    bool minimal;
+    assert(UniValue::validate(jdata, &type, &minimal) == testResult);
+    if (testResult) {
+        assert(type == val.getType());
+        assert(minimal == (val.write(0, 0) == jdata));
+    }
+
     if (wantRoundTrip) {
         std::string odata = val.write(0, 0);
         assert(odata == rtrim(jdata));
@@ -178,11 +186,40 @@ void unescape_unicode_test()
     assert(val[0].get_str() == "\xf0\x9d\x85\xa1");
 }
 
+// Test minimality checks of validate()
+void validate_minimal_test()
+{
+    bool minimal;
+    assert(UniValue::validate("{\"a\":[1,\"\\n\\u001f\\\\\"]}", nullptr, &minimal));
+    assert(minimal);
+    assert(UniValue::validate("{\"a\": 1}", nullptr, &minimal));
+    assert(!minimal);
+    assert(UniValue::validate("{\"a\":1}\n", nullptr, &minimal));
+    assert(!minimal);
+    // Escapes that write() does not use
+    assert(UniValue::validate("[\"\\u0041\"]", nullptr, &minimal));
+    assert(!minimal);
+    assert(UniValue::validate("[\"\\/\"]", nullptr, &minimal));
+    assert(!minimal);
+    assert(UniValue::validate("[\"\\u001F\"]", nullptr, &minimal));
+    assert(!minimal);
+    assert(UniValue::validate("[\"\\ud834\\udd61\"]", nullptr, &minimal));
+    assert(!minimal);
+    // Raw UTF-8 is written as is, unless it is not the shortest encoding
+    assert(UniValue::validate("[\"\xf0\x9d\x85\xa1\"]", nullptr, &minimal));
+    assert(minimal);
+    assert(UniValue::validate("[\"\xc0\x80\"]", nullptr, &minimal));
+    assert(!minimal);
+    assert(UniValue::validate("[\"\x7f\"]", nullptr, &minimal));
+    assert(!minimal);
+}
+
 void no_nul_test()
 {
     char buf[] = "___[1,2,3]___";
     UniValue val;
     assert(val.read({buf + 3, 7}));
+    assert(UniValue::validate({buf + 3, 7}));
 }
 
 int main(int argc, char* argv[])
@@ -192,6 +229,7 @@ int main(int argc, char* argv[])
     }
 
     unescape_unicode_test();
+    validate_minimal_test();
     no_nul_test();
 
     return 0;
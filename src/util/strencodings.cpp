@@ -49,11 +49,17 @@ bool IsHex(std::string_view str)
 template <typename Byte>
 std::optional<std::vector<Byte>> TryParseHex(std::string_view str)
 {
-    std::vector<Byte> vch;
-    vch.reserve(str.size() / 2); // two hex characters form a single byte
+    std::vector<Byte> vch(str.size() / 2); // two hex characters form a single byte
+    size_t len = 0;
 
     auto it = str.begin();
     while (it != str.end()) {
+        // Decode the run of hex digits up to the next space in bulk.
+        const size_t n = DecodeHexPairs(&*it, (str.end() - it) / 2, UCharCast(vch.data() + len));
+        len += n;
+        it += 2 * n;
+        if (it == str.end()) break;
+
         if (IsSpace(*it)) {
             ++it;
             continue;
@@ -62,8 +68,9 @@ std::optional<std::vector<Byte>> TryParseHex(std::string_view str)
         if (it == str.end()) return std::nullopt;
         auto c2 = HexDigit(*(it++));
         if (c1 < 0 || c2 < 0) return std::nullopt;
-        vch.push_back(Byte(c1 << 4) | Byte(c2));
+        vch[len++] = Byte(c1 << 4) | Byte(c2);
     }
+    vch.resize(len);
     return vch;
 }
 template std::optional<std::vector<std::byte>> TryParseHex(std::string_view);
@@ -31,6 +31,7 @@
 #include <kernel/warning.h>
 #include <logging.h>
 #include <logging/timer.h>
+#include <names/encoding.h>
 #include <names/main.h>
 #include <names/mempool.h>
 #include <node/blockstorage.h>
@@ -44,6 +45,7 @@
 #include <primitives/block.h>
 #include <primitives/transaction.h>
 #include <random.h>
+#include <script/names.h>
 #include <script/script.h>
 #include <script/sigcache.h>
 #include <signet.h>
@@ -62,20 +64,27 @@
 #include <util/signalinterrupt.h>
 #include <util/strencodings.h>
 #include <util/string.h>
+#include <util/thread.h>
+#include <util/threadnames.h>
 #include <util/time.h>
 #include <util/trace.h>
 #include <util/translation.h>
 #include <validationinterface.h>
 
 #include <algorithm>
+#include <atomic>
 #include <cassert>
 #include <chrono>
+#include <condition_variable>
 #include <deque>
+#include <exception>
+#include <memory>
 #include <numeric>
 #include <optional>
 #include <ranges>
 #include <span>
 #include <string>
+#include <thread>
 #include <tuple>
 #include <utility>
 
@@ -870,8 +879,11 @@ bool MemPoolAccept::PreChecks(ATMPArgs& args, Workspace& ws)
        tx validation done below (in CheckInputs) will not be correct.  */
     for (const auto& txout : tx.vout)
     {
+        if (!CNameScript::isNameScript(txout.scriptPubKey))
+            continue;
+
         const CNameScript nameOp(txout.scriptPubKey);
-        if (nameOp.isNameOp() && nameOp.isAnyUpdate())
+        if (nameOp.isAnyUpdate())
         {
             const valtype& name = nameOp.getOpName();
             CNameData data;
@@ -2158,11 +2170,12 @@ void UpdateCoins(const CTransaction& tx, CCoinsViewCache& inputs, CTxUndo &txund
     AddCoins(inputs, tx, nHeight);
 }
 
-std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::Verify(const BaseSignatureChecker& checker) const
+{
     const CScript &scriptSig = ptxTo->vin[nIn].scriptSig;
     const CScriptWitness *witness = &ptxTo->vin[nIn].scriptWitness;
     ScriptError error{SCRIPT_ERR_UNKNOWN_ERROR};
-    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, nFlags, CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata), &error)) {
+    if (VerifyScript(scriptSig, m_tx_out.scriptPubKey, witness, nFlags, checker, &error)) {
         return std::nullopt;
     } else {
         auto debug_str = strprintf("input %i of %s (wtxid %s), spending %s:%i", nIn, ptxTo->GetHash().ToString(), ptxTo->GetWitnessHash().ToString(), ptxTo->vin[nIn].prevout.hash.ToString(), ptxTo->vin[nIn].prevout.n);
@@ -2170,6 +2183,14 @@ std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
     }
 }
 
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()() {
+    return Verify(CachingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata));
+}
+
+std::optional<std::pair<ScriptError, std::string>> CScriptCheck::operator()(SchnorrBatch& batch) {
+    return Verify(BatchingTransactionSignatureChecker(ptxTo, nIn, m_tx_out.nValue, cacheStore, *m_signature_cache, *txdata, batch));
+}
+
 ValidationCache::ValidationCache(const size_t script_execution_cache_bytes, const size_t signature_cache_bytes)
     : m_signature_cache{signature_cache_bytes}
 {
@@ -2181,7 +2202,7 @@ ValidationCache::ValidationCache(const size_t script_execution_cache_bytes, cons
     m_script_execution_cache_hasher.Write(nonce.begin(), 32);
     m_script_execution_cache_hasher.Write(nonce.begin(), 32);
 
-    const auto [num_elems, approx_size_bytes] = m_script_execution_cache.setup_bytes(script_execution_cache_bytes);
+    const auto [num_elems, approx_size_bytes] = m_script_execution_cache.Setup(script_execution_cache_bytes);
     LogPrintf("Using %zu MiB out of %zu MiB requested for script execution cache, able to store %zu elements\n",
               approx_size_bytes >> 20, script_execution_cache_bytes >> 20, num_elems);
 }
@@ -2226,7 +2247,7 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
     CSHA256 hasher = validation_cache.ScriptExecutionCacheHasher();
     hasher.Write(UCharCast(tx.GetWitnessHash().begin()), 32).Write((unsigned char*)&flags, sizeof(flags)).Finalize(hashCacheEntry.begin());
     AssertLockHeld(cs_main); //TODO: Remove this requirement by making CuckooCache not require external locks
-    if (validation_cache.m_script_execution_cache.contains(hashCacheEntry, !cacheFullScriptStore)) {
+    if (validation_cache.m_script_execution_cache.Contains(hashCacheEntry, !cacheFullScriptStore)) {
         return true;
     }
 
@@ -2291,7 +2312,7 @@ bool CheckInputScripts(const CTransaction& tx, TxValidationState& state,
     if (cacheFullScriptStore && !pvChecks) {
         // We executed all of the provided scripts, and were told to
         // cache the result. Do so now.
-        validation_cache.m_script_execution_cache.insert(hashCacheEntry);
+        validation_cache.m_script_execution_cache.Insert(hashCacheEntry);
     }
 
     return true;
@@ -4288,7 +4309,7 @@ static bool ContextualCheckBlock(const CBlock& block, BlockValidationState& stat
     return true;
 }
 
-bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValidationState& state, CBlockIndex** ppindex, bool min_pow_checked)
+bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValidationState& state, CBlockIndex** ppindex, bool min_pow_checked, bool pow_checked)
 {
     AssertLockHeld(cs_main);
 
@@ -4308,7 +4329,7 @@ bool ChainstateManager::AcceptBlockHeader(const CBlockHeader& block, BlockValida
             return true;
         }
 
-        if (!CheckBlockHeader(block, state, GetConsensus())) {
+        if (!CheckBlockHeader(block, state, GetConsensus(), /*fCheckPOW=*/!pow_checked)) {
             LogDebug(BCLog::VALIDATION, "%s: Consensus::CheckBlockHeader: %s, %s\n", __func__, hash.ToString(), state.ToString());
             return false;
         }
@@ -4409,7 +4430,9 @@ bool ChainstateManager::AcceptBlock(const std::shared_ptr<const CBlock>& pblock,
     CBlockIndex *pindexDummy = nullptr;
     CBlockIndex *&pindex = ppindex ? *ppindex : pindexDummy;
 
-    bool accepted_header{AcceptBlockHeader(block, state, &pindex, min_pow_checked)};
+    // If CheckBlock() already passed for this block (e.g. in ProcessNewBlock()
+    // or on the block loading threads), its proof of work is known to be valid.
+    bool accepted_header{AcceptBlockHeader(block, state, &pindex, min_pow_checked, /*pow_checked=*/block.fChecked)};
     CheckBlockIndex();
 
     if (!accepted_header)
@@ -5026,25 +5049,79 @@ bool Chainstate::LoadGenesisBlock()
     return true;
 }
 
-void ChainstateManager::LoadExternalBlockFile(
-    AutoFile& file_in,
-    FlatFilePos* dbp,
-    std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent)
+namespace {
+/**
+ * Reads the blocks of a block file for ChainstateManager::LoadExternalBlockFile().
+ *
+ * A scanner thread searches the file for blocks and reads their headers.
+ * Worker threads deserialize the blocks and run CheckBlock() on them, which
+ * verifies the proof of work (the most expensive part of loading a block)
+ * and caches the result in CBlock::fChecked.  The caller takes the blocks in
+ * the order of the file with Next(), and either GetBlock() or Skip() each.
+ */
+class ExternalBlockReader
 {
-    // Either both should be specified (-reindex), or neither (-loadblock).
-    assert(!dbp == !blocks_with_unknown_parent);
+public:
+    struct Item {
+        //! Position of the block data in the file.
+        uint64_t pos{0};
+        CBlockHeader header;
+        uint256 hash;
+        //! Serialized block, released once it is deserialized.
+        std::vector<std::byte> data;
+        size_t size{0};
+        std::shared_ptr<CBlock> block;
+        //! Set if the block failed to deserialize.
+        std::exception_ptr error;
+        //! Whether a thread has started deserializing the block (or it is not needed).
+        bool claimed{false};
+        bool done{false};
+    };
 
-    const auto start{SteadyClock::now()};
-    const CChainParams& params{GetParams()};
+private:
+    //! Limit on the size of blocks that were scanned but not taken by the caller yet.
+    static constexpr size_t MAX_PENDING_BYTES{4 * MAX_BLOCK_SERIALIZED_SIZE};
+
+    AutoFile& m_file;
+    const CChainParams& m_params;
+
+    Mutex m_mutex;
+    //! Signalled whenever any of the state below changes.
+    std::condition_variable m_cond;
+    //! Scanned blocks in file order, not taken by the caller yet.
+    std::deque<std::shared_ptr<Item>> m_items GUARDED_BY(m_mutex);
+    //! Scanned blocks that may still have to be deserialized.
+    std::deque<std::shared_ptr<Item>> m_unclaimed GUARDED_BY(m_mutex);
+    size_t m_pending_bytes GUARDED_BY(m_mutex){0};
+    bool m_scan_done GUARDED_BY(m_mutex){false};
+    std::exception_ptr m_scan_error GUARDED_BY(m_mutex);
+    bool m_stop GUARDED_BY(m_mutex){false};
+
+    std::thread m_scanner;
+    std::vector<std::thread> m_workers;
+
+    void Scan() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::exception_ptr error;
+        try {
+            ScanFile();
+        } catch (const std::runtime_error&) {
+            error = std::current_exception();
+        }
+        LOCK(m_mutex);
+        m_scan_error = error;
+        m_scan_done = true;
+        m_cond.notify_all();
+    }
 
-    int nLoaded = 0;
-    try {
-        BufferedFile blkdat{file_in, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
+    void ScanFile() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        BufferedFile blkdat{m_file, 2 * MAX_BLOCK_SERIALIZED_SIZE, MAX_BLOCK_SERIALIZED_SIZE + 8};
         // nRewind indicates where to resume scanning in case something goes wrong,
-        // such as a block fails to deserialize.
+        // such as a block header fails to deserialize.
         uint64_t nRewind = blkdat.GetPos();
         while (!blkdat.eof()) {
-            if (m_interrupt) return;
+            if (WITH_LOCK(m_mutex, return m_stop)) return;
 
             blkdat.SetPos(nRewind);
             nRewind++; // start one byte further next time, in case of failure
@@ -5053,10 +5130,10 @@ void ChainstateManager::LoadExternalBlockFile(
             try {
                 // locate a header
                 MessageStartChars buf;
-                blkdat.FindByte(std::byte(params.MessageStart()[0]));
+                blkdat.FindByte(std::byte(m_params.MessageStart()[0]));
                 nRewind = blkdat.GetPos() + 1;
                 blkdat >> buf;
-                if (buf != params.MessageStart()) {
+                if (buf != m_params.MessageStart()) {
                     continue;
                 }
                 // read size
@@ -5070,50 +5147,208 @@ void ChainstateManager::LoadExternalBlockFile(
             }
             try {
                 // read block header
-                const uint64_t nBlockPos{blkdat.GetPos()};
+                auto item{std::make_shared<Item>()};
+                item->pos = blkdat.GetPos();
+                item->size = nSize;
+                blkdat.SetLimit(item->pos + nSize);
+                blkdat >> item->header;
+                item->hash = item->header.GetHash();
+                // Rewind to the start of the block (without a disk read) and read
+                // all of it for the worker threads; continue after it.
+                nRewind = item->pos + nSize;
+                blkdat.SetPos(item->pos);
+                item->data.resize(nSize);
+                blkdat.read(item->data);
+                Push(std::move(item));
+            } catch (const std::exception& e) {
+                // Extra data between blocks is not fatal, see LoadExternalBlockFile().
+                LogDebug(BCLog::REINDEX, "LoadExternalBlockFile: unexpected data at file offset 0x%x - %s. continuing\n", (nRewind - 1), e.what());
+            }
+        }
+    }
+
+    void Push(std::shared_ptr<Item> item) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+            return m_stop || m_items.empty() || m_pending_bytes + item->size <= MAX_PENDING_BYTES;
+        });
+        if (m_stop) return;
+        m_pending_bytes += item->size;
+        m_unclaimed.push_back(item);
+        m_items.push_back(std::move(item));
+        m_cond.notify_all();
+    }
+
+    void Work() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) {
+                return m_stop || m_scan_done || !m_unclaimed.empty();
+            });
+            if (m_stop || m_unclaimed.empty()) return;
+            const auto item{std::move(m_unclaimed.front())};
+            m_unclaimed.pop_front();
+            if (item->claimed) continue;
+            item->claimed = true;
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                Process(*item);
+            }
+            item->done = true;
+            m_cond.notify_all();
+        }
+    }
+
+    void Process(Item& item) const
+    {
+        try {
+            auto block{std::make_shared<CBlock>()};
+            SpanReader{item.data} >> TX_WITH_WITNESS(*block);
+            // An invalid block is rejected with the proper state by AcceptBlock().
+            BlockValidationState state;
+            CheckBlock(*block, state, m_params.GetConsensus());
+            item.block = std::move(block);
+        } catch (const std::exception&) {
+            item.error = std::current_exception();
+        }
+        item.data = {};
+    }
+
+public:
+    ExternalBlockReader(AutoFile& file, const CChainParams& params, int worker_threads_num)
+        : m_file{file}, m_params{params}
+    {
+        m_scanner = std::thread{[this] {
+            util::ThreadRename("blkscan");
+            Scan();
+        }};
+        for (int n = 0; n < worker_threads_num; ++n) {
+            m_workers.emplace_back([this, n] {
+                util::ThreadRename(strprintf("blkcheck.%i", n));
+                Work();
+            });
+        }
+    }
+
+    ExternalBlockReader(const ExternalBlockReader&) = delete;
+    ExternalBlockReader& operator=(const ExternalBlockReader&) = delete;
+
+    ~ExternalBlockReader()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cond.notify_all();
+        m_scanner.join();
+        for (auto& worker : m_workers) worker.join();
+    }
+
+    /** Return the next block of the file, or nullptr at the end of the file. */
+    std::shared_ptr<Item> Next() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_scan_done || !m_items.empty(); });
+        if (m_items.empty()) {
+            if (m_scan_error) std::rethrow_exception(m_scan_error);
+            return nullptr;
+        }
+        auto item{std::move(m_items.front())};
+        m_items.pop_front();
+        m_pending_bytes -= item->size;
+        m_cond.notify_all();
+        return item;
+    }
+
+    /** Return the deserialized block, deserializing it on this thread if no
+     *  worker has started yet.  Throws if it fails to deserialize. */
+    std::shared_ptr<CBlock> GetBlock(Item& item) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        if (!item.claimed) {
+            item.claimed = true;
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                Process(item);
+            }
+            item.done = true;
+        }
+        m_cond.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return item.done; });
+        if (item.error) std::rethrow_exception(item.error);
+        return item.block;
+    }
+
+    /** Mark a block as not needed, so that workers do not deserialize it. */
+    void Skip(Item& item) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        item.claimed = true;
+    }
+};
+} // namespace
+
+void ChainstateManager::LoadExternalBlockFile(
+    AutoFile& file_in,
+    FlatFilePos* dbp,
+    std::multimap<uint256, FlatFilePos>* blocks_with_unknown_parent)
+{
+    // Either both should be specified (-reindex), or neither (-loadblock).
+    assert(!dbp == !blocks_with_unknown_parent);
+
+    const auto start{SteadyClock::now()};
+    const CChainParams& params{GetParams()};
+
+    int nLoaded = 0;
+    try {
+        ExternalBlockReader reader{file_in, params, std::clamp(m_options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)};
+        while (const auto item{reader.Next()}) {
+            if (m_interrupt) return;
+
+            const uint256& hash{item->hash};
+            try {
                 if (dbp)
-                    dbp->nPos = nBlockPos;
-                blkdat.SetLimit(nBlockPos + nSize);
-                CBlockHeader header;
-                blkdat >> header;
-                const uint256 hash{header.GetHash()};
-                // Skip the rest of this block (this may read from disk into memory); position to the marker before the
-                // next block, but it's still possible to rewind to the start of the current block (without a disk read).
-                nRewind = nBlockPos + nSize;
-                blkdat.SkipTo(nRewind);
+                    dbp->nPos = item->pos;
 
                 std::shared_ptr<CBlock> pblock{}; // needs to remain available after the cs_main lock is released to avoid duplicate reads from disk
 
+                bool process{false};
                 {
                     LOCK(cs_main);
                     // detect out of order blocks, and store them for later
-                    if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(header.hashPrevBlock)) {
+                    if (hash != params.GetConsensus().hashGenesisBlock && !m_blockman.LookupBlockIndex(item->header.hashPrevBlock)) {
                         LogDebug(BCLog::REINDEX, "%s: Out of order block %s, parent %s not known\n", __func__, hash.ToString(),
-                                 header.hashPrevBlock.ToString());
+                                 item->header.hashPrevBlock.ToString());
                         if (dbp && blocks_with_unknown_parent) {
-                            blocks_with_unknown_parent->emplace(header.hashPrevBlock, *dbp);
+                            blocks_with_unknown_parent->emplace(item->header.hashPrevBlock, *dbp);
                         }
+                        reader.Skip(*item);
                         continue;
                     }
 
                     // process in case the block isn't known yet
                     const CBlockIndex* pindex = m_blockman.LookupBlockIndex(hash);
                     if (!pindex || (pindex->nStatus & BLOCK_HAVE_DATA) == 0) {
-                        // This block can be processed immediately; rewind to its start, read and deserialize it.
-                        blkdat.SetPos(nBlockPos);
-                        pblock = std::make_shared<CBlock>();
-                        blkdat >> TX_WITH_WITNESS(*pblock);
-                        nRewind = blkdat.GetPos();
-
-                        BlockValidationState state;
-                        if (AcceptBlock(pblock, state, nullptr, true, dbp, nullptr, true)) {
-                            nLoaded++;
-                        }
-                        if (state.IsError()) {
-                            break;
+                        process = true;
+                    } else {
+                        reader.Skip(*item);
+                        if (hash != params.GetConsensus().hashGenesisBlock && pindex->nHeight % 1000 == 0) {
+                            LogDebug(BCLog::REINDEX, "Block Import: already had block %s at height %d\n", hash.ToString(), pindex->nHeight);
                         }
-                    } else if (hash != params.GetConsensus().hashGenesisBlock && pindex->nHeight % 1000 == 0) {
-                        LogDebug(BCLog::REINDEX, "Block Import: already had block %s at height %d\n", hash.ToString(), pindex->nHeight);
+                    }
+                }
+
+                if (process) {
+                    // This block can be processed immediately.  It has usually
+                    // been deserialized and checked by a worker thread already;
+                    // otherwise do that here, without holding cs_main.
+                    pblock = reader.GetBlock(*item);
+
+                    LOCK(cs_main);
+                    BlockValidationState state;
+                    if (AcceptBlock(pblock, state, nullptr, true, dbp, nullptr, true)) {
+                        nLoaded++;
+                    }
+                    if (state.IsError()) {
+                        break;
                     }
                 }
 
@@ -5194,7 +5429,7 @@ void ChainstateManager::LoadExternalBlockFile(
                 // the reindex process is not the place to attempt to clean and/or compact the block files. if so desired, a studious node operator
                 // may use knowledge of the fact that the block files are not entirely pristine in order to prepare a set of pristine, and
                 // perhaps ordered, block files for later reindexing.
-                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, (nRewind - 1), e.what());
+                LogDebug(BCLog::REINDEX, "%s: unexpected data at file offset 0x%x - %s. continuing\n", __func__, item->pos, e.what());
             }
         }
     } catch (const std::runtime_error& e) {
@@ -5854,6 +6089,63 @@ static void SnapshotUTXOHashBreakpoint(const util::SignalInterrupt& interrupt)
     if (interrupt) throw StopHashingException();
 }
 
+/** Returns the name database entry implied by a name output in the UTXO set. */
+static std::optional<std::pair<valtype, CNameData>> NameEntryFromCoin(const COutPoint& outpoint, const Coin& coin)
+{
+    // Cheap check first, so that ordinary coins are not copied for parsing
+    const CScript& script{coin.out.scriptPubKey};
+    if (script.empty() || (script[0] != OP_NAME_REGISTER && script[0] != OP_NAME_UPDATE)) return std::nullopt;
+
+    const CNameScript nameOp(script);
+    if (!nameOp.isNameOp() || !nameOp.isAnyUpdate()) return std::nullopt;
+    CNameData data;
+    data.fromScript(coin.nHeight, outpoint, nameOp);
+    return std::make_pair(nameOp.getOpName(), std::move(data));
+}
+
+/**
+ * Checks the name database entries of a snapshot against the name outputs in
+ * its UTXO set. Each entry must be exactly the one implied by the coin at its
+ * update outpoint. Since the caller also ensures that the names are unique and
+ * that there are as many entries as name outputs, this ties the name section
+ * to the coins, and thus to the assumeutxo hash. The lookups are spread over
+ * up to worker_threads_num threads besides the caller, as they are random
+ * reads from the coins database.
+ */
+static bool CheckSnapshotNames(const CCoinsView& coins_db, const std::vector<std::pair<valtype, CNameData>>& names, int worker_threads_num)
+{
+    constexpr size_t BATCH_SIZE{1024};
+    std::atomic<size_t> next_batch{0};
+    std::atomic<bool> valid{true};
+
+    const auto check_batches{[&] {
+        while (valid) {
+            const size_t begin{next_batch.fetch_add(BATCH_SIZE)};
+            if (begin >= names.size()) return;
+            for (size_t i = begin; i < std::min(begin + BATCH_SIZE, names.size()); ++i) {
+                const auto& [name, data]{names[i]};
+                const auto coin{coins_db.GetCoin(data.getUpdateOutpoint())};
+                const auto expected{coin ? NameEntryFromCoin(data.getUpdateOutpoint(), *coin) : std::nullopt};
+                if (!expected || expected->first != name || expected->second != data) {
+                    LogPrintf("[snapshot] name entry %s does not match its update outpoint %s\n",
+                              EncodeNameForMessage(name), data.getUpdateOutpoint().ToString());
+                    valid = false;
+                    return;
+                }
+            }
+        }
+    }};
+
+    const size_t num_threads{std::min<size_t>(worker_threads_num, names.size() / BATCH_SIZE)};
+    std::vector<std::thread> threads;
+    for (size_t n = 0; n < num_threads; ++n) {
+        threads.emplace_back(&util::TraceThread, strprintf("loadnames.%i", n), check_batches);
+    }
+    check_batches();
+    for (auto& thread : threads) thread.join();
+    return valid;
+}
+
 util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     Chainstate& snapshot_chainstate,
     AutoFile& coins_file,
@@ -5891,11 +6183,17 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
         return util::Error{Untranslated("Work does not exceed active chainstate")};
     }
 
+    // The snapshot does not contain the name history for blocks before its base
+    if (fNameHistory) {
+        return util::Error{Untranslated("Snapshots cannot be loaded with -namehistory")};
+    }
+
     const uint64_t coins_count = metadata.m_coins_count;
     uint64_t coins_left = metadata.m_coins_count;
 
     LogPrintf("[snapshot] loading %d coins from snapshot %s\n", coins_left, base_blockhash.ToString());
     int64_t coins_processed{0};
+    uint64_t name_coins{0};
 
     while (coins_left > 0) {
         try {
@@ -5924,6 +6222,7 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
                     return util::Error{Untranslated(strprintf("Bad snapshot data after deserializing %d coins - bad tx out value",
                               coins_count - coins_left))};
                 }
+                if (NameEntryFromCoin(outpoint, coin)) ++name_coins;
                 coins_cache.EmplaceCoinInternalDANGER(std::move(outpoint), std::move(coin));
 
                 --coins_left;
@@ -5972,6 +6271,32 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
     // method.
     coins_cache.SetBestBlock(base_blockhash);
 
+    // Every name output in the UTXO set has exactly one name database entry
+    if (metadata.m_names_count != name_coins) {
+        return util::Error{Untranslated(strprintf("Mismatch between name entries (%d) and name outputs (%d) in snapshot",
+                  metadata.m_names_count, name_coins))};
+    }
+    std::vector<std::pair<valtype, CNameData>> names;
+    names.reserve(name_coins);
+    try {
+        for (uint64_t i = 0; i < metadata.m_names_count; ++i) {
+            valtype name;
+            CNameData data;
+            coins_file >> name >> data;
+            names.emplace_back(std::move(name), std::move(data));
+        }
+    } catch (const std::ios_base::failure&) {
+        return util::Error{Untranslated(strprintf("Bad snapshot format or truncated snapshot after deserializing %d names",
+                  names.size()))};
+    }
+    std::sort(names.begin(), names.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+    if (std::adjacent_find(names.begin(), names.end(), [](const auto& a, const auto& b) { return a.first == b.first; }) != names.end()) {
+        return util::Error{Untranslated("Bad snapshot - duplicate name entries")};
+    }
+    for (const auto& [name, data] : names) {
+        coins_cache.SetName(name, data, /*undo=*/false);
+    }
+
     bool out_of_coins{false};
     try {
         std::byte left_over_byte;
@@ -5985,9 +6310,10 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
             coins_count))};
     }
 
-    LogPrintf("[snapshot] loaded %d (%.2f MB) coins from snapshot %s\n",
+    LogPrintf("[snapshot] loaded %d (%.2f MB) coins and %d names from snapshot %s\n",
         coins_count,
         coins_cache.DynamicMemoryUsage() / (1000 * 1000),
+        names.size(),
         base_blockhash.ToString());
 
     // No need to acquire cs_main since this chainstate isn't being used yet.
@@ -6017,6 +6343,10 @@ util::Result<void> ChainstateManager::PopulateAndValidateSnapshot(
             au_data.hash_serialized.ToString(), maybe_stats->hashSerialized.ToString()))};
     }
 
+    if (!CheckSnapshotNames(*snapshot_coinsdb, names, std::clamp(m_options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS))) {
+        return util::Error{Untranslated("Bad snapshot - name entries do not match the UTXO set")};
+    }
+
     snapshot_chainstate.m_chain.SetTip(*snapshot_start_block);
 
     // The remainder of this function requires modifying data protected by cs_main.
@@ -6193,6 +6523,21 @@ SnapshotCompletionResult ChainstateManager::MaybeCompleteSnapshotValidation()
         return SnapshotCompletionResult::HASH_MISMATCH;
     }
 
+    // The snapshot's name entries were checked against its coins on load, which
+    // are now known to be correct. Make sure the name database built by
+    // validation agrees with the same UTXO set.
+    bool names_valid;
+    try {
+        names_valid = ibd_coins_db.ValidateNameDB(*m_ibd_chainstate, [&interrupt = m_interrupt] { SnapshotUTXOHashBreakpoint(interrupt); });
+    } catch (StopHashingException const&) {
+        return SnapshotCompletionResult::STATS_FAILED;
+    }
+    if (!names_valid) {
+        LogPrintf("[snapshot] name database of the background chainstate is inconsistent\n");
+        handle_invalid_snapshot();
+        return SnapshotCompletionResult::NAME_DB_MISMATCH;
+    }
+
     LogPrintf("[snapshot] snapshot beginning at %s has been fully validated\n",
         snapshot_blockhash.ToString());
 
@@ -6272,7 +6617,7 @@ static ChainstateManager::Options&& Flatten(ChainstateManager::Options&& opts)
 }
 
 ChainstateManager::ChainstateManager(const util::SignalInterrupt& interrupt, Options options, node::BlockManager::Options blockman_options)
-    : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS)},
+    : m_script_check_queue{/*batch_size=*/128, std::clamp(options.worker_threads_num, 0, MAX_SCRIPTCHECK_THREADS), options.batch_schnorr_verification},
       m_interrupt{interrupt},
       m_options{Flatten(std::move(options))},
       m_blockman{interrupt, std::move(blockman_options)},
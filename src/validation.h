@@ -339,6 +339,8 @@ private:
     PrecomputedTransactionData *txdata;
     SignatureCache* m_signature_cache;
 
+    std::optional<std::pair<ScriptError, std::string>> Verify(const BaseSignatureChecker& checker) const;
+
 public:
     CScriptCheck(const CTxOut& outIn, const CTransaction& txToIn, SignatureCache& signature_cache, unsigned int nInIn, unsigned int nFlagsIn, bool cacheIn, PrecomputedTransactionData* txdataIn) :
         m_tx_out(outIn), ptxTo(&txToIn), nIn(nInIn), nFlags(nFlagsIn), cacheStore(cacheIn), txdata(txdataIn), m_signature_cache(&signature_cache) { }
@@ -348,7 +350,15 @@ public:
     CScriptCheck(CScriptCheck&&) = default;
     CScriptCheck& operator=(CScriptCheck&&) = default;
 
+    //! Lets CCheckQueue verify the Schnorr signatures of many checks together.
+    using Batch = SchnorrBatch;
+
     std::optional<std::pair<ScriptError, std::string>> operator()();
+
+    /** Run the check, but defer the verification of Schnorr signatures to
+     *  batch.  The check only succeeded if the batch verifies afterwards;
+     *  if it does not, the check has to be repeated with operator()(). */
+    std::optional<std::pair<ScriptError, std::string>> operator()(SchnorrBatch& batch);
 };
 
 // CScriptCheck is used a lot in std::vector, make sure that's efficient
@@ -367,7 +377,7 @@ private:
     CSHA256 m_script_execution_cache_hasher;
 
 public:
-    CuckooCache::cache<uint256, SignatureCacheHasher> m_script_execution_cache;
+    ShardedCuckooCache m_script_execution_cache;
     SignatureCache m_signature_cache;
 
     ValidationCache(size_t script_execution_cache_bytes, size_t signature_cache_bytes);
@@ -860,6 +870,10 @@ enum class SnapshotCompletionResult {
     // The blockhash of the current tip of the background validation chainstate does
     // not match the one expected by the snapshot chainstate.
     BASE_BLOCKHASH_MISMATCH,
+
+    // The name database of the background validation chainstate does not match
+    // its UTXO set.
+    NAME_DB_MISMATCH,
 };
 
 /**
@@ -951,12 +965,15 @@ private:
      * Caller must set min_pow_checked=true in order to add a new header to the
      * block index (permanent memory storage), indicating that the header is
      * known to be part of a sufficiently high-work chain (anti-dos check).
+     * Callers that already verified the proof of work of the header (through
+     * CheckBlock) can set pow_checked=true to skip verifying it again.
      */
     bool AcceptBlockHeader(
         const CBlockHeader& block,
         BlockValidationState& state,
         CBlockIndex** ppindex,
-        bool min_pow_checked) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
+        bool min_pow_checked,
+        bool pow_checked = false) EXCLUSIVE_LOCKS_REQUIRED(cs_main);
     friend Chainstate;
 
     /** Most recent headers presync progress update, for rate-limiting. */
@@ -1177,6 +1194,10 @@ public:
      * This function can also be used to read blocks from user-specified block files using the
      * -loadblock= option. There's no unknown-parent tracking, so the last two arguments are omitted.
      *
+     * The file is scanned on a separate thread, and up to worker_threads_num threads deserialize
+     * the blocks and check their proof of work ahead of time. The blocks are still processed in
+     * the order of the file, on the calling thread.
+     *
      *
      * @param[in]     file_in                       File containing blocks to read
      * @param[in]     dbp                           (optional) Disk block position (only for reindex)
@@ -15,11 +15,120 @@
 #include <primitives/transaction.h>
 #include <util/check.h>
 #include <util/task_runner.h>
+#include <util/thread.h>
+#include <util/time.h>
 
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
 #include <future>
+#include <map>
+#include <thread>
 #include <unordered_map>
 #include <utility>
 
+namespace {
+/** Latency statistics of a notification queue */
+struct QueueLatency {
+    uint64_t processed{0};
+    std::chrono::microseconds total{0};
+    std::chrono::microseconds max{0};
+
+    void Add(SteadyClock::duration latency)
+    {
+        const auto micros{std::chrono::duration_cast<std::chrono::microseconds>(latency)};
+        ++processed;
+        total += micros;
+        max = std::max(max, micros);
+    }
+
+    void ToStats(ValidationQueueStats& stats) const
+    {
+        stats.processed = processed;
+        stats.latency_avg = processed > 0 ? total / static_cast<int64_t>(processed) : std::chrono::microseconds{0};
+        stats.latency_max = max;
+    }
+};
+
+/**
+ * Queue of callbacks for subscribers that are registered with their own
+ * queue. The callbacks are run in order by a dedicated thread.
+ */
+class SubscriberQueue
+{
+private:
+    Mutex m_mutex;
+    std::condition_variable m_cv;
+    std::deque<std::pair<std::function<void()>, SteadyClock::time_point>> m_pending GUARDED_BY(m_mutex);
+    bool m_running GUARDED_BY(m_mutex){false};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    QueueLatency m_latency GUARDED_BY(m_mutex);
+    std::thread m_thread;
+
+    void ThreadRun() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || !m_pending.empty(); });
+            // Callbacks that are still queued are run before stopping
+            if (m_pending.empty()) return;
+            auto [func, queued_time]{std::move(m_pending.front())};
+            m_pending.pop_front();
+            m_running = true;
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                func();
+            }
+            m_running = false;
+            m_latency.Add(SteadyClock::now() - queued_time);
+            m_cv.notify_all();
+        }
+    }
+
+public:
+    const std::string m_name;
+
+    explicit SubscriberQueue(std::string name) : m_name{std::move(name)}
+    {
+        m_thread = std::thread{&util::TraceThread, "valq." + m_name, [this] { ThreadRun(); }};
+    }
+
+    ~SubscriberQueue()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_cv.notify_all();
+        m_thread.join();
+    }
+
+    void Insert(std::function<void()> func) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WITH_LOCK(m_mutex, m_pending.emplace_back(std::move(func), SteadyClock::now()));
+        m_cv.notify_all();
+    }
+
+    /** Wait until all callbacks queued so far have run */
+    void Flush() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        m_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_pending.empty() && !m_running; });
+    }
+
+    size_t Size() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        return m_pending.size();
+    }
+
+    void GetStats(ValidationQueueStats& stats) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        stats.name = m_name;
+        stats.pending = m_pending.size();
+        m_latency.ToStats(stats);
+    }
+};
+} // namespace
+
 /**
  * ValidationSignalsImpl manages a list of shared_ptr<CValidationInterface> callbacks.
  *
@@ -32,35 +141,62 @@ class ValidationSignalsImpl
 {
 private:
     Mutex m_mutex;
+    std::condition_variable m_callbacks_done;
     //! List entries consist of a callback pointer and reference count. The
     //! count is equal to the number of current executions of that entry, plus 1
     //! if it's registered. It cannot be 0 because that would imply it is
-    //! unregistered and also not being executed (so shouldn't exist).
-    struct ListEntry { std::shared_ptr<CValidationInterface> callbacks; int count = 1; };
+    //! unregistered and also not being executed (so shouldn't exist). Entries
+    //! of subscribers with their own queue also point to that queue.
+    struct ListEntry { std::shared_ptr<CValidationInterface> callbacks; int count = 1; SubscriberQueue* queue = nullptr; };
     std::list<ListEntry> m_list GUARDED_BY(m_mutex);
     std::unordered_map<CValidationInterface*, std::list<ListEntry>::iterator> m_map GUARDED_BY(m_mutex);
 
+    Mutex m_main_latency_mutex;
+    QueueLatency m_main_latency GUARDED_BY(m_main_latency_mutex);
+
+    //! Queues of subscribers that do not use the main queue, by name. They are
+    //! declared last so that their threads are stopped first on destruction.
+    std::map<std::string, std::unique_ptr<SubscriberQueue>> m_queues GUARDED_BY(m_mutex);
+
+    //! Decrement the count of an entry after executing it
+    void ReleaseEntry(std::list<ListEntry>::iterator it) EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        if (!--it->count) m_list.erase(it);
+        m_callbacks_done.notify_all();
+    }
+
 public:
     std::unique_ptr<util::TaskRunnerInterface> m_task_runner;
 
     explicit ValidationSignalsImpl(std::unique_ptr<util::TaskRunnerInterface> task_runner)
         : m_task_runner{std::move(Assert(task_runner))} {}
 
-    void Register(std::shared_ptr<CValidationInterface> callbacks) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    void Register(std::shared_ptr<CValidationInterface> callbacks, const std::string& queue_name = {}) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
         LOCK(m_mutex);
         auto inserted = m_map.emplace(callbacks.get(), m_list.end());
         if (inserted.second) inserted.first->second = m_list.emplace(m_list.end());
         inserted.first->second->callbacks = std::move(callbacks);
+        if (!queue_name.empty()) {
+            auto& queue{m_queues[queue_name]};
+            if (!queue) queue = std::make_unique<SubscriberQueue>(queue_name);
+            inserted.first->second->queue = queue.get();
+        }
     }
 
     void Unregister(CValidationInterface* callbacks) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
-        LOCK(m_mutex);
+        WAIT_LOCK(m_mutex, lock);
         auto it = m_map.find(callbacks);
         if (it != m_map.end()) {
-            if (!--it->second->count) m_list.erase(it->second);
+            const auto entry{it->second};
             m_map.erase(it);
+            // Callbacks on a subscriber queue run concurrently with the caller,
+            // which may destroy the subscriber once this returns.
+            if (entry->queue) {
+                m_callbacks_done.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return entry->count == 1; });
+            }
+            ReleaseEntry(entry);
         }
     }
 
@@ -72,23 +208,120 @@ public:
     {
         LOCK(m_mutex);
         for (const auto& entry : m_map) {
-            if (!--entry.second->count) m_list.erase(entry.second);
+            ReleaseEntry(entry.second);
         }
         m_map.clear();
     }
 
-    template<typename F> void Iterate(F&& f) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    //! Call f for the registered subscribers, or only those that are notified
+    //! through the main queue.
+    template<typename F> void Iterate(F&& f, bool main_queue_only = false) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
     {
         WAIT_LOCK(m_mutex, lock);
         for (auto it = m_list.begin(); it != m_list.end();) {
+            if (main_queue_only && it->queue) {
+                ++it;
+                continue;
+            }
             ++it->count;
             {
                 REVERSE_LOCK(lock, m_mutex);
                 f(*it->callbacks);
             }
-            it = --it->count ? std::next(it) : m_list.erase(it);
+            auto next{std::next(it)};
+            ReleaseEntry(it);
+            it = next;
         }
     }
+
+    /** Queue an event for all subscribers, on the main and their own queues */
+    void Enqueue(std::function<void(CValidationInterface&)> event, std::function<void()> log_event) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        InsertMain([this, event, log_event] {
+            log_event();
+            Iterate(event, /*main_queue_only=*/true);
+        });
+        LOCK(m_mutex);
+        for (const auto& [callbacks, entry] : m_map) {
+            if (!entry->queue) continue;
+            entry->queue->Insert([this, callbacks, event] {
+                // The subscriber may have been unregistered in the meantime
+                WAIT_LOCK(m_mutex, lock);
+                const auto it{m_map.find(callbacks)};
+                if (it == m_map.end()) return;
+                const auto entry{it->second};
+                ++entry->count;
+                {
+                    REVERSE_LOCK(lock, m_mutex);
+                    event(*entry->callbacks);
+                }
+                ReleaseEntry(entry);
+            });
+        }
+    }
+
+    void InsertMain(std::function<void()> func) EXCLUSIVE_LOCKS_REQUIRED(!m_main_latency_mutex)
+    {
+        m_task_runner->insert([this, func = std::move(func), queued_time = SteadyClock::now()] {
+            func();
+            WITH_LOCK(m_main_latency_mutex, m_main_latency.Add(SteadyClock::now() - queued_time));
+        });
+    }
+
+    /** Queue a barrier on each subscriber queue, which is ready once the callbacks queued before it have run */
+    std::vector<std::shared_future<void>> QueueBarriers() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<std::shared_future<void>> barriers;
+        LOCK(m_mutex);
+        for (const auto& [_, queue] : m_queues) {
+            auto promise{std::make_shared<std::promise<void>>()};
+            barriers.push_back(promise->get_future().share());
+            queue->Insert([promise] { promise->set_value(); });
+        }
+        return barriers;
+    }
+
+    void FlushQueues() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<SubscriberQueue*> queues;
+        {
+            LOCK(m_mutex);
+            for (const auto& [_, queue] : m_queues) queues.push_back(queue.get());
+        }
+        // Queues are never removed, so they stay valid without the lock
+        for (SubscriberQueue* queue : queues) queue->Flush();
+    }
+
+    size_t MaxQueueSize() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        size_t max_size{m_task_runner->size()};
+        LOCK(m_mutex);
+        for (const auto& [_, queue] : m_queues) max_size = std::max(max_size, queue->Size());
+        return max_size;
+    }
+
+    std::vector<ValidationQueueStats> GetStats() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex, !m_main_latency_mutex)
+    {
+        std::vector<ValidationQueueStats> result(1);
+        result[0].name = "main";
+        result[0].pending = m_task_runner->size();
+        WITH_LOCK(m_main_latency_mutex, m_main_latency.ToStats(result[0]));
+
+        LOCK(m_mutex);
+        std::map<const SubscriberQueue*, size_t> subscribers;
+        for (const auto& [_, entry] : m_map) {
+            if (entry->queue) {
+                ++subscribers[entry->queue];
+            } else {
+                ++result[0].subscribers;
+            }
+        }
+        for (const auto& [_, queue] : m_queues) {
+            queue->GetStats(result.emplace_back());
+            result.back().subscribers = subscribers[queue.get()];
+        }
+        return result;
+    }
 };
 
 ValidationSignals::ValidationSignals(std::unique_ptr<util::TaskRunnerInterface> task_runner)
@@ -99,11 +332,17 @@ ValidationSignals::~ValidationSignals() = default;
 void ValidationSignals::FlushBackgroundCallbacks()
 {
     m_internals->m_task_runner->flush();
+    m_internals->FlushQueues();
 }
 
 size_t ValidationSignals::CallbacksPending()
 {
-    return m_internals->m_task_runner->size();
+    return m_internals->MaxQueueSize();
+}
+
+std::vector<ValidationQueueStats> ValidationSignals::GetQueueStats()
+{
+    return m_internals->GetStats();
 }
 
 void ValidationSignals::RegisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks)
@@ -120,6 +359,12 @@ void ValidationSignals::RegisterValidationInterface(CValidationInterface* callba
     RegisterSharedValidationInterface({callbacks, [](CValidationInterface*){}});
 }
 
+void ValidationSignals::RegisterValidationInterface(CValidationInterface* callbacks, const std::string& queue_name)
+{
+    Assert(!queue_name.empty());
+    m_internals->Register({callbacks, [](CValidationInterface*){}}, queue_name);
+}
+
 void ValidationSignals::UnregisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks)
 {
     UnregisterValidationInterface(callbacks.get());
@@ -137,7 +382,12 @@ void ValidationSignals::UnregisterAllValidationInterfaces()
 
 void ValidationSignals::CallFunctionInValidationInterfaceQueue(std::function<void()> func)
 {
-    m_internals->m_task_runner->insert(std::move(func));
+    // Subscriber queues run independently of the main queue, so wait for them
+    // to catch up as well.
+    m_internals->InsertMain([func = std::move(func), barriers = m_internals->QueueBarriers()] {
+        for (const auto& barrier : barriers) barrier.wait();
+        func();
+    });
 }
 
 void ValidationSignals::SyncWithValidationInterfaceQueue()
@@ -159,9 +409,8 @@ void ValidationSignals::SyncWithValidationInterfaceQueue()
     do {                                                       \
         auto local_name = (name);                              \
         LOG_EVENT("Enqueuing " fmt, local_name, __VA_ARGS__);  \
-        m_internals->m_task_runner->insert([=] { \
+        m_internals->Enqueue(event, [=] {                      \
             LOG_EVENT(fmt, local_name, __VA_ARGS__);           \
-            event();                                           \
         });                                                    \
     } while (0)
 
@@ -173,8 +422,8 @@ void ValidationSignals::UpdatedBlockTip(const CBlockIndex *pindexNew, const CBlo
     // the chain actually updates. One way to ensure this is for the caller to invoke this signal
     // in the same critical section where the chain is updated
 
-    auto event = [pindexNew, pindexFork, fInitialDownload, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.UpdatedBlockTip(pindexNew, pindexFork, fInitialDownload); });
+    auto event = [pindexNew, pindexFork, fInitialDownload](CValidationInterface& callbacks) {
+        callbacks.UpdatedBlockTip(pindexNew, pindexFork, fInitialDownload);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: new block hash=%s fork block hash=%s (in IBD=%s)", __func__,
                           pindexNew->GetBlockHash().ToString(),
@@ -190,8 +439,8 @@ void ValidationSignals::ActiveTipChange(const CBlockIndex& new_tip, bool is_ibd)
 
 void ValidationSignals::TransactionAddedToMempool(const NewMempoolTransactionInfo& tx, uint64_t mempool_sequence)
 {
-    auto event = [tx, mempool_sequence, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.TransactionAddedToMempool(tx, mempool_sequence); });
+    auto event = [tx, mempool_sequence](CValidationInterface& callbacks) {
+        callbacks.TransactionAddedToMempool(tx, mempool_sequence);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s wtxid=%s", __func__,
                           tx.info.m_tx->GetHash().ToString(),
@@ -199,8 +448,8 @@ void ValidationSignals::TransactionAddedToMempool(const NewMempoolTransactionInf
 }
 
 void ValidationSignals::TransactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRemovalReason reason, uint64_t mempool_sequence) {
-    auto event = [tx, reason, mempool_sequence, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.TransactionRemovedFromMempool(tx, reason, mempool_sequence); });
+    auto event = [tx, reason, mempool_sequence](CValidationInterface& callbacks) {
+        callbacks.TransactionRemovedFromMempool(tx, reason, mempool_sequence);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: txid=%s wtxid=%s reason=%s", __func__,
                           tx->GetHash().ToString(),
@@ -209,8 +458,8 @@ void ValidationSignals::TransactionRemovedFromMempool(const CTransactionRef& tx,
 }
 
 void ValidationSignals::BlockConnected(ChainstateRole role, const std::shared_ptr<const CBlock> &pblock, const CBlockIndex *pindex) {
-    auto event = [role, pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockConnected(role, pblock, pindex); });
+    auto event = [role, pblock, pindex](CValidationInterface& callbacks) {
+        callbacks.BlockConnected(role, pblock, pindex);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
@@ -219,8 +468,8 @@ void ValidationSignals::BlockConnected(ChainstateRole role, const std::shared_pt
 
 void ValidationSignals::MempoolTransactionsRemovedForBlock(const std::vector<RemovedMempoolTransactionInfo>& txs_removed_for_block, unsigned int nBlockHeight)
 {
-    auto event = [txs_removed_for_block, nBlockHeight, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.MempoolTransactionsRemovedForBlock(txs_removed_for_block, nBlockHeight); });
+    auto event = [txs_removed_for_block, nBlockHeight](CValidationInterface& callbacks) {
+        callbacks.MempoolTransactionsRemovedForBlock(txs_removed_for_block, nBlockHeight);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block height=%s txs removed=%s", __func__,
                           nBlockHeight,
@@ -229,8 +478,8 @@ void ValidationSignals::MempoolTransactionsRemovedForBlock(const std::vector<Rem
 
 void ValidationSignals::BlockDisconnected(const std::shared_ptr<const CBlock>& pblock, const CBlockIndex* pindex)
 {
-    auto event = [pblock, pindex, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.BlockDisconnected(pblock, pindex); });
+    auto event = [pblock, pindex](CValidationInterface& callbacks) {
+        callbacks.BlockDisconnected(pblock, pindex);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s block height=%d", __func__,
                           pblock->GetHash().ToString(),
@@ -238,8 +487,8 @@ void ValidationSignals::BlockDisconnected(const std::shared_ptr<const CBlock>& p
 }
 
 void ValidationSignals::ChainStateFlushed(ChainstateRole role, const CBlockLocator &locator) {
-    auto event = [role, locator, this] {
-        m_internals->Iterate([&](CValidationInterface& callbacks) { callbacks.ChainStateFlushed(role, locator); });
+    auto event = [role, locator](CValidationInterface& callbacks) {
+        callbacks.ChainStateFlushed(role, locator);
     };
     ENQUEUE_AND_LOG_EVENT(event, "%s: block hash=%s", __func__,
                           locator.IsNull() ? "null" : locator.vHave.front().ToString());
@@ -11,10 +11,12 @@
 #include <primitives/transaction.h>
 #include <sync.h>
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace util {
@@ -161,6 +163,21 @@ protected:
     friend class ValidationInterfaceTest;
 };
 
+/** Statistics about one of the notification queues of ValidationSignals */
+struct ValidationQueueStats {
+    std::string name;
+    //! Number of subscribers notified through the queue
+    size_t subscribers{0};
+    //! Number of queued callbacks that have not run yet
+    size_t pending{0};
+    //! Number of callbacks that have run
+    uint64_t processed{0};
+    //! Time from queueing a callback until it has run, averaged over all of
+    //! them and the maximum
+    std::chrono::microseconds latency_avg{0};
+    std::chrono::microseconds latency_max{0};
+};
+
 class ValidationSignalsImpl;
 class ValidationSignals {
 private:
@@ -195,6 +212,23 @@ public:
     /** Unregister subscriber */
     void UnregisterSharedValidationInterface(std::shared_ptr<CValidationInterface> callbacks);
 
+    /**
+     * Register subscriber whose queued callbacks are run by a separate thread,
+     * so that they neither wait for nor delay the callbacks of subscribers on
+     * the main queue. Subscribers registered with the same queue name share
+     * the queue and thread. Each subscriber still receives its callbacks in
+     * order, and all callbacks queued before a call to
+     * CallFunctionInValidationInterfaceQueue() are finished before its func
+     * is called.
+     *
+     * Unregistering such a subscriber blocks until any callback of it that is
+     * running has finished, so it must not be done from its own callbacks.
+     */
+    void RegisterValidationInterface(CValidationInterface* callbacks, const std::string& queue_name);
+
+    /** Statistics about the main queue and the separate subscriber queues */
+    std::vector<ValidationQueueStats> GetQueueStats();
+
     /**
      * Pushes a function to callback onto the notification queue, guaranteeing any
      * callbacks generated prior to now are finished when the function is called.
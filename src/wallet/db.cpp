@@ -154,6 +154,8 @@ void ReadDatabaseArgs(const ArgsManager& args, DatabaseOptions& options)
 {
     // Override current options with args values, if any were specified
     options.use_unsafe_sync = args.GetBoolArg("-unsafesqlitesync", options.use_unsafe_sync);
+    options.use_wal = args.GetBoolArg("-walletwal", options.use_wal);
+    options.group_commit_window = std::chrono::milliseconds{std::max<int64_t>(0, args.GetIntArg("-walletgroupcommit", options.group_commit_window.count()))};
 }
 
 } // namespace wallet
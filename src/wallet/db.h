@@ -12,6 +12,7 @@
 #include <util/fs.h>
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <optional>
 #include <string>
@@ -178,6 +179,10 @@ struct DatabaseOptions {
     bool use_unsafe_sync = false;   //!< Disable file sync for faster performance.
     bool use_shared_memory = false; //!< Let other processes access the database.
     int64_t max_log_mb = 100;       //!< Max log size to allow before consolidating.
+    bool use_wal = false;           //!< Use a write-ahead log instead of a rollback journal.
+    //! Collect writes made outside of explicit transactions for this long and
+    //! commit them together (zero to commit every write on its own).
+    std::chrono::milliseconds group_commit_window{0};
 };
 
 enum class DatabaseStatus {
@@ -54,7 +54,7 @@ CAmount TxGetCredit(const CWallet& wallet, const CTransaction& tx, const isminef
 
 std::optional<CNameScript> GetNameCredit(const CWallet& wallet, const CTxOut& txout, const isminefilter& filter)
 {
-    CNameScript op(txout.scriptPubKey);
+    const NameScriptView op(txout.scriptPubKey);
     if (!op.isNameOp ())
         return {};
     LOCK(wallet.cs_wallet);
@@ -339,35 +339,120 @@ bool CachedTxIsTrusted(const CWallet& wallet, const CWalletTx& wtx)
     return CachedTxIsTrusted(wallet, wtx, trusted_parents);
 }
 
-Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
+void WalletBalanceCache::Add(const CachedTxBalance& bal, int sign)
 {
-    Balance ret;
-    isminefilter reuse_filter = avoid_reuse ? ISMINE_NO : ISMINE_USED;
-    {
-        LOCK(wallet.cs_wallet);
-        std::set<Txid> trusted_parents;
-        for (const auto& entry : wallet.mapWallet)
-        {
-            const CWalletTx& wtx = entry.second;
-            const bool is_trusted{CachedTxIsTrusted(wallet, wtx, trusted_parents)};
-            const int tx_depth{wallet.GetTxDepthInMainChain(wtx)};
-            const CAmount tx_credit_mine{CachedTxGetAvailableCredit(wallet, wtx, ISMINE_SPENDABLE | reuse_filter)};
-            const CAmount tx_credit_watchonly{CachedTxGetAvailableCredit(wallet, wtx, ISMINE_WATCH_ONLY | reuse_filter)};
-            if (is_trusted && tx_depth >= min_depth) {
-                ret.m_mine_trusted += tx_credit_mine;
-                ret.m_watchonly_trusted += tx_credit_watchonly;
-            }
-            if (!is_trusted && tx_depth == 0 && wtx.InMempool()) {
-                ret.m_mine_untrusted_pending += tx_credit_mine;
-                ret.m_watchonly_untrusted_pending += tx_credit_watchonly;
-            }
-            ret.m_mine_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_SPENDABLE);
-            ret.m_watchonly_immature += CachedTxGetImmatureCredit(wallet, wtx, ISMINE_WATCH_ONLY);
+    for (int used = 0; used < 2; ++used) {
+        if (bal.m_trusted) {
+            (bal.m_confirmed ? m_mine_trusted_confirmed : m_mine_trusted_unconfirmed)[used] += sign * bal.m_mine_credit[used];
+            (bal.m_confirmed ? m_watchonly_trusted_confirmed : m_watchonly_trusted_unconfirmed)[used] += sign * bal.m_watchonly_credit[used];
         }
+        if (bal.m_pending) {
+            m_mine_untrusted_pending[used] += sign * bal.m_mine_credit[used];
+            m_watchonly_untrusted_pending[used] += sign * bal.m_watchonly_credit[used];
+        }
+    }
+    m_mine_immature += sign * bal.m_mine_immature;
+    m_watchonly_immature += sign * bal.m_watchonly_immature;
+    m_mine_names += sign * bal.m_mine_names;
+}
+
+static CAmount TxGetLockedNameAmount(const CWallet& wallet, const CWalletTx& wtx) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet)
+{
+    CAmount locked = 0;
+    for (unsigned int i = 0; i < wtx.tx->vout.size(); ++i) {
+        const CTxOut& txout = wtx.tx->vout[i];
+        if (!CNameScript::isNameScript(txout.scriptPubKey)) continue;
+        if (!(wallet.IsMine(txout) & ISMINE_SPENDABLE)) continue;
+        if (wallet.IsSpent(COutPoint(wtx.GetHash(), i))) continue;
+        locked += txout.nValue;
+    }
+    return locked;
+}
+
+static CachedTxBalance ComputeTxBalance(const CWallet& wallet, const CWalletTx& wtx, std::set<Txid>& trusted_parents) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet)
+{
+    CachedTxBalance bal;
+    bal.m_trusted = CachedTxIsTrusted(wallet, wtx, trusted_parents);
+    bal.m_confirmed = wtx.isConfirmed();
+    bal.m_pending = !bal.m_trusted && wallet.GetTxDepthInMainChain(wtx) == 0 && wtx.InMempool();
+    bal.m_mine_credit[0] = CachedTxGetAvailableCredit(wallet, wtx, ISMINE_SPENDABLE);
+    bal.m_watchonly_credit[0] = CachedTxGetAvailableCredit(wallet, wtx, ISMINE_WATCH_ONLY);
+    if (wallet.IsWalletFlagSet(WALLET_FLAG_AVOID_REUSE)) {
+        bal.m_mine_credit[1] = CachedTxGetAvailableCredit(wallet, wtx, ISMINE_SPENDABLE | ISMINE_USED);
+        bal.m_watchonly_credit[1] = CachedTxGetAvailableCredit(wallet, wtx, ISMINE_WATCH_ONLY | ISMINE_USED);
+    } else {
+        // Without avoid_reuse, outputs to used addresses are always counted.
+        bal.m_mine_credit[1] = bal.m_mine_credit[0];
+        bal.m_watchonly_credit[1] = bal.m_watchonly_credit[0];
     }
+    bal.m_mine_immature = CachedTxGetImmatureCredit(wallet, wtx, ISMINE_SPENDABLE);
+    bal.m_watchonly_immature = CachedTxGetImmatureCredit(wallet, wtx, ISMINE_WATCH_ONLY);
+    bal.m_height_dependent = wallet.IsTxImmatureCoinBase(wtx);
+    if (bal.m_trusted) bal.m_mine_names = TxGetLockedNameAmount(wallet, wtx);
+    return bal;
+}
+
+static void AccountTxBalance(const CWallet& wallet, const CWalletTx& wtx, std::set<Txid>& trusted_parents) EXCLUSIVE_LOCKS_REQUIRED(wallet.cs_wallet)
+{
+    WalletBalanceCache& cache = wallet.m_balance_cache;
+    wtx.m_cached_balance = ComputeTxBalance(wallet, wtx, trusted_parents);
+    cache.Add(*wtx.m_cached_balance, 1);
+    if (wtx.m_cached_balance->m_height_dependent) cache.m_height_dependent.insert(wtx.GetHash());
+}
+
+static Balance BalanceFromCache(const WalletBalanceCache& cache, bool include_unconfirmed, bool avoid_reuse)
+{
+    const int used{avoid_reuse ? 0 : 1};
+    Balance ret;
+    ret.m_mine_trusted = cache.m_mine_trusted_confirmed[used];
+    ret.m_watchonly_trusted = cache.m_watchonly_trusted_confirmed[used];
+    if (include_unconfirmed) {
+        ret.m_mine_trusted += cache.m_mine_trusted_unconfirmed[used];
+        ret.m_watchonly_trusted += cache.m_watchonly_trusted_unconfirmed[used];
+    }
+    ret.m_mine_untrusted_pending = cache.m_mine_untrusted_pending[used];
+    ret.m_watchonly_untrusted_pending = cache.m_watchonly_untrusted_pending[used];
+    ret.m_mine_immature = cache.m_mine_immature;
+    ret.m_watchonly_immature = cache.m_watchonly_immature;
+    ret.m_mine_names = cache.m_mine_names;
     return ret;
 }
 
+Balance GetBalance(const CWallet& wallet, const int min_depth, bool avoid_reuse)
+{
+    LOCK(wallet.cs_wallet);
+    std::set<Txid> trusted_parents;
+
+    if (min_depth > 1) {
+        // The running totals only distinguish confirmed from unconfirmed
+        // trusted credit, so deeper requirements need a full pass.
+        WalletBalanceCache totals;
+        for (const auto& [_, wtx] : wallet.mapWallet) {
+            CachedTxBalance bal{ComputeTxBalance(wallet, wtx, trusted_parents)};
+            // Treat shallow confirmations like unconfirmed credit, which is left out below.
+            if (wallet.GetTxDepthInMainChain(wtx) < min_depth) bal.m_confirmed = false;
+            totals.Add(bal, 1);
+        }
+        return BalanceFromCache(totals, /*include_unconfirmed=*/false, avoid_reuse);
+    }
+
+    WalletBalanceCache& cache = wallet.m_balance_cache;
+    if (!cache.m_valid) {
+        cache = WalletBalanceCache{};
+        for (const auto& [_, wtx] : wallet.mapWallet) {
+            AccountTxBalance(wallet, wtx, trusted_parents);
+        }
+        cache.m_valid = true;
+    } else {
+        for (const Txid& txid : cache.m_dirty) {
+            const auto it = wallet.mapWallet.find(txid);
+            if (it != wallet.mapWallet.end()) AccountTxBalance(wallet, it->second, trusted_parents);
+        }
+        cache.m_dirty.clear();
+    }
+    return BalanceFromCache(cache, /*include_unconfirmed=*/min_depth <= 0, avoid_reuse);
+}
+
 std::map<CTxDestination, CAmount> GetAddressBalances(const CWallet& wallet)
 {
     std::map<CTxDestination, CAmount> balances;
@@ -62,7 +62,13 @@ struct Balance {
     CAmount m_watchonly_trusted{0};
     CAmount m_watchonly_untrusted_pending{0};
     CAmount m_watchonly_immature{0};
+    CAmount m_mine_names{0};             //!< Coins locked in unspent, trusted name outputs
 };
+/**
+ * Returns the wallet's balance.  For min_depth of at most one this is answered
+ * from the running totals in CWallet::m_balance_cache, re-evaluating only the
+ * transactions that changed since the last call.
+ */
 Balance GetBalance(const CWallet& wallet, int min_depth = 0, bool avoid_reuse = true);
 
 std::map<CTxDestination, CAmount> GetAddressBalances(const CWallet& wallet);
@@ -406,7 +406,7 @@ RPCHelpMan importdescriptors()
         }
 
         if (scanned_time > lowest_timestamp) {
-            std::vector<UniValue> results = response.getValues();
+            UniValue::Values results = response.getValues();
             response.clear();
             response.setArray();
 
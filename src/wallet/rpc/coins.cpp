@@ -424,6 +424,7 @@ RPCHelpMan getbalances()
                     {RPCResult::Type::STR_AMOUNT, "untrusted_pending", "untrusted pending balance (outputs created by others that are in the mempool)"},
                     {RPCResult::Type::STR_AMOUNT, "immature", "balance from immature coinbase outputs"},
                     {RPCResult::Type::STR_AMOUNT, "used", /*optional=*/true, "(only present if avoid_reuse is set) balance from coins sent to addresses that were previously spent from (potentially privacy violating)"},
+                    {RPCResult::Type::STR_AMOUNT, "names", /*optional=*/true, "(only present if the wallet owns names) coins locked in name outputs"},
                 }},
                 RESULT_LAST_PROCESSED_BLOCK,
             }
@@ -456,6 +457,9 @@ RPCHelpMan getbalances()
             const auto full_bal = GetBalance(wallet, 0, false);
             balances_mine.pushKV("used", ValueFromAmount(full_bal.m_mine_trusted + full_bal.m_mine_untrusted_pending - bal.m_mine_trusted - bal.m_mine_untrusted_pending));
         }
+        if (bal.m_mine_names > 0) {
+            balances_mine.pushKV("names", ValueFromAmount(bal.m_mine_names));
+        }
         balances.pushKV("mine", std::move(balances_mine));
     }
     AppendLastProcessedBlock(balances, wallet);
@@ -64,7 +64,7 @@ static void InterpretFeeEstimationInstructions(const UniValue& conf_target, cons
     }
 }
 
-std::set<int> InterpretSubtractFeeFromOutputInstructions(const UniValue& sffo_instructions, const std::vector<std::string>& destinations)
+std::set<int> InterpretSubtractFeeFromOutputInstructions(const UniValue& sffo_instructions, std::span<const std::string> destinations)
 {
     std::set<int> sffo_set;
     if (sffo_instructions.isNull()) return sffo_set;
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 The Xaya developers
+// Distributed under the MIT software license, see the accompanying
+// file COPYING or http://www.opensource.org/licenses/mit-license.php.
+
+#ifndef BITCOIN_WALLET_SCRIPTSET_H
+#define BITCOIN_WALLET_SCRIPTSET_H
+
+#include <util/hasher.h>
+
+#include <bitset>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace wallet {
+/**
+ * Compact set of salted scriptPubKey hashes used to answer "not mine" quickly.
+ *
+ * Scripts are stored as 64-bit SipHash values in a flat open-addressing table
+ * with linear probing, so a lookup touches one or two cache lines instead of
+ * walking node-based maps. A bitmap of the script lengths present in the set
+ * rejects most foreign script types before any hashing is done.
+ *
+ * Lookups may return false positives (on a full hash collision), so a hit has
+ * to be confirmed against the authoritative script map. A miss is definitive.
+ * Scripts can only be added; the wallet never forgets its scriptPubKeys.
+ */
+class ScriptPubKeySet
+{
+public:
+    void Insert(std::span<const unsigned char> script)
+    {
+        if ((m_size + 1) * 2 > m_slots.size()) Grow();
+        if (InsertHash(Hash(script))) {
+            ++m_size;
+            m_lengths.set(LengthBucket(script.size()));
+        }
+    }
+
+    bool MayContain(std::span<const unsigned char> script) const
+    {
+        if (!m_lengths.test(LengthBucket(script.size()))) return false;
+        const uint64_t hash{Hash(script)};
+        const size_t mask{m_slots.size() - 1};
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            if (m_slots[i] == hash) return true;
+            if (m_slots[i] == EMPTY) return false;
+        }
+    }
+
+    size_t Size() const { return m_size; }
+
+private:
+    static constexpr uint64_t EMPTY{0};
+    //! Scripts at least this long share the last length bucket
+    static constexpr size_t MAX_LENGTH_BUCKET{127};
+
+    SaltedSipHasher m_hasher;
+    //! Power-of-two sized table, at most half full
+    std::vector<uint64_t> m_slots = std::vector<uint64_t>(16, EMPTY);
+    size_t m_size{0};
+    std::bitset<MAX_LENGTH_BUCKET + 1> m_lengths;
+
+    static size_t LengthBucket(size_t len) { return len < MAX_LENGTH_BUCKET ? len : MAX_LENGTH_BUCKET; }
+
+    uint64_t Hash(std::span<const unsigned char> script) const
+    {
+        const uint64_t hash{m_hasher(script)};
+        // reserve zero for empty slots
+        return hash == EMPTY ? 1 : hash;
+    }
+
+    bool InsertHash(uint64_t hash)
+    {
+        const size_t mask{m_slots.size() - 1};
+        for (size_t i = hash & mask;; i = (i + 1) & mask) {
+            if (m_slots[i] == hash) return false;
+            if (m_slots[i] == EMPTY) {
+                m_slots[i] = hash;
+                return true;
+            }
+        }
+    }
+
+    void Grow()
+    {
+        std::vector<uint64_t> old_slots(m_slots.size() * 2, EMPTY);
+        old_slots.swap(m_slots);
+        for (const uint64_t hash : old_slots) {
+            if (hash != EMPTY) InsertHash(hash);
+        }
+    }
+};
+} // namespace wallet
+
+#endif // BITCOIN_WALLET_SCRIPTSET_H
@@ -13,6 +13,7 @@
 #include <util/check.h>
 #include <util/fs_helpers.h>
 #include <util/strencodings.h>
+#include <util/thread.h>
 #include <util/translation.h>
 #include <wallet/db.h>
 
@@ -112,7 +113,8 @@ Mutex SQLiteDatabase::g_sqlite_mutex;
 int SQLiteDatabase::g_sqlite_count = 0;
 
 SQLiteDatabase::SQLiteDatabase(const fs::path& dir_path, const fs::path& file_path, const DatabaseOptions& options, bool mock)
-    : WalletDatabase(), m_mock(mock), m_dir_path(fs::PathToString(dir_path)), m_file_path(fs::PathToString(file_path)), m_write_semaphore(1), m_use_unsafe_sync(options.use_unsafe_sync)
+    : WalletDatabase(), m_mock(mock), m_dir_path(fs::PathToString(dir_path)), m_file_path(fs::PathToString(file_path)),
+      m_use_wal(options.use_wal), m_group_commit_window(options.group_commit_window), m_write_semaphore(1), m_use_unsafe_sync(options.use_unsafe_sync)
 {
     {
         LOCK(g_sqlite_mutex);
@@ -144,6 +146,10 @@ SQLiteDatabase::SQLiteDatabase(const fs::path& dir_path, const fs::path& file_pa
         Cleanup();
         throw;
     }
+
+    if (m_group_commit_window.count() > 0) {
+        m_group_commit_thread = std::thread(&util::TraceThread, "walletcommit", [this] { GroupCommitThread(); });
+    }
 }
 
 void SQLiteBatch::SetupSQLStatements()
@@ -156,6 +162,14 @@ void SQLiteBatch::SetupSQLStatements()
         {&m_delete_prefix_stmt, "DELETE FROM main WHERE instr(key, ?) = 1"},
     };
 
+    // Reuse the statements of an earlier batch if there are any
+    if (auto pooled{m_database.TakeStatements()}) {
+        assert(pooled->size() == statements.size());
+        for (size_t i = 0; i < statements.size(); ++i) {
+            *statements[i].first = (*pooled)[i];
+        }
+    }
+
     for (const auto& [stmt_prepared, stmt_text] : statements) {
         if (*stmt_prepared == nullptr) {
             int res = sqlite3_prepare_v2(m_database.m_db, stmt_text, -1, stmt_prepared, nullptr);
@@ -176,6 +190,12 @@ void SQLiteDatabase::Cleanup() noexcept
 {
     AssertLockNotHeld(g_sqlite_mutex);
 
+    if (m_group_commit_thread.joinable()) {
+        WITH_LOCK(m_group_mutex, m_group_stop = true);
+        m_group_cv.notify_all();
+        m_group_commit_thread.join();
+    }
+
     Close();
 
     LOCK(g_sqlite_mutex);
@@ -298,6 +318,16 @@ void SQLiteDatabase::Open()
         SetPragma(m_db, "synchronous", "OFF", "Failed to set synchronous mode to OFF");
     }
 
+    // In-memory databases always use an in-memory journal
+    if (!m_mock) {
+        // The journal mode is persistent, so set it explicitly either way
+        SetPragma(m_db, "journal_mode", m_use_wal ? "WAL" : "DELETE", "Failed to set the journal mode");
+        if (m_use_wal && !m_use_unsafe_sync) {
+            // With a write-ahead log, commits only need to sync at checkpoints
+            SetPragma(m_db, "synchronous", "NORMAL", "Failed to set synchronous mode to NORMAL");
+        }
+    }
+
     // Make the table for our key-value pairs
     // First check that the main table exists
     sqlite3_stmt* check_main_stmt{nullptr};
@@ -338,6 +368,8 @@ void SQLiteDatabase::Open()
 
 bool SQLiteDatabase::Rewrite(const char* skip)
 {
+    // VACUUM cannot run inside a transaction
+    if (!FlushGroupTxn()) return false;
     // Rewrite the database using the VACUUM command: https://sqlite.org/lang_vacuum.html
     int ret = sqlite3_exec(m_db, "VACUUM", nullptr, nullptr, nullptr);
     return ret == SQLITE_OK;
@@ -345,6 +377,7 @@ bool SQLiteDatabase::Rewrite(const char* skip)
 
 bool SQLiteDatabase::Backup(const std::string& dest) const
 {
+    if (!FlushGroupTxn()) return false;
     sqlite3* db_copy;
     int res = sqlite3_open(dest.c_str(), &db_copy);
     if (res != SQLITE_OK) {
@@ -372,6 +405,10 @@ bool SQLiteDatabase::Backup(const std::string& dest) const
 
 void SQLiteDatabase::Close()
 {
+    if (WITH_LOCK(m_group_mutex, return m_group_started.has_value())) {
+        FlushGroupTxn();
+    }
+    ClearStatementPool();
     int res = sqlite3_close(m_db);
     if (res != SQLITE_OK) {
         throw std::runtime_error(strprintf("SQLiteDatabase: Failed to close database: %s\n", sqlite3_errstr(res)));
@@ -385,6 +422,97 @@ bool SQLiteDatabase::HasActiveTxn()
     return m_db && sqlite3_get_autocommit(m_db) == 0;
 }
 
+std::optional<std::vector<sqlite3_stmt*>> SQLiteDatabase::TakeStatements()
+{
+    LOCK(m_statement_pool_mutex);
+    if (m_statement_pool.empty()) return std::nullopt;
+    std::vector<sqlite3_stmt*> statements{std::move(m_statement_pool.back())};
+    m_statement_pool.pop_back();
+    return statements;
+}
+
+void SQLiteDatabase::ReturnStatements(std::vector<sqlite3_stmt*> statements)
+{
+    LOCK(m_statement_pool_mutex);
+    m_statement_pool.push_back(std::move(statements));
+}
+
+void SQLiteDatabase::ClearStatementPool()
+{
+    LOCK(m_statement_pool_mutex);
+    for (const auto& statements : m_statement_pool) {
+        for (sqlite3_stmt* stmt : statements) {
+            int res = sqlite3_finalize(stmt);
+            if (res != SQLITE_OK) {
+                LogPrintf("SQLiteDatabase: Could not finalize pooled statement: %s\n", sqlite3_errstr(res));
+            }
+        }
+    }
+    m_statement_pool.clear();
+}
+
+bool SQLiteDatabase::JoinGroupTxn()
+{
+    if (m_group_commit_window.count() == 0) return true;
+    LOCK(m_group_mutex);
+    if (m_group_commit_failed) return false;
+    if (m_group_started) return true;
+    int res = sqlite3_exec(m_db, "BEGIN TRANSACTION", nullptr, nullptr, nullptr);
+    if (res != SQLITE_OK) {
+        // The write goes ahead in its own implicit transaction.
+        LogPrintf("SQLiteDatabase: Failed to begin group transaction: %s\n", sqlite3_errstr(res));
+        return true;
+    }
+    m_group_started = std::chrono::steady_clock::now();
+    m_group_cv.notify_all();
+    return true;
+}
+
+bool SQLiteDatabase::CommitGroupTxn() const
+{
+    LOCK(m_group_mutex);
+    if (!m_group_started) return !m_group_commit_failed;
+    m_group_started.reset();
+    m_group_cv.notify_all();
+    int res = sqlite3_exec(m_db, "COMMIT TRANSACTION", nullptr, nullptr, nullptr);
+    if (res != SQLITE_OK) {
+        LogPrintf("SQLiteDatabase: Failed to commit group transaction, recent writes are lost and further writes are refused: %s\n", sqlite3_errstr(res));
+        m_group_commit_failed = true;
+        // Leave the connection usable for further writes
+        if (sqlite3_get_autocommit(m_db) == 0) {
+            sqlite3_exec(m_db, "ROLLBACK TRANSACTION", nullptr, nullptr, nullptr);
+        }
+        return false;
+    }
+    return true;
+}
+
+bool SQLiteDatabase::FlushGroupTxn() const
+{
+    if (m_group_commit_window.count() == 0) return true;
+    m_write_semaphore.acquire();
+    const bool ret{CommitGroupTxn()};
+    m_write_semaphore.release();
+    return ret;
+}
+
+void SQLiteDatabase::GroupCommitThread()
+{
+    while (true) {
+        {
+            WAIT_LOCK(m_group_mutex, lock);
+            m_group_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_group_mutex) { return m_group_stop || m_group_started; });
+            if (m_group_stop) return;
+            // Wait for the window of the pending group to pass, unless
+            // somebody else commits it first.
+            const auto deadline{*m_group_started + m_group_commit_window};
+            const bool committed{m_group_cv.wait_until(lock, deadline, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_group_mutex) { return m_group_stop || !m_group_started; })};
+            if (committed) continue;
+        }
+        FlushGroupTxn();
+    }
+}
+
 int SQliteExecHandler::Exec(SQLiteDatabase& database, const std::string& statement)
 {
     return sqlite3_exec(database.m_db, statement.data(), nullptr, nullptr, nullptr);
@@ -422,7 +550,14 @@ void SQLiteBatch::Close()
         }
     }
 
-    // Free all of the prepared statements
+    // Hand the prepared statements back for reuse by later batches, unless
+    // the connection they belong to is about to be replaced
+    if (!force_conn_refresh && m_read_stmt) {
+        m_database.ReturnStatements({m_read_stmt, m_insert_stmt, m_overwrite_stmt, m_delete_stmt, m_delete_prefix_stmt});
+        m_read_stmt = m_insert_stmt = m_overwrite_stmt = m_delete_stmt = m_delete_prefix_stmt = nullptr;
+    }
+
+    // Free all of the remaining prepared statements
     const std::vector<std::pair<sqlite3_stmt**, const char*>> statements{
         {&m_read_stmt, "read"},
         {&m_insert_stmt, "insert"},
@@ -498,7 +633,10 @@ bool SQLiteBatch::WriteKey(DataStream&& key, DataStream&& value, bool overwrite)
     if (!BindBlobToStatement(stmt, 2, value, "value")) return false;
 
     // Acquire semaphore if not previously acquired when creating a transaction.
-    if (!m_txn) m_database.m_write_semaphore.acquire();
+    if (!m_txn && !BeginImplicitWrite()) {
+        sqlite3_clear_bindings(stmt);
+        return false;
+    }
 
     // Execute
     int res = sqlite3_step(stmt);
@@ -522,7 +660,10 @@ bool SQLiteBatch::ExecStatement(sqlite3_stmt* stmt, std::span<const std::byte> b
     if (!BindBlobToStatement(stmt, 1, blob, "key")) return false;
 
     // Acquire semaphore if not previously acquired when creating a transaction.
-    if (!m_txn) m_database.m_write_semaphore.acquire();
+    if (!m_txn && !BeginImplicitWrite()) {
+        sqlite3_clear_bindings(stmt);
+        return false;
+    }
 
     // Execute
     int res = sqlite3_step(stmt);
@@ -537,6 +678,16 @@ bool SQLiteBatch::ExecStatement(sqlite3_stmt* stmt, std::span<const std::byte> b
     return res == SQLITE_DONE;
 }
 
+bool SQLiteBatch::BeginImplicitWrite()
+{
+    m_database.m_write_semaphore.acquire();
+    if (!m_database.JoinGroupTxn()) {
+        m_database.m_write_semaphore.release();
+        return false;
+    }
+    return true;
+}
+
 bool SQLiteBatch::EraseKey(DataStream&& key)
 {
     return ExecStatement(m_delete_stmt, key);
@@ -652,6 +803,11 @@ bool SQLiteBatch::TxnBegin()
 {
     if (!m_database.m_db || m_txn) return false;
     m_database.m_write_semaphore.acquire();
+    // Writes pending for group commit must not become part of this transaction
+    if (!m_database.CommitGroupTxn()) {
+        m_database.m_write_semaphore.release();
+        return false;
+    }
     Assert(!m_database.HasActiveTxn());
     int res = Assert(m_exec_handler)->Exec(m_database, "BEGIN TRANSACTION");
     if (res != SQLITE_OK) {
@@ -8,7 +8,12 @@
 #include <sync.h>
 #include <wallet/db.h>
 
+#include <chrono>
+#include <condition_variable>
+#include <optional>
 #include <semaphore>
+#include <thread>
+#include <vector>
 
 struct bilingual_str;
 
@@ -73,6 +78,8 @@ private:
     bool m_txn{false};
 
     void SetupSQLStatements();
+    /** Acquire write access for a statement outside of an explicit transaction. Returns false if writes are refused. */
+    [[nodiscard]] bool BeginImplicitWrite();
     bool ExecStatement(sqlite3_stmt* stmt, std::span<const std::byte> blob);
 
     bool ReadKey(DataStream&& key, DataStream& value) override;
@@ -119,6 +126,37 @@ private:
 
     void Cleanup() noexcept EXCLUSIVE_LOCKS_REQUIRED(!g_sqlite_mutex);
 
+    const bool m_use_wal;
+
+    /**
+     * Prepared statements handed back by closed batches, so that new batches
+     * do not have to prepare them again. Each entry holds one batch's
+     * statements in the order used by SQLiteBatch::SetupSQLStatements.
+     */
+    Mutex m_statement_pool_mutex;
+    std::vector<std::vector<sqlite3_stmt*>> m_statement_pool GUARDED_BY(m_statement_pool_mutex);
+    void ClearStatementPool() EXCLUSIVE_LOCKS_REQUIRED(!m_statement_pool_mutex);
+
+    /**
+     * Group commit: writes made outside of explicit transactions are collected
+     * in one database transaction which is committed once
+     * m_group_commit_window has passed since its first write, or earlier if
+     * an explicit transaction, a backup or closing the database needs it.
+     * m_group_commit_thread enforces the deadline.
+     */
+    const std::chrono::milliseconds m_group_commit_window;
+    mutable Mutex m_group_mutex;
+    mutable std::condition_variable m_group_cv;
+    //! Start of the pending group transaction, if one is open
+    mutable std::optional<std::chrono::steady_clock::time_point> m_group_started GUARDED_BY(m_group_mutex);
+    //! Set when a group transaction failed to commit, losing writes that were
+    //! reported as successful. All further writes fail, as the wallet's view
+    //! no longer matches the database.
+    mutable bool m_group_commit_failed GUARDED_BY(m_group_mutex){false};
+    bool m_group_stop GUARDED_BY(m_group_mutex){false};
+    std::thread m_group_commit_thread;
+    void GroupCommitThread() EXCLUSIVE_LOCKS_REQUIRED(!m_group_mutex);
+
 public:
     SQLiteDatabase() = delete;
 
@@ -129,7 +167,7 @@ public:
 
     // Batches must acquire this semaphore on writing, and release when done writing.
     // This ensures that only one batch is modifying the database at a time.
-    std::binary_semaphore m_write_semaphore;
+    mutable std::binary_semaphore m_write_semaphore;
 
     bool Verify(bilingual_str& error);
 
@@ -155,6 +193,18 @@ public:
     /** Return true if there is an on-going txn in this connection */
     bool HasActiveTxn();
 
+    /** Take a set of prepared statements returned by an earlier batch, if any. */
+    std::optional<std::vector<sqlite3_stmt*>> TakeStatements() EXCLUSIVE_LOCKS_REQUIRED(!m_statement_pool_mutex);
+    /** Hand a batch's prepared statements back for reuse. */
+    void ReturnStatements(std::vector<sqlite3_stmt*> statements) EXCLUSIVE_LOCKS_REQUIRED(!m_statement_pool_mutex);
+
+    /** Make sure a group transaction is open for an implicit write. The caller must hold m_write_semaphore. Returns false if a group transaction failed to commit earlier. */
+    [[nodiscard]] bool JoinGroupTxn() EXCLUSIVE_LOCKS_REQUIRED(!m_group_mutex);
+    /** Commit the pending group transaction, if any. The caller must hold m_write_semaphore. Returns false if this or an earlier group transaction failed to commit. */
+    bool CommitGroupTxn() const EXCLUSIVE_LOCKS_REQUIRED(!m_group_mutex);
+    /** Commit the pending group transaction, if any, acquiring m_write_semaphore. */
+    bool FlushGroupTxn() const EXCLUSIVE_LOCKS_REQUIRED(!m_group_mutex);
+
     sqlite3* m_db{nullptr};
     bool m_use_unsafe_sync;
 };
@@ -7,12 +7,16 @@
 #include <test/util/setup_common.h>
 #include <util/check.h>
 #include <util/fs.h>
+#include <util/time.h>
 #include <util/translation.h>
 #include <wallet/sqlite.h>
 #include <wallet/migrate.h>
 #include <wallet/test/util.h>
 #include <wallet/walletutil.h>
 
+#include <sqlite3.h>
+
+#include <chrono>
 #include <cstddef>
 #include <fstream>
 #include <memory>
@@ -297,5 +301,93 @@ BOOST_AUTO_TEST_CASE(concurrent_txn_dont_interfere)
     BOOST_CHECK_EQUAL(read_value, value2);
 }
 
+BOOST_AUTO_TEST_CASE(group_commit)
+{
+    DatabaseOptions options;
+    options.use_wal = true;
+    options.group_commit_window = std::chrono::milliseconds{50};
+    DatabaseStatus status;
+    bilingual_str error;
+    std::unique_ptr<SQLiteDatabase> database = MakeSQLiteDatabase(m_path_root / "sqlite", options, status, error);
+    BOOST_REQUIRE(database);
+
+    const std::string key = "key";
+    const std::string key2 = "key2";
+    const std::string key3 = "key3";
+    const std::string value = "value";
+
+    // Writes outside of explicit transactions join a pending group, which
+    // other batches can already read from.
+    std::unique_ptr<DatabaseBatch> batch = database->MakeBatch();
+    BOOST_CHECK(batch->Write(key, value));
+    BOOST_CHECK(database->HasActiveTxn());
+    std::unique_ptr<DatabaseBatch> batch2 = database->MakeBatch();
+    BOOST_CHECK(batch2->Exists(key));
+
+    // An explicit transaction commits the pending group before it begins, so
+    // aborting it does not lose the group's writes.
+    BOOST_CHECK(batch2->TxnBegin());
+    BOOST_CHECK(batch2->Write(key2, value));
+    BOOST_CHECK(batch2->TxnAbort());
+    BOOST_CHECK(batch->Exists(key));
+    BOOST_CHECK(!batch->Exists(key2));
+
+    // Once the window has passed, the group is committed in the background.
+    BOOST_CHECK(batch->Write(key3, value));
+    BOOST_CHECK(database->HasActiveTxn());
+    for (int i = 0; i < 500 && database->HasActiveTxn(); ++i) {
+        UninterruptibleSleep(std::chrono::milliseconds{10});
+    }
+    BOOST_CHECK(!database->HasActiveTxn());
+
+    // Data survives reopening the database with the default journal.
+    BOOST_CHECK(batch->Write(key2, value));
+    batch.reset();
+    batch2.reset();
+    database.reset();
+    database = MakeSQLiteDatabase(m_path_root / "sqlite", DatabaseOptions{}, status, error);
+    BOOST_REQUIRE(database);
+    batch = database->MakeBatch();
+    BOOST_CHECK(batch->Exists(key));
+    BOOST_CHECK(batch->Exists(key2));
+    BOOST_CHECK(batch->Exists(key3));
+}
+
+BOOST_AUTO_TEST_CASE(group_commit_failure)
+{
+    DatabaseOptions options;
+    options.use_wal = true;
+    options.group_commit_window = std::chrono::hours{1};
+    DatabaseStatus status;
+    bilingual_str error;
+    std::unique_ptr<SQLiteDatabase> database = MakeSQLiteDatabase(m_path_root / "sqlite", options, status, error);
+    BOOST_REQUIRE(database);
+
+    // A deferred foreign key violation makes the COMMIT of the group fail
+    SQliteExecHandler exec;
+    BOOST_REQUIRE_EQUAL(exec.Exec(*database, "PRAGMA foreign_keys = ON"), SQLITE_OK);
+    BOOST_REQUIRE_EQUAL(exec.Exec(*database, "CREATE TABLE parent (id INTEGER PRIMARY KEY)"), SQLITE_OK);
+    BOOST_REQUIRE_EQUAL(exec.Exec(*database, "CREATE TABLE child (parent_id INTEGER REFERENCES parent(id) DEFERRABLE INITIALLY DEFERRED)"), SQLITE_OK);
+
+    const std::string key = "key";
+    const std::string key2 = "key2";
+    const std::string value = "value";
+    std::unique_ptr<DatabaseBatch> batch = database->MakeBatch();
+    BOOST_CHECK(batch->Write(key, value));
+    BOOST_REQUIRE(database->HasActiveTxn());
+    BOOST_REQUIRE_EQUAL(exec.Exec(*database, "INSERT INTO child VALUES (1)"), SQLITE_OK);
+
+    // The write above is lost, which is reported to the next transaction,
+    // write and flush instead of letting the wallet continue as if it was
+    // stored.
+    BOOST_CHECK(!batch->TxnBegin());
+    BOOST_CHECK(!database->HasActiveTxn());
+    BOOST_CHECK(!batch->Exists(key));
+    BOOST_CHECK(!batch->Write(key2, value));
+    BOOST_CHECK(!batch->Erase(key2));
+    BOOST_CHECK(!batch->TxnBegin());
+    BOOST_CHECK(!database->Backup(fs::PathToString(m_path_root / "backup.dat")));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace wallet
@@ -5,10 +5,12 @@
 #include <key.h>
 #include <key_io.h>
 #include <node/context.h>
+#include <script/names.h>
 #include <script/script.h>
 #include <script/solver.h>
 #include <script/signingprovider.h>
 #include <test/util/setup_common.h>
+#include <wallet/scriptset.h>
 #include <wallet/types.h>
 #include <wallet/wallet.h>
 #include <wallet/test/util.h>
@@ -282,5 +284,45 @@ BOOST_AUTO_TEST_CASE(ismine_standard)
     }
 }
 
+BOOST_AUTO_TEST_CASE(script_pubkey_set)
+{
+    ScriptPubKeySet set;
+    std::vector<CScript> scripts;
+    for (int i = 0; i < 1000; ++i) {
+        scripts.push_back(GetScriptForDestination(PKHash(GenerateRandomKey().GetPubKey())));
+        set.Insert(scripts.back());
+    }
+    set.Insert(scripts.front());
+    BOOST_CHECK_EQUAL(set.Size(), scripts.size());
+    for (const auto& script : scripts) BOOST_CHECK(set.MayContain(script));
+
+    // a different length is rejected by the prefilter, the same length by the table
+    BOOST_CHECK(!set.MayContain(GetScriptForDestination(WitnessV0KeyHash(GenerateRandomKey().GetPubKey()))));
+    BOOST_CHECK(!set.MayContain(GetScriptForDestination(PKHash(GenerateRandomKey().GetPubKey()))));
+    BOOST_CHECK(!set.MayContain(CScript{}));
+}
+
+BOOST_AUTO_TEST_CASE(ismine_wallet_names)
+{
+    CWallet wallet(m_node.chain.get(), "", CreateMockableWalletDatabase());
+    const CKey key{GenerateRandomKey()};
+    CreateDescriptor(wallet, "wpkh(" + EncodeSecret(key) + ")", true);
+    const CScript mine{GetScriptForDestination(WitnessV0KeyHash(key.GetPubKey()))};
+    const CScript other{GetScriptForDestination(WitnessV0KeyHash(GenerateRandomKey().GetPubKey()))};
+    const valtype name{'p', '/', 'x'};
+    const valtype value{'{', '}'};
+
+    LOCK(wallet.cs_wallet);
+    BOOST_CHECK_EQUAL(wallet.IsMine(mine), ISMINE_SPENDABLE);
+    BOOST_CHECK_EQUAL(wallet.IsMine(CNameScript::buildNameRegister(mine, name, value)), ISMINE_SPENDABLE);
+    BOOST_CHECK_EQUAL(wallet.IsMine(CNameScript::buildNameUpdate(mine, name, value)), ISMINE_SPENDABLE);
+    BOOST_CHECK_EQUAL(wallet.IsMine(other), ISMINE_NO);
+    BOOST_CHECK_EQUAL(wallet.IsMine(CNameScript::buildNameUpdate(other, name, value)), ISMINE_NO);
+
+    // a name prefix with the wrong number of arguments is not stripped
+    const CScript bad_prefix{CScript() << OP_NAME_UPDATE << name << OP_DROP};
+    BOOST_CHECK_EQUAL(wallet.IsMine(CNameScript::AddNamePrefix(mine, bad_prefix)), ISMINE_NO);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 } // namespace wallet
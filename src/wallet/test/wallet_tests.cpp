@@ -10,11 +10,14 @@
 #include <vector>
 
 #include <addresstype.h>
+#include <index/blockfilterindex.h>
 #include <interfaces/chain.h>
+#include <key.h>
 #include <key_io.h>
 #include <node/blockstorage.h>
 #include <policy/policy.h>
 #include <rpc/server.h>
+#include <script/descriptor.h>
 #include <script/solver.h>
 #include <test/util/logging.h>
 #include <test/util/random.h>
@@ -211,6 +214,87 @@ BOOST_FIXTURE_TEST_CASE(scan_for_wallet_transactions, TestChain100Setup)
     }
 }
 
+BOOST_FIXTURE_TEST_CASE(scan_for_wallet_transactions_prefetch, TestChain100Setup)
+{
+    CExtKey master;
+    const auto seed{m_rng.randbytes<std::byte>(32)};
+    master.SetSeed(seed);
+    const std::string desc_str{"wpkh(" + EncodeExtKey(master) + "/0/*)"};
+    FlatSigningProvider provider;
+    std::string error;
+    const auto descs{Parse(desc_str, provider, error, /*require_checksum=*/false)};
+    BOOST_REQUIRE_EQUAL(descs.size(), 1U);
+
+    // Pay to every fourth address of the descriptor, so that the wallet only
+    // finds all payments if it tops up its keypool while scanning
+    constexpr int64_t KEYPOOL_SIZE{5};
+    int payments{0};
+    for (int i = 0; i < 150; ++i) {
+        CScript script{GetScriptForRawPubKey(coinbaseKey.GetPubKey())};
+        if (i % 3 == 0) {
+            std::vector<CScript> scripts;
+            FlatSigningProvider out;
+            BOOST_REQUIRE(descs[0]->Expand(payments++ * 4, provider, scripts, out));
+            script = scripts.at(0);
+        }
+        CreateAndProcessBlock({}, script);
+    }
+    const CBlockIndex* tip{WITH_LOCK(Assert(m_node.chainman)->GetMutex(), return m_node.chainman->ActiveChain().Tip())};
+
+    // Return the transactions found by a rescan from genesis, with their heights
+    const auto rescan{[&](bool prefetch) {
+        CWallet wallet(m_node.chain.get(), "", CreateMockableWalletDatabase());
+        wallet.m_keypool_size = KEYPOOL_SIZE;
+        {
+            LOCK(wallet.cs_wallet);
+            wallet.SetWalletFlag(WALLET_FLAG_DESCRIPTORS);
+            wallet.SetLastBlockProcessed(tip->nHeight, tip->GetBlockHash());
+            FlatSigningProvider keys;
+            auto parsed{Parse(desc_str, keys, error, /*require_checksum=*/false)};
+            WalletDescriptor w_desc{std::move(parsed.at(0)), 0, 0, 0, 0};
+            BOOST_REQUIRE(wallet.AddWalletDescriptor(w_desc, keys, "", false));
+        }
+        WalletRescanReserver reserver(wallet);
+        reserver.reserve();
+        if (prefetch) {
+            const CWallet::ScanResult result{wallet.ScanForWalletTransactions(m_node.chainman->GetParams().GenesisBlock().GetHash(), 0, /*max_height=*/{}, reserver, /*fUpdate=*/false, /*save_progress=*/false)};
+            BOOST_CHECK_EQUAL(result.status, CWallet::ScanResult::SUCCESS);
+            BOOST_CHECK_EQUAL(*result.last_scanned_height, tip->nHeight);
+        } else {
+            // Ranges of fewer than 100 blocks are scanned without prefetching
+            for (int start = 0; start <= tip->nHeight; start += 50) {
+                const CWallet::ScanResult result{wallet.ScanForWalletTransactions(tip->GetAncestor(start)->GetBlockHash(), start, std::min(start + 49, tip->nHeight), reserver, /*fUpdate=*/false, /*save_progress=*/false)};
+                BOOST_CHECK_EQUAL(result.status, CWallet::ScanResult::SUCCESS);
+            }
+        }
+        LOCK(wallet.cs_wallet);
+        std::set<std::pair<Txid, int>> found;
+        for (const auto& [txid, wtx] : wallet.mapWallet) {
+            found.emplace(txid, wtx.state<TxStateConfirmed>()->confirmed_block_height);
+        }
+        return found;
+    }};
+
+    // Without a block filter index, all blocks are read ahead
+    const auto found{rescan(/*prefetch=*/true)};
+    BOOST_CHECK_EQUAL(found.size(), static_cast<size_t>(payments));
+    BOOST_CHECK(found == rescan(/*prefetch=*/false));
+
+    // With one, the filters are checked ahead of the scan as well, and
+    // checked again after each keypool top-up
+    BOOST_REQUIRE(InitBlockFilterIndex([&] { return interfaces::MakeChain(m_node); }, BlockFilterType::BASIC, 1 << 20, /*f_memory=*/true));
+    BlockFilterIndex& filter_index{*GetBlockFilterIndex(BlockFilterType::BASIC)};
+    BOOST_REQUIRE(filter_index.Init());
+    filter_index.Sync();
+    {
+        ASSERT_DEBUG_LOG("fast variant using block filters");
+        BOOST_CHECK(rescan(/*prefetch=*/true) == found);
+    }
+    BOOST_CHECK(rescan(/*prefetch=*/false) == found);
+    filter_index.Stop();
+    DestroyAllBlockFilterIndexes();
+}
+
 // This test verifies that wallet settings can be added and removed
 // concurrently, ensuring no race conditions occur during either process.
 BOOST_FIXTURE_TEST_CASE(write_wallet_settings_concurrently, TestingSetup)
@@ -476,6 +560,51 @@ BOOST_FIXTURE_TEST_CASE(ListCoinsTest, ListCoinsTestingSetup)
     BOOST_CHECK_EQUAL(list.begin()->second.size(), 2U);
 }
 
+BOOST_FIXTURE_TEST_CASE(balance_totals_incremental, ListCoinsTestingSetup)
+{
+    auto handler = m_node.chain->handleNotifications({wallet.get(), [](CWallet*) {}});
+    wallet->SetBroadcastTransactions(true);
+
+    // Balances answered from the running totals must match a full rebuild.
+    const auto check_balance = [&](int min_depth) {
+        LOCK(wallet->cs_wallet);
+        const Balance incremental{GetBalance(*wallet, min_depth)};
+        wallet->MarkDirty();
+        const Balance rebuilt{GetBalance(*wallet, min_depth)};
+        BOOST_CHECK_EQUAL(incremental.m_mine_trusted, rebuilt.m_mine_trusted);
+        BOOST_CHECK_EQUAL(incremental.m_mine_untrusted_pending, rebuilt.m_mine_untrusted_pending);
+        BOOST_CHECK_EQUAL(incremental.m_mine_immature, rebuilt.m_mine_immature);
+        BOOST_CHECK_EQUAL(incremental.m_mine_names, rebuilt.m_mine_names);
+        return incremental;
+    };
+
+    const Balance initial{check_balance(0)};
+    BOOST_CHECK_EQUAL(initial.m_mine_trusted, 50 * COIN);
+
+    // Spending leaves trusted change in the mempool.
+    CTransactionRef tx;
+    {
+        CCoinControl coin_control;
+        coin_control.m_feerate = CFeeRate{COIN / 100};
+        auto res = CreateTransaction(*wallet, {CRecipient{PKHash{GenerateRandomKey().GetPubKey()}, 1 * COIN, /*subtract_fee=*/false}}, nullptr, /*change_pos=*/std::nullopt, coin_control);
+        BOOST_REQUIRE(res);
+        tx = res->tx;
+    }
+    wallet->CommitTransaction(tx, {}, {});
+    const Balance pending{check_balance(0)};
+    BOOST_CHECK(pending.m_mine_trusted < 49 * COIN);
+    BOOST_CHECK(pending.m_mine_trusted > 48 * COIN);
+    BOOST_CHECK_EQUAL(check_balance(1).m_mine_trusted, 0);
+
+    // Confirming it matures another coinbase and adds a new immature one.
+    CreateAndProcessBlock({CMutableTransaction(*tx)}, GetScriptForRawPubKey(coinbaseKey.GetPubKey()));
+    m_node.validation_signals->SyncWithValidationInterfaceQueue();
+    const Balance confirmed{check_balance(1)};
+    BOOST_CHECK_EQUAL(confirmed.m_mine_trusted, pending.m_mine_trusted + 50 * COIN);
+    BOOST_CHECK_EQUAL(confirmed.m_mine_immature, initial.m_mine_immature);
+    check_balance(0);
+}
+
 void TestCoinsResult(ListCoinsTest& context, OutputType out_type, CAmount amount,
                      std::map<OutputType, size_t>& expected_coins_sizes)
 {
@@ -18,6 +18,7 @@
 #include <bitset>
 #include <cstdint>
 #include <map>
+#include <optional>
 #include <utility>
 #include <variant>
 #include <vector>
@@ -145,6 +146,27 @@ struct CachableAmount
     }
 };
 
+/**
+ * Contribution of a single wallet transaction to the running balance totals
+ * that CWallet keeps for GetBalance().  Credits are indexed by whether
+ * outputs to previously spent-from addresses (ISMINE_USED) are included.
+ */
+struct CachedTxBalance
+{
+    CAmount m_mine_credit[2]{0, 0};
+    CAmount m_watchonly_credit[2]{0, 0};
+    CAmount m_mine_immature{0};
+    CAmount m_watchonly_immature{0};
+    //! Coins locked in unspent name outputs of this transaction
+    CAmount m_mine_names{0};
+    bool m_trusted{false};
+    bool m_confirmed{false};
+    //! Untrusted, but in the mempool
+    bool m_pending{false};
+    //! Depends on the chain height (immature coinbase) and must be
+    //! re-evaluated whenever a block is connected
+    bool m_height_dependent{false};
+};
 
 typedef std::map<std::string, std::string> mapValue_t;
 
@@ -229,6 +251,12 @@ public:
     mutable bool m_is_cache_empty{true};
     mutable bool fChangeCached;
     mutable CAmount nChangeCached;
+    /**
+     * Contribution of this transaction to the wallet's running balance
+     * totals. Only set while it is accounted for in those totals, see
+     * CWallet::MarkBalanceDirty.
+     */
+    mutable std::optional<CachedTxBalance> m_cached_balance;
 
     CWalletTx(CTransactionRef tx, const TxState& state) : tx(std::move(tx)), m_state(state)
     {
@@ -59,6 +59,7 @@
 #include <util/moneystr.h>
 #include <util/result.h>
 #include <util/string.h>
+#include <util/thread.h>
 #include <util/time.h>
 #include <util/translation.h>
 #include <wallet/coincontrol.h>
@@ -75,6 +76,7 @@
 #include <algorithm>
 #include <cassert>
 #include <condition_variable>
+#include <deque>
 #include <exception>
 #include <optional>
 #include <stdexcept>
@@ -308,7 +310,7 @@ std::shared_ptr<CWallet> LoadWalletInternal(WalletContext& context, const std::s
 class FastWalletRescanFilter
 {
 public:
-    FastWalletRescanFilter(const CWallet& wallet) : m_wallet(wallet)
+    FastWalletRescanFilter(const CWallet& wallet) : m_wallet(wallet), m_filter_set(std::make_shared<GCSFilter::ElementSet>())
     {
         // create initial filter with scripts from all ScriptPubKeyMans
         for (auto spkm : m_wallet.GetAllScriptPubKeyMans()) {
@@ -322,24 +324,27 @@ public:
         }
     }
 
-    void UpdateIfNeeded()
+    /** Returns true if the filter set was extended. */
+    bool UpdateIfNeeded()
     {
+        bool updated{false};
         // repopulate filter with new scripts if top-up has happened since last iteration
         for (const auto& [desc_spkm_id, last_range_end] : m_last_range_ends) {
             auto desc_spkm{dynamic_cast<DescriptorScriptPubKeyMan*>(m_wallet.GetScriptPubKeyMan(desc_spkm_id))};
             assert(desc_spkm != nullptr);
             int32_t current_range_end{desc_spkm->GetEndRange()};
             if (current_range_end > last_range_end) {
+                // the previous set may still be in use by prefetch threads, so extend a copy
+                if (!updated) m_filter_set = std::make_shared<GCSFilter::ElementSet>(*m_filter_set);
                 AddScriptPubKeys(desc_spkm, last_range_end);
                 m_last_range_ends.at(desc_spkm->GetID()) = current_range_end;
+                updated = true;
             }
         }
+        return updated;
     }
 
-    std::optional<bool> MatchesBlock(const uint256& block_hash) const
-    {
-        return m_wallet.chain().blockFilterMatchesAny(BlockFilterType::BASIC, block_hash, m_filter_set);
-    }
+    std::shared_ptr<const GCSFilter::ElementSet> GetFilterSet() const { return m_filter_set; }
 
 private:
     const CWallet& m_wallet;
@@ -350,12 +355,196 @@ private:
       * take possible keypool top-ups into account.
       */
     std::map<uint256, int32_t> m_last_range_ends;
-    GCSFilter::ElementSet m_filter_set;
+    std::shared_ptr<GCSFilter::ElementSet> m_filter_set;
 
     void AddScriptPubKeys(const DescriptorScriptPubKeyMan* desc_spkm, int32_t last_range_end = 0)
     {
         for (const auto& script_pub_key : desc_spkm->GetScriptPubKeys(last_range_end)) {
-            m_filter_set.emplace(script_pub_key.begin(), script_pub_key.end());
+            m_filter_set->emplace(script_pub_key.begin(), script_pub_key.end());
+        }
+    }
+};
+
+/** Maximum number of worker threads used by a rescan */
+static constexpr int MAX_RESCAN_THREADS{8};
+/** How many blocks ahead of the scan block filters are checked */
+static constexpr size_t RESCAN_FILTER_LOOKAHEAD{1000};
+/** How many blocks ahead of the scan block data is read */
+static constexpr size_t RESCAN_BLOCK_LOOKAHEAD{16};
+/** Rescans of fewer blocks check filters and read blocks on the scanning thread */
+static constexpr int RESCAN_PREFETCH_MIN_BLOCKS{100};
+
+/**
+ * Checks block filters and reads blocks ahead of a rescan on worker threads.
+ *
+ * Results are handed back strictly in chain order, so the wallet still syncs
+ * transactions block by block on the scanning thread. Block data is only read
+ * for blocks whose filter matched (or for all blocks if there is no filter
+ * set), and only for a small window ahead of the scan to bound memory use.
+ */
+class RescanPrefetcher
+{
+public:
+    struct Result {
+        //! Outcome of the filter check, unset if there is no filter set or the filter was not found
+        std::optional<bool> filter_match;
+        //! Block data, null if it was not read (filter did not match) or reading failed
+        CBlock block;
+    };
+
+    RescanPrefetcher(interfaces::Chain& chain, std::shared_ptr<const GCSFilter::ElementSet> filter_set)
+        : m_chain(chain), m_filter_set(std::move(filter_set))
+    {
+        const int threads{std::clamp(GetNumCores(), 1, MAX_RESCAN_THREADS)};
+        for (int n = 0; n < threads; ++n) {
+            m_workers.emplace_back(&util::TraceThread, strprintf("rescan.%i", n), [this] { ThreadWorker(); });
+        }
+    }
+
+    ~RescanPrefetcher()
+    {
+        WITH_LOCK(m_mutex, m_stop = true);
+        m_work_cv.notify_all();
+        for (auto& worker : m_workers) worker.join();
+    }
+
+    /** Replace the filter set, discarding all results computed with the previous one. */
+    void SetFilterSet(std::shared_ptr<const GCSFilter::ElementSet> filter_set) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        LOCK(m_mutex);
+        m_filter_set = std::move(filter_set);
+        m_jobs.clear();
+        m_next_unchecked = 0;
+    }
+
+    /**
+     * Return the result for the given block, waiting for it if necessary, and
+     * queue further blocks up to the lookahead limit. Queued blocks are the
+     * ancestors of end_hash following block_height.
+     */
+    Result Next(const uint256& block_hash, int block_height, const uint256& end_hash) EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        std::vector<uint256> new_hashes;
+        size_t queued;
+        int next_height;
+        {
+            LOCK(m_mutex);
+            if (m_jobs.empty() || m_jobs.front()->hash != block_hash) {
+                // first call, or the scan moved to a block other than the one queued (e.g. after a reorg)
+                m_jobs.clear();
+                m_next_unchecked = 0;
+                m_next_height = block_height + 1;
+                new_hashes.push_back(block_hash);
+            }
+            queued = m_jobs.size();
+            next_height = m_next_height;
+        }
+
+        // Look up the hashes to queue without holding m_mutex, so workers can keep going
+        for (; queued + new_hashes.size() < RESCAN_FILTER_LOOKAHEAD; ++next_height) {
+            uint256 hash;
+            if (!m_chain.findAncestorByHeight(end_hash, next_height, interfaces::FoundBlock().hash(hash))) break;
+            new_hashes.push_back(hash);
+        }
+
+        WAIT_LOCK(m_mutex, lock);
+        for (const uint256& hash : new_hashes) {
+            auto job{std::make_shared<Job>()};
+            job->hash = hash;
+            if (!m_filter_set) {
+                job->state = Job::State::CHECKED;
+                ++m_next_unchecked;
+            }
+            m_jobs.push_back(std::move(job));
+        }
+        if (!new_hashes.empty()) {
+            m_next_height = next_height;
+            m_work_cv.notify_all();
+        }
+
+        const std::shared_ptr<Job> job{m_jobs.front()};
+        m_done_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return job->state == Job::State::DONE; });
+        m_jobs.pop_front();
+        if (m_next_unchecked > 0) --m_next_unchecked;
+        // the block read window moved forward
+        m_work_cv.notify_all();
+        return std::move(job->result);
+    }
+
+    /** Check the filter of a block and read it if needed on the calling thread. */
+    static Result Fetch(interfaces::Chain& chain, const uint256& block_hash, const GCSFilter::ElementSet* filter_set)
+    {
+        Result result;
+        if (filter_set) result.filter_match = chain.blockFilterMatchesAny(BlockFilterType::BASIC, block_hash, *filter_set);
+        if (result.filter_match != false) chain.findBlock(block_hash, interfaces::FoundBlock().data(result.block));
+        return result;
+    }
+
+private:
+    struct Job {
+        enum class State { UNCHECKED, CHECKING, CHECKED, READING, DONE };
+        uint256 hash;
+        State state{State::UNCHECKED};
+        //! Written by the worker that claimed the job, read once it is DONE
+        Result result;
+    };
+
+    interfaces::Chain& m_chain;
+    Mutex m_mutex;
+    std::condition_variable m_work_cv;
+    std::condition_variable m_done_cv;
+    std::shared_ptr<const GCSFilter::ElementSet> m_filter_set GUARDED_BY(m_mutex);
+    //! Blocks queued for the scan, in chain order
+    std::deque<std::shared_ptr<Job>> m_jobs GUARDED_BY(m_mutex);
+    //! Index in m_jobs of the first job whose filter was not checked yet
+    size_t m_next_unchecked GUARDED_BY(m_mutex){0};
+    //! Height of the next block to queue
+    int m_next_height GUARDED_BY(m_mutex){0};
+    bool m_stop GUARDED_BY(m_mutex){false};
+    std::vector<std::thread> m_workers;
+
+    /** Claim the next job; reading blocks close to the scan takes precedence over checking filters. */
+    std::shared_ptr<Job> ClaimJob() EXCLUSIVE_LOCKS_REQUIRED(m_mutex)
+    {
+        for (size_t i = 0; i < std::min(m_jobs.size(), RESCAN_BLOCK_LOOKAHEAD); ++i) {
+            if (m_jobs[i]->state == Job::State::CHECKED) {
+                m_jobs[i]->state = Job::State::READING;
+                return m_jobs[i];
+            }
+        }
+        if (m_next_unchecked < m_jobs.size()) {
+            auto& job{m_jobs[m_next_unchecked++]};
+            job->state = Job::State::CHECKING;
+            return job;
+        }
+        return nullptr;
+    }
+
+    void ThreadWorker() EXCLUSIVE_LOCKS_REQUIRED(!m_mutex)
+    {
+        WAIT_LOCK(m_mutex, lock);
+        while (true) {
+            std::shared_ptr<Job> job;
+            m_work_cv.wait(lock, [&]() EXCLUSIVE_LOCKS_REQUIRED(m_mutex) { return m_stop || (job = ClaimJob()); });
+            if (m_stop) return;
+
+            const bool read_block{job->state == Job::State::READING};
+            const auto filter_set{m_filter_set};
+            {
+                REVERSE_LOCK(lock, m_mutex);
+                if (read_block) {
+                    m_chain.findBlock(job->hash, interfaces::FoundBlock().data(job->result.block));
+                } else {
+                    job->result.filter_match = m_chain.blockFilterMatchesAny(BlockFilterType::BASIC, job->hash, *filter_set);
+                }
+            }
+            // the block is skipped by the scan only if its filter is known not to match
+            if (read_block || job->result.filter_match == false) {
+                job->state = Job::State::DONE;
+                m_done_cv.notify_all();
+            } else {
+                job->state = Job::State::CHECKED;
+            }
         }
     }
 };
@@ -629,6 +818,17 @@ void CWallet::SetLastBlockProcessedInMem(int block_height, uint256 block_hash)
 {
     AssertLockHeld(cs_wallet);
 
+    if (block_height < m_last_block_processed_height) {
+        // Coinbases may have become immature again after a reorg.
+        m_balance_cache.m_valid = false;
+    } else if (block_height != m_last_block_processed_height) {
+        const std::set<Txid> height_dependent{m_balance_cache.m_height_dependent};
+        for (const Txid& txid : height_dependent) {
+            const auto it = mapWallet.find(txid);
+            if (it != mapWallet.end()) MarkBalanceDirty(it->second);
+        }
+    }
+
     m_last_block_processed = block_hash;
     m_last_block_processed_height = block_height;
 }
@@ -935,6 +1135,36 @@ void CWallet::MarkDirty()
         LOCK(cs_wallet);
         for (auto& [_, wtx] : mapWallet)
             wtx.MarkDirty();
+        m_balance_cache.m_valid = false;
+    }
+}
+
+void CWallet::MarkBalanceDirty(const CWalletTx& wtx) const
+{
+    AssertLockHeld(cs_wallet);
+    if (!m_balance_cache.m_valid) return;
+
+    std::vector<const CWalletTx*> todo{&wtx};
+    while (!todo.empty()) {
+        const CWalletTx& cur = *todo.back();
+        todo.pop_back();
+        // Already dirty transactions had their descendants taken out as well.
+        if (!m_balance_cache.m_dirty.insert(cur.GetHash()).second) continue;
+        if (cur.m_cached_balance) {
+            m_balance_cache.Add(*cur.m_cached_balance, -1);
+            cur.m_cached_balance.reset();
+        }
+        m_balance_cache.m_height_dependent.erase(cur.GetHash());
+
+        for (unsigned int i = 0; i < cur.tx->vout.size(); ++i) {
+            const auto range = mapTxSpends.equal_range(COutPoint(cur.GetHash(), i));
+            for (auto it = range.first; it != range.second; ++it) {
+                const auto child = mapWallet.find(it->second);
+                if (child != mapWallet.end() && !child->second.isConfirmed()) {
+                    todo.push_back(&child->second);
+                }
+            }
+        }
     }
 }
 
@@ -956,6 +1186,7 @@ bool CWallet::MarkReplaced(const Txid& originalHash, const Txid& newHash)
 
     // Refresh mempool status without waiting for transactionRemovedFromMempool or transactionAddedToMempool
     RefreshMempoolStatus(wtx, chain());
+    MarkBalanceDirty(wtx);
 
     WalletBatch batch(GetDatabase());
 
@@ -1070,6 +1301,7 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
             desc_tx->m_state = inactive_state;
             // Break caches since we have changed the state
             desc_tx->MarkDirty();
+            MarkBalanceDirty(*desc_tx);
             batch.WriteTx(*desc_tx);
             MarkInputsDirty(desc_tx->tx);
             for (unsigned int i = 0; i < desc_tx->tx->vout.size(); ++i) {
@@ -1095,6 +1327,7 @@ CWalletTx* CWallet::AddToWallet(CTransactionRef tx, const TxState& state, const
 
     // Break debit/credit balance caches:
     wtx.MarkDirty();
+    MarkBalanceDirty(wtx);
 
     // Notify UI of new or updated transaction
     NotifyTransactionChanged(hash, fInsertedNew ? CT_NEW : CT_UPDATED);
@@ -1158,6 +1391,7 @@ bool CWallet::LoadToWallet(const Txid& hash, const UpdateWalletTxFn& fill_wtx)
 
     // Update birth time when tx time is older than it.
     MaybeUpdateBirthTime(wtx.GetTxTime());
+    MarkBalanceDirty(wtx);
 
     return true;
 }
@@ -1242,6 +1476,7 @@ void CWallet::MarkInputsDirty(const CTransactionRef& tx)
         auto it = mapWallet.find(txin.prevout.hash);
         if (it != mapWallet.end()) {
             it->second.MarkDirty();
+            MarkBalanceDirty(it->second);
         }
     }
 }
@@ -1336,6 +1571,7 @@ void CWallet::RecursiveUpdateTxState(WalletBatch* batch, const Txid& tx_hash, co
         TxUpdate update_state = try_updating_state(wtx);
         if (update_state != TxUpdate::UNCHANGED) {
             wtx.MarkDirty();
+            MarkBalanceDirty(wtx);
             if (batch) batch->WriteTx(wtx);
             // Iterate over all its outputs, and update those tx states as well (if applicable)
             for (unsigned int i = 0; i < wtx.tx->vout.size(); ++i) {
@@ -1377,6 +1613,7 @@ void CWallet::transactionAddedToMempool(const CTransactionRef& tx) {
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        MarkBalanceDirty(it->second);
     }
 
     const Txid& txid = tx->GetHash();
@@ -1399,6 +1636,7 @@ void CWallet::transactionRemovedFromMempool(const CTransactionRef& tx, MemPoolRe
     auto it = mapWallet.find(tx->GetHash());
     if (it != mapWallet.end()) {
         RefreshMempoolStatus(it->second, chain());
+        MarkBalanceDirty(it->second);
     }
     // Handle transactions that were removed from the mempool because they
     // conflict with transactions in a newly connected block.
@@ -1599,10 +1837,42 @@ isminetype CWallet::IsMine(const CTxDestination& dest) const
     return IsMine(GetScriptForDestination(dest));
 }
 
+/**
+ * Returns the address part of a name script, or the whole script otherwise.
+ * This matches CNameScript(script).getAddress(), but does not copy the script.
+ */
+static std::span<const unsigned char> GetScriptAddressPart(const CScript& script)
+{
+    CScript::const_iterator pc = script.begin();
+    opcodetype name_op;
+    if (!script.GetOp(pc, name_op)) return script;
+    if (name_op != OP_NAME_REGISTER && name_op != OP_NAME_UPDATE) return script;
+
+    opcodetype opcode;
+    int num_args{0};
+    while (true) {
+        if (!script.GetOp(pc, opcode)) return script;
+        if (opcode == OP_DROP || opcode == OP_2DROP || opcode == OP_NOP) break;
+        if (!(opcode >= 0 && opcode <= OP_PUSHDATA4)) return script;
+        ++num_args;
+    }
+    if (num_args != 2) return script;
+
+    while (opcode == OP_DROP || opcode == OP_2DROP || opcode == OP_NOP) {
+        if (!script.GetOp(pc, opcode)) break;
+    }
+    --pc;
+    return {pc, script.end()};
+}
+
 isminetype CWallet::IsMine(const CScript& fullScript) const
 {
     AssertLockHeld(cs_wallet);
-    const CScript script = CNameScript(fullScript).getAddress();
+    const auto address{GetScriptAddressPart(fullScript)};
+
+    // Nearly all scripts the wallet is asked about are not its own, answer those without touching the script map
+    if (!m_cached_spk_set.MayContain(address)) return ISMINE_NO;
+    const CScript script(address.begin(), address.end());
 
     // Search the cache so that IsMine is called only on the relevant SPKMs instead of on everything in m_spk_managers
     const auto& it = m_cached_spks.find(script);
@@ -1703,6 +1973,7 @@ void CWallet::SetWalletFlagWithDB(WalletBatch& batch, uint64_t flags)
 {
     LOCK(cs_wallet);
     m_wallet_flags |= flags;
+    m_balance_cache.m_valid = false;
     if (!batch.WriteWalletFlags(m_wallet_flags))
         throw std::runtime_error(std::string(__func__) + ": writing wallet flags failed");
 }
@@ -1717,6 +1988,7 @@ void CWallet::UnsetWalletFlagWithDB(WalletBatch& batch, uint64_t flag)
 {
     LOCK(cs_wallet);
     m_wallet_flags &= ~flag;
+    m_balance_cache.m_valid = false;
     if (!batch.WriteWalletFlags(m_wallet_flags))
         throw std::runtime_error(std::string(__func__) + ": writing wallet flags failed");
 }
@@ -1850,6 +2122,13 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
     double progress_end = chain().guessVerificationProgress(end_hash);
     double progress_current = progress_begin;
     int block_height = start_height;
+    // Short rescans, e.g. of recent blocks after an import, are not worth
+    // starting the prefetch threads for.
+    const int end_height{max_height ? *max_height : WITH_LOCK(cs_wallet, return GetLastBlockHeight())};
+    std::optional<RescanPrefetcher> prefetcher;
+    if (end_height - start_height >= RESCAN_PREFETCH_MIN_BLOCKS) {
+        prefetcher.emplace(chain(), fast_rescan_filter ? fast_rescan_filter->GetFilterSet() : nullptr);
+    }
     while (!fAbortRescan && !chain().shutdownRequested()) {
         if (progress_end - progress_begin > 0.0) {
             m_scanning_progress = (progress_current - progress_begin) / (progress_end - progress_begin);
@@ -1866,10 +2145,15 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
             WalletLogPrintf("Still rescanning. At block %d. Progress=%f\n", block_height, progress_current);
         }
 
+        if (fast_rescan_filter && fast_rescan_filter->UpdateIfNeeded() && prefetcher) {
+            prefetcher->SetFilterSet(fast_rescan_filter->GetFilterSet());
+        }
+        RescanPrefetcher::Result prefetched{prefetcher ? prefetcher->Next(block_hash, block_height, max_height ? end_hash : tip_hash)
+                                                       : RescanPrefetcher::Fetch(chain(), block_hash, fast_rescan_filter ? fast_rescan_filter->GetFilterSet().get() : nullptr)};
+
         bool fetch_block{true};
         if (fast_rescan_filter) {
-            fast_rescan_filter->UpdateIfNeeded();
-            auto matches_block{fast_rescan_filter->MatchesBlock(block_hash)};
+            const auto& matches_block{prefetched.filter_match};
             if (matches_block.has_value()) {
                 if (*matches_block) {
                     LogDebug(BCLog::SCAN, "Fast rescan: inspect block %d [%s] (filter matched)\n", block_height, block_hash.ToString());
@@ -1891,9 +2175,8 @@ CWallet::ScanResult CWallet::ScanForWalletTransactions(const uint256& start_bloc
         chain().findBlock(block_hash, FoundBlock().inActiveChain(block_still_active).nextBlock(FoundBlock().inActiveChain(next_block).hash(next_block_hash)));
 
         if (fetch_block) {
-            // Read block data
-            CBlock block;
-            chain().findBlock(block_hash, FoundBlock().data(block));
+            // Block data was read by the prefetcher or Fetch()
+            const CBlock& block{prefetched.block};
 
             if (!block.IsNull()) {
                 LOCK(cs_wallet);
@@ -2001,7 +2284,10 @@ bool CWallet::SubmitTxMemoryPoolAndRelay(CWalletTx& wtx, std::string& err_string
     // If transaction was previously in the mempool, it should be updated when
     // TransactionRemovedFromMempool fires.
     bool ret = chain().broadcastTransaction(wtx.tx, m_default_max_tx_fee, relay, err_string);
-    if (ret) wtx.m_state = TxStateInMempool{};
+    if (ret) {
+        wtx.m_state = TxStateInMempool{};
+        MarkBalanceDirty(wtx);
+    }
     return ret;
 }
 
@@ -2291,6 +2577,7 @@ void CWallet::CommitTransaction(CTransactionRef tx, mapValue_t mapValue, std::ve
     for (const CTxIn& txin : tx->vin) {
         CWalletTx &coin = mapWallet.at(txin.prevout.hash);
         coin.MarkDirty();
+        MarkBalanceDirty(coin);
         NotifyTransactionChanged(coin.GetHash(), CT_UPDATED);
     }
 
@@ -2538,6 +2825,7 @@ void CWallet::MarkDestinationsDirty(const std::set<CTxDestination>& destinations
             CTxDestination dst;
             if (ExtractDestination(wtx.tx->vout[i].scriptPubKey, dst) && destinations.count(dst)) {
                 wtx.MarkDirty();
+                MarkBalanceDirty(wtx);
                 break;
             }
         }
@@ -4488,6 +4776,7 @@ void CWallet::CacheNewScriptPubKeys(const std::set<CScript>& spks, ScriptPubKeyM
 {
     for (const auto& script : spks) {
         m_cached_spks[script].push_back(spkm);
+        m_cached_spk_set.Insert(script);
     }
 }
 
@@ -33,6 +33,7 @@
 #include <wallet/crypter.h>
 #include <wallet/db.h>
 #include <wallet/scriptpubkeyman.h>
+#include <wallet/scriptset.h>
 #include <wallet/transaction.h>
 #include <wallet/types.h>
 #include <wallet/walletutil.h>
@@ -309,6 +310,34 @@ struct CRecipient
     CScript nameScript;
 };
 
+/**
+ * Running totals of the CachedTxBalance contributions of all wallet
+ * transactions, maintained incrementally for GetBalance().  Trusted credit is
+ * split by confirmation so that min_depth 0 and 1 can both be answered from
+ * the totals; credit arrays are indexed like CachedTxBalance's.
+ */
+struct WalletBalanceCache
+{
+    CAmount m_mine_trusted_confirmed[2]{0, 0};
+    CAmount m_mine_trusted_unconfirmed[2]{0, 0};
+    CAmount m_mine_untrusted_pending[2]{0, 0};
+    CAmount m_watchonly_trusted_confirmed[2]{0, 0};
+    CAmount m_watchonly_trusted_unconfirmed[2]{0, 0};
+    CAmount m_watchonly_untrusted_pending[2]{0, 0};
+    CAmount m_mine_immature{0};
+    CAmount m_watchonly_immature{0};
+    CAmount m_mine_names{0};
+
+    //! Transactions that are not part of the totals and need re-evaluation
+    std::set<Txid> m_dirty;
+    //! Accounted transactions whose contribution changes with the chain height
+    std::set<Txid> m_height_dependent;
+    //! False if the totals have to be rebuilt from all of mapWallet
+    bool m_valid{false};
+
+    void Add(const CachedTxBalance& bal, int sign);
+};
+
 class WalletRescanReserver; //forward declarations for ScanForWalletTransactions/RescanFromTime
 /**
  * A CWallet maintains a set of transactions and balances, and provides the ability to create new transactions.
@@ -443,6 +472,8 @@ private:
 
     //! Cache of descriptor ScriptPubKeys used for IsMine. Maps ScriptPubKey to set of spkms
     std::unordered_map<CScript, std::vector<ScriptPubKeyMan*>, SaltedSipHasher> m_cached_spks;
+    //! Hashes of all scripts in m_cached_spks, consulted first so IsMine can reject foreign scripts cheaply
+    ScriptPubKeySet m_cached_spk_set;
 
     /**
      * Catch wallet up to current chain, scanning new blocks, updating the best
@@ -612,6 +643,20 @@ public:
 
     void MarkDirty();
 
+    /**
+     * Running balance totals, see GetBalance().  Transactions whose state
+     * changes are taken out of the totals by MarkBalanceDirty and re-evaluated
+     * on the next GetBalance() call, instead of walking all of mapWallet.
+     */
+    mutable WalletBalanceCache m_balance_cache GUARDED_BY(cs_wallet);
+
+    /**
+     * Take a transaction out of the running balance totals until the next
+     * GetBalance() call.  Its unconfirmed in-wallet descendants are taken out
+     * as well, since their trust derives from it.
+     */
+    void MarkBalanceDirty(const CWalletTx& wtx) const EXCLUSIVE_LOCKS_REQUIRED(cs_wallet);
+
     //! Callback for updating transaction metadata in mapWallet.
     //!
     //! @param wtx - reference to mapWallet transaction to update
@@ -142,9 +142,12 @@ TransactionData::TransactionData (const CTransaction& tx)
   CNameScript nameOp;
   for (const auto& out : tx.vout)
     {
-      nameOp = CNameScript (out.scriptPubKey);
-      if (nameOp.isNameOp ())
-        break;
+      const NameScriptView view(out.scriptPubKey);
+      if (view.isNameOp ())
+        {
+          nameOp = CNameScript (view);
+          break;
+        }
     }
   if (!nameOp.isNameOp () || !nameOp.isAnyUpdate ())
     return;
@@ -209,8 +212,7 @@ TransactionData::TransactionData (const CTransaction& tx)
   std::map<valtype, CAmount> burns;
   for (const auto& out : tx.vout)
     {
-      const CNameScript nameOp(out.scriptPubKey);
-      if (nameOp.isNameOp ())
+      if (CNameScript::isNameScript (out.scriptPubKey))
         continue;
 
       CTxDestination dest;
@@ -273,6 +275,10 @@ ZMQGameBlocksNotifier::SendBlockNotifications (
     const std::set<std::string>& games, const std::string& commandPrefix,
     const std::string& reqtoken, const CBlock& block)
 {
+  /* All the JSON built here is only needed until the notifications
+     are sent.  */
+  UniValue::Arena arena;
+
   /* Start with an empty array of moves and commands for each game.  */
   std::map<std::string, UniValue> perGameMoves;
   std::map<std::string, UniValue> perGameAdminCmds;
@@ -6,8 +6,10 @@
 
 from test_framework.test_framework import BitcoinTestFramework
 from test_framework.util import assert_equal, str_to_b64str
+from test_framework.wallet import MiniWallet
 
 import http.client
+import socket
 import time
 import urllib.parse
 
@@ -179,6 +181,36 @@ class HTTPBasicsTest (BitcoinTestFramework):
         assert_equal(out1, b'{"result":"high-hash","error":null}\n')
 
 
+        self.log.info("Check that the server stops after a client drops a streamed reply")
+        node = self.nodes[1]
+        wallet = MiniWallet(node)
+        wallet.rescan_utxos()
+        # Transactions with many outputs make the getblock result much larger
+        # than the socket buffers and the queued part of the reply.
+        for num_txs in [1, 100]:
+            for _ in range(num_txs):
+                wallet.send_self_transfer_multi(from_node=node, utxos_to_spend=[wallet.get_utxo(confirmed_only=True)], num_outputs=200)
+            block_hash = self.generate(node, 1, sync_fun=self.no_op)[0]
+            wallet.rescan_utxos()
+
+        body = f'{{"method": "getblock", "params": ["{block_hash}", 2]}}'
+        http_request = "POST / HTTP/1.1\r\n"
+        http_request += f"Authorization: Basic {str_to_b64str(f'{urlNode1.username}:{urlNode1.password}')}\r\n"
+        http_request += f"Content-Length: {len(body)}\r\n\r\n"
+        http_request += body
+        sock = socket.socket(socket.AF_INET, socket.SOCK_STREAM)
+        sock.setsockopt(socket.SOL_SOCKET, socket.SO_RCVBUF, 4096)
+        sock.connect((urlNode1.hostname, urlNode1.port))
+        sock.sendall(http_request.encode("utf-8"))
+        res = sock.recv(1024)
+        assert res.startswith(b"HTTP/1.1 200 OK")
+        assert b"Transfer-Encoding: chunked" in res
+        with node.assert_debug_log(["RPC getblock failed after its result was partially sent"]):
+            sock.close()
+        # The dropped connection must not keep the server from shutting down
+        self.stop_node(1)
+
+
         self.log.info("Check -rpcservertimeout")
         # The test framework typically reuses a single persistent HTTP connection
         # for all RPCs to a TestNode. Because we are setting -rpcservertimeout
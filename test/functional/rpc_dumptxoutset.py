@@ -44,6 +44,7 @@ class DumptxoutsetTest(BitcoinTestFramework):
         assert expected_path.is_file()
 
         assert_equal(out['coins_written'], 101)
+        assert_equal(out['names_written'], 0)
         assert_equal(out['base_height'], 100)
         assert_equal(out['path'], str(expected_path))
         # Blockhash should be deterministic based on mocked time.